@@ -37,7 +37,7 @@ hardware::CpuState* Int80hDriver::on_interrupt(hardware::CpuState* cpu_state) {
 
     case Int80hSysCallNumbers::NANOSLEEP:
         cpu_state->rax = 0; // return value
-        return mngr.sleep_current_task(cpu_state, cpu_state->rbx / 1000 / 1000);
+        return mngr.sleep_current_task(cpu_state, (cpu_state->rbx + 999) / 1000);  // nanoseconds rounded up to microseconds
 
     default:
         return cpu_state;
@@ -11,6 +11,7 @@
 #include "CpuInfo.h"
 #include "StringUtils.h"
 #include "CpuSpeedEstimator.h"
+#include "PerCpu.h"
 
 using namespace cstd;
 
@@ -49,10 +50,11 @@ utils::SyscallResult<u64> VfsCpuInfoEntry::read(EntryState*, void* data, u32 cou
         return {0};
 
     hardware::CpuInfo cpu_info;
-    const string info = StringUtils::format("CPU: % @ %MHz, %\n",
+    const string info = StringUtils::format("CPU: % @ %MHz, %\nCPUs online: %\n",
             cpu_info.get_vendor(),
             cpu_speed_in_mhz_or("<unknown>"),
-            cpu_info.get_multimedia_extensions().to_string());
+            cpu_info.get_multimedia_extensions().to_string() + (cpu_info.has_erms() ? "ERMS" : ""),
+            hardware::PerCpu::count());
 
     u32 read_start = max((s64)info.length() - count, 0);
     u32 num_bytes_to_read = min(count, info.length());
@@ -39,20 +39,21 @@ utils::SyscallResult<u64> VfsDateEntry::read(EntryState*, void* data, u32 count)
     if (count == 0)
         return {0};
 
-    const string info = get_date_time();
-    if (info.empty())
+    char info[INFO_SIZE];
+    size_t info_length = get_date_time(info, sizeof(info));
+    if (info_length == 0)
         return {0};
 
-    u32 read_start = max((s64)info.length() - count, 0);
-    u32 num_bytes_to_read = min(count, info.length());
+    u32 read_start = max((s64)info_length - count, 0);
+    u32 num_bytes_to_read = min(count, info_length);
 
-    memcpy(data, info.c_str() + read_start, num_bytes_to_read);
+    memcpy(data, info + read_start, num_bytes_to_read);
 
     close(nullptr);
     return {num_bytes_to_read};
 }
 
-string VfsDateEntry::get_date_time() const {
+size_t VfsDateEntry::get_date_time(char* buff, size_t size) const {
     u16 year    = read_byte(0x9);
     u16 month   = read_byte(0x8);
     u16 day     = read_byte(0x7);
@@ -60,7 +61,7 @@ string VfsDateEntry::get_date_time() const {
     u16 minute  = read_byte(0x2);
     u16 second  = read_byte(0x0);
 
-    return StringUtils::format("%-%-% %:%:% UTC\n", to_bin(year) + 2000, to_bin(month), to_bin(day), to_bin(hour), to_bin(minute), to_bin(second));
+    return StringUtils::format_to(buff, size, "%-%-% %:%:% UTC\n", to_bin(year) + 2000, to_bin(month), to_bin(day), to_bin(hour), to_bin(minute), to_bin(second));
 }
 
 u8 VfsDateEntry::read_byte(u8 offset) const {
@@ -34,7 +34,9 @@ public:
 
 
 private:
-    cstd::string get_date_time() const;
+    static constexpr size_t INFO_SIZE {32};
+
+    size_t get_date_time(char* buff, size_t size) const;
     u8 read_byte(u8 offset) const;
     u8 to_bin(u8 bcd) const;
     const cstd::string      name            {"date"};
@@ -19,7 +19,7 @@ namespace filesystem {
  * @brief   Return length of kernel log
  */
 utils::SyscallResult<u64> VfsKmsgEntry::get_size() const {
-    return {KernelLog::instance().get_text().length()};
+    return {KernelLog::instance().get_length()};
 }
 
 /**
@@ -31,15 +31,7 @@ utils::SyscallResult<u64> VfsKmsgEntry::read(EntryState*, void* data, u32 count)
         return {0};
 
     KernelLog& klog = KernelLog::instance();
-    const cstd::string& log = klog.get_text();
-    if (log.empty())
-        return {0};
-
-    u32 read_start = max((s64)log.length() - count, 0);
-    u32 num_bytes_to_read = min(count, log.length());
-
-    memcpy(data, log.c_str() + read_start, num_bytes_to_read);
-
+    u32 num_bytes_to_read = klog.read_last((char*)data, count);
     klog.clear();
     return {num_bytes_to_read};
 }
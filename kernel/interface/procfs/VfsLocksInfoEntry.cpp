@@ -0,0 +1,69 @@
+/**
+ *   @file: VfsLocksInfoEntry.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "kstd.h"
+#include "StringUtils.h"
+#include "VfsLocksInfoEntry.h"
+#include "LockStats.h"
+
+using namespace cstd;
+using namespace multitasking;
+
+namespace filesystem {
+
+utils::SyscallResult<EntryState*> VfsLocksInfoEntry::open() {
+    if (is_open)
+        return {middlespace::ErrorCode::EC_AGAIN};
+
+    is_open = true;
+    return {nullptr};
+}
+
+utils::SyscallResult<void> VfsLocksInfoEntry::close(EntryState*) {
+    is_open = false;
+    return {middlespace::ErrorCode::EC_OK};
+}
+
+/**
+ * @brief   Read the last "count" bytes of locks info string
+ * @return  Num of read bytes
+ */
+utils::SyscallResult<u64> VfsLocksInfoEntry::read(EntryState*, void* data, u32 count) {
+    if (!is_open)
+        return {0};
+
+    if (count == 0)
+        return {0};
+
+    char info[INFO_SIZE];
+    size_t info_length = get_info(info, sizeof(info));
+    if (info_length == 0)
+        return {0};
+
+    u32 read_start = max((s64)info_length - count, 0);
+    u32 num_bytes_to_read = min(count, info_length);
+
+    memcpy(data, info + read_start, num_bytes_to_read);
+
+    close(nullptr);
+    return {num_bytes_to_read};
+}
+
+/**
+ * @brief   Render one line per named lock into "buff" of "size" chars; times are in cpu cycles
+ * @return  Info length
+ */
+size_t VfsLocksInfoEntry::get_info(char* buff, size_t size) const {
+    BufferSink info(buff, size);
+    StringUtils::format_into(info, "name acquired contended spin_cycles hold_cycles max_hold_cycles\n");
+    for (const LockStats* s = LockStats::get_first(); s; s = s->next)
+        StringUtils::format_into(info, "% % % % % %\n", s->name, s->acquisitions, s->contentions, s->spin_cycles, s->hold_cycles, s->max_hold_cycles);
+
+    return info.finish();
+}
+
+} /* namespace filesystem */
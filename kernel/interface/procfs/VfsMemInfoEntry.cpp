@@ -11,6 +11,8 @@
 #include "VfsMemInfoEntry.h"
 #include "MemoryManager.h"
 #include "FrameAllocator.h"
+#include "AddressSpaceManager.h"
+#include "Swap.h"
 
 using namespace cstd;
 using namespace memory;
@@ -41,28 +43,39 @@ utils::SyscallResult<u64> VfsMemInfoEntry::read(EntryState*, void* data, u32 cou
     if (count == 0)
         return {0};
 
-    const string info = get_info();
-    if (info.empty())
+    char info[INFO_SIZE];
+    size_t info_length = get_info(info, sizeof(info));
+    if (info_length == 0)
         return {0};
 
-    u32 read_start = max((s64)info.length() - count, 0);
-    u32 num_bytes_to_read = min(count, info.length());
+    u32 read_start = max((s64)info_length - count, 0);
+    u32 num_bytes_to_read = min(count, info_length);
 
-    memcpy(data, info.c_str() + read_start, num_bytes_to_read);
+    memcpy(data, info + read_start, num_bytes_to_read);
 
     close(nullptr);
     return {num_bytes_to_read};
 }
 
-string VfsMemInfoEntry::get_info() const {
-//    MemoryManager& mm = MemoryManager::instance();
-//    size_t free_memory = mm.get_total_memory_in_bytes() - mm.get_free_memory_in_bytes();
-//    size_t total_memory = mm.get_total_memory_in_bytes();
-//    env->printer->format("Used memory so far: % KB, total available: % MB\n", free_memory / 1024, total_memory / 1024 / 1024);
+/**
+ * @brief   Render memory info into "buff" of "size" chars
+ * @return  Info length
+ */
+size_t VfsMemInfoEntry::get_info(char* buff, size_t size) const {
+    MemoryManager& mm = MemoryManager::instance();
+    size_t used_memory = mm.get_total_memory_in_bytes() - mm.get_free_memory_in_bytes();
+    size_t total_memory = mm.get_total_memory_in_bytes();
 
     size_t used_frames = FrameAllocator::get_used_frames_count();
     size_t total_frames = FrameAllocator::get_total_frames_count();
-    return StringUtils::format("Used frames so far: %, total available: %\n", used_frames, total_frames);
+    BufferSink info(buff, size);
+    StringUtils::format_into(info, "Used frames so far: %, total available: % (% KB each)\n", used_frames, total_frames, FrameAllocator::get_frame_size() / 1024);
+    StringUtils::format_into(info, "Kernel heap used: % KB, total available: % MB\n", used_memory / 1024, total_memory / 1024 / 1024);
+    StringUtils::format_into(info, "Thread stacks released: %, recycled: %\n", get_released_stacks_count(), get_recycled_stacks_count());
+    StringUtils::format_into(info, "Swap used: % KB, total: % KB, pages swapped out: %, in: %\n",
+                             Swap::get_used_slots_count() * 4, Swap::get_total_slots_count() * 4,
+                             Swap::get_swapped_out_count(), Swap::get_swapped_in_count());
+    return info.finish();
 }
 
 
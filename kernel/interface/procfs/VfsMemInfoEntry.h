@@ -32,7 +32,9 @@ public:
     utils::SyscallResult<u64> get_position(EntryState* state) const override                    { return {0}; }
 
 private:
-    cstd::string get_info() const;
+    static constexpr size_t INFO_SIZE {512};
+
+    size_t get_info(char* buff, size_t size) const;
     bool is_open                {false};
     const cstd::string  name    {"meminfo"};
 };
@@ -10,8 +10,10 @@
 #include "VfsPsInfoEntry.h"
 #include "TaskManager.h"
 #include "StringUtils.h"
+#include "AddressSpaceManager.h"
 
 using namespace cstd;
+using namespace memory;
 using namespace multitasking;
 
 namespace filesystem {
@@ -41,26 +43,39 @@ utils::SyscallResult<u64> VfsPsInfoEntry::read(EntryState*, void* data, u32 coun
         return 0;
 
     TaskManager& task_manager = TaskManager::instance();
-    string info;
+    BufferSink info_sink(info, sizeof(info));
     u32 i = 0;
     const TaskList& tasks = task_manager.get_tasks();
     for (const Task* task : tasks) {
-        info += StringUtils::format("%. [%] [%] %, tid %\n",
+        StringUtils::format_into(info_sink, "%. [%] [%] %, tid %, prio %, nice %",
                                         i,
                                         task->is_user_space ? "USER" : "KERN",
-                                        task->state == TaskState::RUNNING ? "RUNNING" : "BLOCKED",
+                                        task->state == TaskState::RUNNING ? "RUNNING" : task->state == TaskState::BLOCKED ? "BLOCKED" : "KILLED",
                                         task->name,
-                                        task->task_id);
+                                        task->task_id,
+                                        task->priority,
+                                        task->nice);
+
+        // all kernel tasks share one address space, so memory usage is only given for user tasks; see /proc/task/<tid>
+        if (task->is_user_space && task->task_group_data) {
+            const AddressSpace& as = task->task_group_data->address_space;
+            StringUtils::format_into(info_sink, ", rss % KB, heap % KB, faults %",
+                                        get_memory_usage(as).resident_pages * 4,
+                                        (as.heap_low_limit - as.heap_start) / 1024,
+                                        as.stats.page_faults);
+        }
+        info_sink.put('\n');
         i++;
     }
 
-    if (info.empty())
+    size_t info_length = info_sink.finish();
+    if (info_length == 0)
         return 0;
 
-    u32 read_start = max((s64)info.length() - count, 0);
-    u32 num_bytes_to_read = min(count, info.length());
+    u32 read_start = max((s64)info_length - count, 0);
+    u32 num_bytes_to_read = min(count, info_length);
 
-    memcpy(data, info.c_str() + read_start, num_bytes_to_read);
+    memcpy(data, info + read_start, num_bytes_to_read);
 
     close(nullptr);
     return num_bytes_to_read;
@@ -32,8 +32,11 @@ public:
     utils::SyscallResult<u64> get_position(EntryState* state) const override                    { return {0}; }
 
 private:
+    static constexpr size_t INFO_SIZE       {8 * 1024};    // rendered here rather than on the stack or the heap
+
     const cstd::string  name                {"psinfo"};
     bool                is_open             {false};
+    char                info[INFO_SIZE];
 
 };
 
@@ -0,0 +1,42 @@
+/**
+ *   @file: VfsTaskDirEntry.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "VfsTaskDirEntry.h"
+#include "VfsTaskStatusEntry.h"
+#include "TaskManager.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+using namespace multitasking;
+
+namespace filesystem {
+
+/**
+ * @brief   Get status entry of the task named "name", or error code if there is no such task
+ */
+utils::SyscallResult<VfsEntryPtr> VfsTaskDirEntry::get_entry(const UnixPath& name) {
+    for (const Task* task : TaskManager::instance().get_tasks())
+        if (StringUtils::from_int(task->task_id) == (string)name)
+            return {cstd::make_shared<VfsTaskStatusEntry>(task->task_id)};
+
+    // no such task
+    return {middlespace::ErrorCode::EC_NOENT};
+}
+
+/**
+ * @brief   Enumerate status entries of the running tasks
+ * @param   on_entry Callback called for every task
+ */
+utils::SyscallResult<void> VfsTaskDirEntry::enumerate_entries(const OnVfsEntryFound& on_entry) {
+    for (const Task* task : TaskManager::instance().get_tasks())
+        if (!on_entry(cstd::make_shared<VfsTaskStatusEntry>(task->task_id)))
+            break;
+
+    return {middlespace::ErrorCode::EC_OK};
+}
+
+} /* namespace filesystem */
@@ -0,0 +1,35 @@
+/**
+ *   @file: VfsTaskDirEntry.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_INTERFACE_PROCFS_VFSTASKDIRENTRY_H_
+#define KERNEL_INTERFACE_PROCFS_VFSTASKDIRENTRY_H_
+
+#include "VfsEntry.h"
+
+namespace filesystem {
+
+/**
+ * @brief   This class exposes a directory with a status file for every running task, eg. /proc/task/5
+ * @note    The status files are made on the fly, so the directory contents follow the task list
+ */
+class VfsTaskDirEntry: public VfsEntry {
+public:
+    // [common interface]
+    const cstd::string& get_name() const override                                   { return name; }
+    VfsEntryType get_type() const override                                          { return VfsEntryType::DIRECTORY; }
+
+    // [directory interface]
+    utils::SyscallResult<VfsEntryPtr> get_entry(const UnixPath& name) override;
+    utils::SyscallResult<void> enumerate_entries(const OnVfsEntryFound& on_entry) override;
+
+private:
+    const cstd::string  name    {"task"};
+};
+
+} /* namespace filesystem */
+
+#endif /* KERNEL_INTERFACE_PROCFS_VFSTASKDIRENTRY_H_ */
@@ -0,0 +1,95 @@
+/**
+ *   @file: VfsTaskStatusEntry.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "kstd.h"
+#include "VfsTaskStatusEntry.h"
+#include "TaskManager.h"
+#include "AddressSpaceManager.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+using namespace memory;
+using namespace multitasking;
+
+namespace filesystem {
+
+VfsTaskStatusEntry::VfsTaskStatusEntry(u32 task_id) : task_id(task_id), name(StringUtils::from_int(task_id)) {
+}
+
+utils::SyscallResult<EntryState*> VfsTaskStatusEntry::open() {
+    if (is_open)
+        return {middlespace::ErrorCode::EC_AGAIN};
+
+    is_open = true;
+    return {nullptr};
+}
+
+utils::SyscallResult<void> VfsTaskStatusEntry::close(EntryState*) {
+    is_open = false;
+    return {middlespace::ErrorCode::EC_OK};
+}
+
+/**
+ * @brief   Read the last "count" bytes of task status string
+ * @return  Num of read bytes, EC_NOENT if the task is gone
+ */
+utils::SyscallResult<u64> VfsTaskStatusEntry::read(EntryState*, void* data, u32 count) {
+    if (!is_open)
+        return {0};
+
+    if (count == 0)
+        return {0};
+
+    char info[INFO_SIZE];
+    size_t info_length = get_info(info, sizeof(info));
+    if (info_length == 0)
+        return {middlespace::ErrorCode::EC_NOENT};
+
+    u32 read_start = max((s64)info_length - count, 0);
+    u32 num_bytes_to_read = min(count, info_length);
+
+    memcpy(data, info + read_start, num_bytes_to_read);
+
+    close(nullptr);
+    return {num_bytes_to_read};
+}
+
+/**
+ * @brief   Render the task status into "buff" of "size" chars;
+ *          memory usage is given for user space tasks only, as all kernel tasks share one address space
+ * @return  Status length, 0 if there is no such task
+ */
+size_t VfsTaskStatusEntry::get_info(char* buff, size_t size) const {
+    for (const Task* task : TaskManager::instance().get_tasks()) {
+        if (task->task_id != task_id)
+            continue;
+
+        BufferSink info(buff, size);
+        StringUtils::format_into(info, "Name: %\n", task->name);
+        StringUtils::format_into(info, "Tid: %\n", task->task_id);
+        StringUtils::format_into(info, "State: %\n", task->state == TaskState::RUNNING ? "RUNNING" : task->state == TaskState::BLOCKED ? "BLOCKED" : "KILLED");
+        StringUtils::format_into(info, "Cpu: %\n", task->cpu);
+        StringUtils::format_into(info, "Priority: %, nice: %\n", task->priority, task->nice);
+        if (!task->is_user_space || !task->task_group_data)
+            return info.finish();
+
+        const AddressSpace& as = task->task_group_data->address_space;
+        const AddressSpaceUsage usage = get_memory_usage(as);
+        StringUtils::format_into(info, "Parent: %\n", task->task_group_data->parent_task_id);
+        StringUtils::format_into(info, "Resident: % KB\n", usage.resident_pages * 4);
+        StringUtils::format_into(info, "Swapped out: % KB\n", usage.swapped_out_pages * 4);
+        StringUtils::format_into(info, "Page tables: % KB\n", usage.page_table_pages * 4);
+        StringUtils::format_into(info, "Heap: % KB\n", (as.heap_low_limit - as.heap_start) / 1024);
+        StringUtils::format_into(info, "Stacks: %\n", as.stats.stacks_count);
+        StringUtils::format_into(info, "Page faults: %, swapped in: %\n", as.stats.page_faults, as.stats.swap_in_faults);
+        return info.finish();
+    }
+
+    return 0;
+}
+
+} /* namespace filesystem */
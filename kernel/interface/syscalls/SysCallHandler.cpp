@@ -23,6 +23,11 @@
 #include "ElfRunner.h"
 #include "SyscallResult.h"
 #include "VfsRamFifoEntry.h"
+#include "AddressSpaceManager.h"
+#include "PageTables.h"
+#include "SharedMemory.h"
+#include "HigherHalf.h"
+#include "PerCpu.h"
 
 using namespace cstd;
 using namespace drivers;
@@ -82,10 +87,85 @@ s32 SysCallHandler::sys_close(u32 fd) {
     return 0;
 }
 
+/**
+ * @brief   Kernel buffer that user buffers with file pages not read yet are read and written through.
+ *          Syscalls run one at a time under the kernel lock and the filesystem never blocks, so one buffer serves all tasks
+ */
+static u8 bounce_buffer[4096];
+
+/**
+ * @brief   Check if any page of "buf".."buf"+"count"-1 lies in a file-backed memory area of "as" and was not read
+ *          from the file yet. Touching such page from inside the filesystem would re-enter the filesystem to read it
+ */
+static bool has_unread_file_page(const memory::AddressSpace& as, const void* buf, u64 count) {
+    constexpr u64 PAGE_SIZE = memory::PageTables::get_page_size();
+    const u64 first_byte = (u64)buf;
+    const u64 last_byte = first_byte + count - 1;
+    for (const memory::MemoryArea& m : as.memory_areas) {
+        if (!m.file || m.first_byte > last_byte || m.last_byte < first_byte)
+            continue;
+
+        const u64 first_page = max(m.first_byte, first_byte) & ~(PAGE_SIZE - 1);
+        const u64 last_page = min(m.last_byte, last_byte) & ~(PAGE_SIZE - 1);
+        for (u64 page = first_page; page <= last_page; page += PAGE_SIZE) {
+            const u64* pte = memory::PageTables::get_page_for_virt_address(page, as.pml4_phys_addr);
+            if (!pte || !(*pte & memory::PageAttr::PRESENT))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief   Read up to "count" bytes of "file" into "buf" through the bounce buffer, chunk by chunk.
+ *          Page faults that read file-backed "buf" pages happen on copying, and not while the filesystem is busy reading
+ * @return  Number of actually read bytes on success
+ */
+static s64 read_bounced(OpenEntry& file, void* buf, u64 count) {
+    u64 total = 0;
+    while (total < count) {
+        const u32 chunk = min(count - total, sizeof(bounce_buffer));
+        auto read_result = file.read(bounce_buffer, chunk);
+        if (!read_result)
+            return total > 0 ? (s64)total : -(s64)read_result.ec;
+
+        memcpy((u8*)buf + total, bounce_buffer, read_result.value);
+        total += read_result.value;
+        if (read_result.value < chunk)
+            break;
+    }
+
+    return total;
+}
+
+/**
+ * @brief   Write "count" bytes of "buf" to "file" through the bounce buffer, chunk by chunk.
+ *          Page faults that read file-backed "buf" pages happen on copying, and not while the filesystem is busy writing
+ * @return  Number of actually written bytes on success
+ */
+static s64 write_bounced(OpenEntry& file, const void* buf, u64 count) {
+    u64 total = 0;
+    while (total < count) {
+        const u32 chunk = min(count - total, sizeof(bounce_buffer));
+        memcpy(bounce_buffer, (const u8*)buf + total, chunk);
+        auto write_result = file.write(bounce_buffer, chunk);
+        if (!write_result)
+            return total > 0 ? (s64)total : -(s64)write_result.ec;
+
+        total += write_result.value;
+        if (write_result.value < chunk)
+            break;
+    }
+
+    return total;
+}
+
 /**
  * @brief   Read up to "count" bytes
  * @return  Number of actually read bytes on success
  *          -EBADF if "fd" is not valid descriptor
+ * @note    Buffer with file pages not read yet (eg. ELF .data) is read into through kernel buffer, see read_bounced
  * @see     http://man7.org/linux/man-pages/man2/read.2.html
  */
 s64 SysCallHandler::sys_read(u32 fd, void *buf, u64 count) {
@@ -97,6 +177,9 @@ s64 SysCallHandler::sys_read(u32 fd, void *buf, u64 count) {
     if (!files[fd])
         return -EBADF;
 
+    if (count > 0 && has_unread_file_page(current().task_group_data->address_space, buf, count))
+        return read_bounced(*files[fd], buf, count);
+
     if (auto read_result = files[fd]->read(buf, count))
         return read_result.value;
     else
@@ -107,6 +190,7 @@ s64 SysCallHandler::sys_read(u32 fd, void *buf, u64 count) {
  * @brief   Write up to "count" bytes
  * @return  Number of actually written bytes on success
  *          -EBADF if "fd" is not valid descriptor
+ * @note    Buffer with file pages not read yet (eg. mmaped file) is written through kernel buffer, see write_bounced
  * @see     http://man7.org/linux/man-pages/man2/write.2.html
  */
 s64 SysCallHandler::sys_write(u32 fd, const void *buf, u64 count) {
@@ -118,6 +202,9 @@ s64 SysCallHandler::sys_write(u32 fd, const void *buf, u64 count) {
     if (!files[fd])
         return -EBADF;
 
+    if (count > 0 && has_unread_file_page(current().task_group_data->address_space, buf, count))
+        return write_bounced(*files[fd], buf, count);
+
     if (auto write_result = files[fd]->write(buf, count))
         return write_result.value;
     else
@@ -384,6 +471,7 @@ s32 SysCallHandler::sys_mknod(const char path[], int mode, int dev) {
  * @brief   Set new program break effectively changing the amount of dynamic memory available to a task
  * @return  New program break on success
  *          Current program break on failure (invalid argument or out of memory)
+ * @note    Lowering the program break releases the frames of the whole pages above it
  * @see     http://man7.org/linux/man-pages/man2/brk.2.html
  */
 u64 SysCallHandler::sys_brk(u64 new_brk) {
@@ -392,19 +480,76 @@ u64 SysCallHandler::sys_brk(u64 new_brk) {
 
     memory::AddressSpace& as = tgd->address_space;
 
-    // invalid argument
-    if (new_brk == 0)
+    // invalid argument; the break never goes below the heap start, as the memory there holds the program itself
+    if (new_brk == 0 || new_brk < as.heap_start)
         return as.heap_low_limit;
 
     // out of memory
     if (new_brk >= as.heap_high_limit)
         return as.heap_low_limit;
 
+    // give back the frames if the heap shrinks
+    if (new_brk < as.heap_low_limit)
+        memory::release_heap_pages(as, new_brk, as.heap_low_limit - 1);
+
     // move program break
     as.heap_low_limit = new_brk;
     return new_brk;
 }
 
+/**
+ * @brief   Map a new memory area into the task group address space.
+ *          Area pages are populated on first access: zeroed for MAP_ANONYMOUS, read from file "fd" at "offset" otherwise
+ * @return  Area address on success
+ *          -EINVAL on zero "length", unaligned "offset", MAP_FIXED or writable MAP_SHARED file mapping (not supported)
+ *          -EBADF if "fd" is not valid descriptor
+ *          -EACCES if "fd" is not a file
+ *          -ENOMEM if no virtual memory left
+ * @note    "addr" hint is ignored. File pages are private copies, writes never go back to the file
+ * @see     http://man7.org/linux/man-pages/man2/mmap.2.html
+ */
+s64 SysCallHandler::sys_mmap(void* /* addr */, size_t length, int prot, int flags, int fd, off_t offset) {
+    constexpr u64 PAGE_SIZE = memory::PageTables::get_page_size();
+    const bool writable = prot & PROT_WRITE;
+    const bool anonymous = flags & MAP_ANONYMOUS;
+    if (length == 0 || offset < 0 || (offset & (PAGE_SIZE - 1)) || (flags & MAP_FIXED))
+        return -EINVAL;
+
+    if ((flags & MAP_SHARED) && !anonymous && writable)
+        return -EINVAL;
+
+    filesystem::OpenEntryPtr file;
+    if (!anonymous) {
+        auto& files = current().task_group_data->files;
+        if ((u32)fd >= files.size() || !files[fd])
+            return -EBADF;
+
+        file = files[fd];
+        if (file->get_type() != VfsEntryType::FILE)
+            return -EACCES;
+    }
+
+    memory::AddressSpace& as = current().task_group_data->address_space;
+    if (auto result = memory::map_area(as, length, writable, file, offset))
+        return result.value;
+    else
+        return -(s64)result.ec;
+}
+
+/**
+ * @brief   Unmap memory areas in "addr".."addr + length - 1" and release their memory
+ * @return  0 on success
+ *          -EINVAL if "addr" is not page aligned or "length" is zero
+ * @see     http://man7.org/linux/man-pages/man2/munmap.2.html
+ */
+s32 SysCallHandler::sys_munmap(void* addr, size_t length) {
+    memory::AddressSpace& as = current().task_group_data->address_space;
+    if (auto result = memory::unmap_area(as, (u64)addr, length))
+        return 0;
+    else
+        return -(s32)result.ec;
+}
+
 /**
  * @brief   Get current working directory and store into "buff"
  * @param   size Size of the "buff"
@@ -452,6 +597,7 @@ s32 SysCallHandler::sys_chdir(const char path[]) {
  * @return  0 on success
  *          -EINVAL if invalid/unsupported "clk_id" specified
  *          -EFAULT if invalid "tp" specified
+ * @note    Run without the kernel lock; the uptime is read lock-free
  * @see     http://man7.org/linux/man-pages/man2/clock_gettime.2.html
  */
 s32 SysCallHandler::sys_clock_gettime(clockid_t clk_id, struct timespec *tp) {
@@ -461,14 +607,11 @@ s32 SysCallHandler::sys_clock_gettime(clockid_t clk_id, struct timespec *tp) {
     if (clk_id != CLOCK_MONOTONIC)
         return -EINVAL;
 
-    constexpr u64 NSEC = 1000*1000*1000;
-    ktime::TimeManager& time_manager = ktime::TimeManager::instance();
-    u64 ticks = time_manager.get_ticks();
-    u64 freq = time_manager.get_hz();
+    constexpr u64 USEC = 1000*1000;
+    u64 uptime_us = ktime::TimeManager::instance().get_uptime_us();
 
-    u64 sec = ticks / freq;
-    tp->tv_sec = sec;
-    tp->tv_nsec = ((ticks * NSEC) / freq) - (sec * NSEC);
+    tp->tv_sec = uptime_us / USEC;
+    tp->tv_nsec = (uptime_us % USEC) * 1000;
     return 0;
 }
 
@@ -481,6 +624,78 @@ void SysCallHandler::sys_exit(s32 status) {
     multitasking::Task::exit(status);
 }
 
+/**
+ * @brief   User task context as saved at the top of kernel stack by "handle_syscall", see syscalls.S
+ */
+struct SysCallUserContext {
+    u8 xmm[16 * 16];    // xmm0..xmm15, same layout as in CpuState
+    u64 rbx;
+    u64 rcx;    // user RIP
+    u64 rdx;
+    u64 rsi;
+    u64 rdi;
+    u64 rbp;
+    u64 r8;
+    u64 r9;
+    u64 r10;
+    u64 r11;    // user RFLAGS
+    u64 r12;
+    u64 r13;
+    u64 r14;
+    u64 r15;
+} __attribute__((packed));
+
+/**
+ * @brief   Create a new process that is a copy of the calling one. Memory is not copied but shared copy-on-write,
+ *          so forking costs only the page tables copy; the frames get copied one by one as either process writes to them.
+ *          Only the calling thread is cloned; the child inherits working directory and open files
+ * @return  Child task id in the calling process, 0 in the child process
+ *          -EPERM if the child could not be run
+ *          -ENOMEM if out of memory
+ * @see     http://man7.org/linux/man-pages/man2/fork.2.html
+ */
+s64 SysCallHandler::sys_fork() {
+    multitasking::TaskManager& mngr = multitasking::TaskManager::instance();
+    multitasking::Task& parent = mngr.get_current_task();
+    if (!parent.is_user_space)
+        return -EPERM;
+
+    // user stack pointer at "syscall" instruction and the user context "handle_syscall" saved on the kernel stack, see syscalls.S
+    const hardware::PerCpu& cpu = hardware::PerCpu::current();
+    const u64 user_rsp = cpu.user_rsp;
+    const SysCallUserContext* ctx = (const SysCallUserContext*)(cpu.kernel_stack_top - sizeof(SysCallUserContext));
+
+    // child resumes right after "syscall" instruction, with same registers as the parent except rax that holds the result 0.
+    // Child cpu state is kept in the child task, not on its copy-on-write stack; cr3 is loaded by TaskManager, so it is left 0
+    hardware::CpuState child_state(ctx->rcx, user_rsp, ctx->rdi, ctx->rsi, true, 0);
+    memcpy(child_state.xmm, ctx->xmm, sizeof(child_state.xmm));
+    child_state.rbx = ctx->rbx;
+    child_state.rcx = ctx->rcx;
+    child_state.rdx = ctx->rdx;
+    child_state.rbp = ctx->rbp;
+    child_state.r8 = ctx->r8;
+    child_state.r9 = ctx->r9;
+    child_state.r10 = ctx->r10;
+    child_state.r11 = ctx->r11;
+    child_state.r12 = ctx->r12;
+    child_state.r13 = ctx->r13;
+    child_state.r14 = ctx->r14;
+    child_state.r15 = ctx->r15;
+    child_state.rflags = ctx->r11;
+
+    auto clone_result = memory::clone_address_space(parent.task_group_data->address_space);
+    if (!clone_result)
+        return -(s64)clone_result.ec;
+
+    multitasking::Task* child = multitasking::TaskFactory::make_forked_task(parent, clone_result.value, child_state);
+
+    u32 task_id = mngr.add_task(child);
+    if (task_id == 0)
+        return -EPERM;
+
+    return task_id;
+}
+
 /**
  * @brief	Send signal to given task
  * @note	Only SIGKILL is supported for now
@@ -492,6 +707,21 @@ void SysCallHandler::sys_exit(s32 status) {
 //	return -EPERM;//multitasking::Task::kill(task_id, signal);
 //}
 
+/**
+ * @brief   Set nice value of task "task_id", or of the calling task if "task_id" is 0.
+ *          Nice value ranges from -20 to 19; the lower the value, the higher the task priority
+ * @return  0 on success
+ *          -ESRCH if no such task
+ *          -EINVAL if "nice" is out of range
+ * @note    Unlike Linux, there is no "which" argument; "task_id" always names a single task
+ * @note    Run without the kernel lock; TaskManager takes its own
+ * @see     http://man7.org/linux/man-pages/man2/setpriority.2.html
+ */
+s32 SysCallHandler::sys_setpriority(u32 task_id, s32 nice) {
+    multitasking::TaskManager& mngr = multitasking::TaskManager::instance();
+    return -(s32)mngr.set_nice(task_id, nice);
+}
+
 /**
  * @brief   Exit all threads in current process. Right now there is no multiple threads per process, so exit current task
  * @return  This function does not return; TaskManager schedules another task instead
@@ -591,6 +821,33 @@ void SysCallHandler::vga_flush_video_buffer(const u8* buff) {
     }
 }
 
+/**
+ * @brief   Map the graphics mode video memory into current address space, so the pixels can be drawn without a copy
+ * @return  Address of the mapped video memory on success
+ *          -ENODEV if there is no vga driver
+ *          -EINVAL if not in graphics mode
+ *          -ENOMEM if no memory left
+ * @note    The mapping is write-combining. Leaving graphics mode unmaps it from every address space, see vga_exit_graphics_mode
+ */
+s64 SysCallHandler::vga_map_video_buffer() {
+    DriverManager& mngr = DriverManager::instance();
+    VgaDriver* drv = mngr.get_driver<VgaDriver>();
+    if (!drv)
+        return -ENODEV;
+
+    u8* video_buffer = drv->get_video_buffer();
+    if (!video_buffer)
+        return -EINVAL;
+
+    const u64 phys_addr = memory::HigherHalf::virt_to_phys(video_buffer);
+    const u64 num_bytes = drv->screen_width() * drv->screen_height() * sizeof(middlespace::EgaColor64);
+    memory::AddressSpace& as = current().task_group_data->address_space;
+    if (auto result = memory::map_device_memory(as, phys_addr, num_bytes, true))
+        return result.value;
+    else
+        return -(s64)result.ec;
+}
+
 void SysCallHandler::vga_get_width_height(u16* width, u16* height) {
     DriverManager& mngr = DriverManager::instance();
     if (VgaDriver* drv = mngr.get_driver<VgaDriver>()) {
@@ -610,9 +867,21 @@ void SysCallHandler::vga_enter_graphics_mode() {
     }
 }
 
+/**
+ * @brief   Switch back to text mode. Video memory mapped with vga_map_video_buffer gets unmapped from every task first,
+ *          as in text mode that memory holds the fonts
+ */
 void SysCallHandler::vga_exit_graphics_mode() {
     DriverManager& mngr = DriverManager::instance();
     if (VgaDriver* drv = mngr.get_driver<VgaDriver>()) {
+        if (u8* video_buffer = drv->get_video_buffer()) {
+            const u64 phys_addr = memory::HigherHalf::virt_to_phys(video_buffer);
+            const u64 num_bytes = drv->screen_width() * drv->screen_height() * sizeof(middlespace::EgaColor64);
+            for (multitasking::Task* task : multitasking::TaskManager::instance().get_tasks())
+                if (task->is_user_space && task->task_group_data)
+                    memory::unmap_device_memory(task->task_group_data->address_space, phys_addr, num_bytes);
+        }
+
         drv->set_text_mode_90_30();
         drv->clear_screen(middlespace::EgaColor::Black);
     }
@@ -640,16 +909,6 @@ s64 SysCallHandler::elf_run(const char path[], const char* nullterm_argv[]) {
     if (entry->get_type() != VfsEntryType::FILE)
         return -EISDIR;
 
-    // TODO: reading elf file should be done from kernel task not from syscall, this is experimental version
-    u32 size = entry->get_size().value;
-    u8* elf_data = new u8[size];
-    if (!elf_data)
-        return -ENOMEM;
-
-    auto read_result = entry->read(elf_data, size);
-    if (!read_result)
-        return -(s64)read_result.ec;
-
     vector<string> args;
     while (*nullterm_argv) {
         args.push_back(*nullterm_argv);
@@ -657,7 +916,7 @@ s64 SysCallHandler::elf_run(const char path[], const char* nullterm_argv[]) {
     }
 
     elf64::ElfRunner runner;
-    if (auto run_result = runner.run(elf_data, args))
+    if (auto run_result = runner.run(entry, args))
         return run_result.value;
     else
         return -(s64)run_result.ec;
@@ -702,6 +961,41 @@ s64 SysCallHandler::task_lightweight_run(u64 entry_point, u64 arg, const char na
     return task_id;
 }
 
+/**
+ * @brief   Map shared memory segment "name" into current task group address space, creating the segment if needed
+ * @param   size Size of the segment to create, 0 means entire segment when mapping existing one
+ * @return  Mapping address on success
+ *          -EINVAL if "name" is null or empty, or "size" is 0 for new segment or exceeds existing segment size
+ *          -ENOMEM if out of memory
+ * @note    Mapping is released with "munmap"
+ */
+s64 SysCallHandler::shm_map(const char name[], size_t size) {
+    if (!name)
+        return -EINVAL;
+
+    memory::AddressSpace& as = current().task_group_data->address_space;
+    if (auto result = memory::SharedMemory::map(as, name, size))
+        return result.value;
+    else
+        return -(s64)result.ec;
+}
+
+/**
+ * @brief   Remove shared memory segment "name"; its memory is released when no task group has it mapped anymore
+ * @return  0 on success
+ *          -EINVAL if "name" is null
+ *          -ENOENT if no such segment
+ */
+s32 SysCallHandler::shm_unlink(const char name[]) {
+    if (!name)
+        return -EINVAL;
+
+    if (auto result = memory::SharedMemory::unlink(name))
+        return 0;
+    else
+        return -(s32)result.ec;
+}
+
 /**
  * @brief   Return current task, that called the syscall
  */
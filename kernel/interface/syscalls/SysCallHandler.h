@@ -34,11 +34,15 @@ public:
     s32 sys_unlink(const char path[]);
     s32 sys_mknod(const char path[], int mode, int dev);
     u64 sys_brk(u64 new_brk);
+    s64 sys_mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset);
+    s32 sys_munmap(void* addr, size_t length);
     s32 sys_get_cwd(char* buff, size_t size);
     s32 sys_chdir(const char path[]);
     s32 sys_clock_gettime(clockid_t clk_id, struct timespec* tp);
     void sys_exit(s32 status);
+    s64 sys_fork();
 //    s32 sys_kill(u32 task_id, s32 signal); // done by int80h
+    s32 sys_setpriority(u32 task_id, s32 nice);
     void sys_exit_group(s32 status);
 
     s32 enumerate(u32 fd, middlespace::VfsEntry* entries, u32 max_entries);
@@ -48,6 +52,7 @@ public:
     void vga_set_char_at(u8 x, u8 y, u16 c);
     void vga_flush_char_buffer(const u16* buff);
     void vga_flush_video_buffer(const u8* buff);
+    s64 vga_map_video_buffer();
     void vga_get_width_height(u16* width, u16* height);
     void vga_enter_graphics_mode();
     void vga_exit_graphics_mode();
@@ -55,6 +60,8 @@ public:
     s64 elf_run(const char path[], const char* nullterm_argv[]);
     s64 task_wait(u32 task_id);
     s64 task_lightweight_run(u64 entry_point, u64 arg, const char name[]);
+    s64 shm_map(const char name[], size_t size);
+    s32 shm_unlink(const char name[]);
 
 private:
     multitasking::Task& current() const;
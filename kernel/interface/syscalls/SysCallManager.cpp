@@ -10,17 +10,18 @@
 #include "SysCallManager.h"
 #include "SysCallHandler.h"
 #include "SysCallNumbers.h"
+#include "KLockGuard.h"
 
 using namespace middlespace;
 namespace syscalls {
 
 /**
  * @brief   Raw syscall handler that:
- *          1. saves user task context
- *          2. switches to kernel stack
+ *          1. switches to kernel stack
+ *          2. saves user task context on the kernel stack
  *          3. calls on_syscall
- *          4. switches back to user stack
- *          5. restores user task context
+ *          4. restores user task context
+ *          5. switches back to user stack
  *          implemented in syscalls.S
  */
 extern "C" void handle_syscall();
@@ -33,9 +34,25 @@ extern "C" void handle_syscall();
  * @see     http://blog.rchapman.org/posts/Linux_System_Call_Table_for_x86_64/
  */
 SysCallHandler syscall_handler;
-extern "C" s64 on_syscall(u64 sys_call_num, u64 arg1, u64 arg2, u64 arg3, u64 arg4, u64 arg5)  {
+extern "C" s64 on_syscall(u64 sys_call_num, u64 arg1, u64 arg2, u64 arg3, u64 arg4, u64 arg5, u64 arg6)  {
     SysCallNumbers syscall = (SysCallNumbers)sys_call_num;
 
+    // these only touch the data that is guarded by its own lock, or read lock-free, so they dont need the kernel lock
+    // and run alongside the other cpus kernel code. They must not touch user memory while holding a lock,
+    // as the page fault handler takes the kernel lock
+    switch (syscall) {
+    case SysCallNumbers::CLOCK_GETTIME:
+        return syscall_handler.sys_clock_gettime((clockid_t )arg1, (struct timespec*)arg2);
+
+    case SysCallNumbers::SET_PRIORITY: // setpriority(id_t who, int prio)
+        return syscall_handler.sys_setpriority(arg1, arg2);
+
+    default:
+        break;
+    }
+
+    multitasking::KLockGuard lock;  // other cpus may be in the kernel too
+
     switch (syscall) {
     case SysCallNumbers::FILE_READ: // read (unsigned int fd char *buf   size_t count)
         return syscall_handler.sys_read(arg1, (char*)arg2, arg3);
@@ -82,15 +99,18 @@ extern "C" s64 on_syscall(u64 sys_call_num, u64 arg1, u64 arg2, u64 arg3, u64 ar
     case SysCallNumbers::BRK:
         return syscall_handler.sys_brk(arg1);
 
+    case SysCallNumbers::MMAP: // mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset)
+        return syscall_handler.sys_mmap((void*)arg1, arg2, arg3, arg4, arg5, arg6);
+
+    case SysCallNumbers::MUNMAP: // munmap(void* addr, size_t length)
+        return syscall_handler.sys_munmap((void*)arg1, arg2);
+
     case SysCallNumbers::GET_CWD:
         return syscall_handler.sys_get_cwd((char*)arg1, arg2);
 
     case SysCallNumbers::CHDIR:
 		return syscall_handler.sys_chdir((const char*)arg1);
 
-    case SysCallNumbers::CLOCK_GETTIME:
-        return syscall_handler.sys_clock_gettime((clockid_t )arg1, (struct timespec*)arg2);
-
     case SysCallNumbers::VGA_CURSOR_SETVISIBLE:
         syscall_handler.vga_cursor_setvisible((bool)arg1);
         return 0;
@@ -114,6 +134,9 @@ extern "C" s64 on_syscall(u64 sys_call_num, u64 arg1, u64 arg2, u64 arg3, u64 ar
         syscall_handler.vga_flush_video_buffer((const u8*)arg1);
         return 0;
 
+    case SysCallNumbers::VGA_MAP_VIDEO_BUFFER:
+        return syscall_handler.vga_map_video_buffer();
+
     case SysCallNumbers::VGA_GET_WIDTH_HEIGHT:
         syscall_handler.vga_get_width_height((u16*)arg1, (u16*)arg2);
         return 0;
@@ -136,6 +159,15 @@ extern "C" s64 on_syscall(u64 sys_call_num, u64 arg1, u64 arg2, u64 arg3, u64 ar
     case SysCallNumbers::TASK_WAIT:
         return syscall_handler.task_wait(arg1);
 
+    case SysCallNumbers::SHM_MAP:
+        return syscall_handler.shm_map((const char*)arg1, arg2);
+
+    case SysCallNumbers::SHM_UNLINK:
+        return syscall_handler.shm_unlink((const char*)arg1);
+
+    case SysCallNumbers::FORK:
+        return syscall_handler.sys_fork();
+
     case SysCallNumbers::TASK_LIGHTWEIGHT_RUN:
         return syscall_handler.task_lightweight_run(arg1, arg2, (const char*)arg3);
 
@@ -163,12 +195,13 @@ SysCallManager& SysCallManager::instance() {
 
 /**
  * @brief   Configure syscall-related Model Specific Registers and enable the "syscall/sysret" instructions in CPU
+ * @note    The registers are per cpu; every cpu runs it
  */
 void SysCallManager::config_and_activate_syscalls() {
-    hardware::Gdt gdt;
+    using hardware::Gdt;
     MSR_STAR s_star;
-    s_star.syscall_cs_ss = gdt.get_kernel_code_segment_selector() ;
-    s_star.sysret_cs_ss = gdt.get_user_data_segment_selector() - 8;
+    s_star.syscall_cs_ss = Gdt::get_kernel_code_segment_selector() ;
+    s_star.sysret_cs_ss = Gdt::get_user_data_segment_selector() - 8;
     s_star.syscall_target_eip_32bit = 0;
 
     u32 mask = 0x200; // disable interrupts
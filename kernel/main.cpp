@@ -48,14 +48,9 @@ s32 try_load_and_run_terminal() {
     }
     auto& elf = open_result.value;
 
-    // read elf file data
-    u64 size = elf->get_size().value;
-    u8* elf_data = new u8[size];
-    elf->read(elf_data, size);
-
-    // run the elf
+    // run the elf; its segments get loaded from the file on demand
     elf64::ElfRunner runner;
-    auto run_result = runner.run(elf_data, { "terminal" });
+    auto run_result = runner.run(elf, { "terminal" });
     switch (run_result.ec) {
     case ErrorCode::EC_NOMEM:
         phobos::printer.println(" Run failed - no enough memory. System Halt.", EgaColor::Red);
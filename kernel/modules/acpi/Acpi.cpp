@@ -0,0 +1,126 @@
+/**
+ *   @file: Acpi.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "kstd.h"
+#include "Acpi.h"
+#include "HigherHalf.h"
+#include "PageTables.h"
+
+using namespace memory;
+
+namespace acpi {
+
+/**
+ * @brief   Get Local APIC ids of the enabled cpus, as listed in MADT
+ * @param   rsdp RSDP given by the boot loader, or nullptr to search for it in BIOS memory
+ * @return  Number of ids put in "apic_ids", 0 if no MADT was found
+ */
+u32 Acpi::get_local_apic_ids(const void* rsdp, u32* apic_ids, u32 max_count) {
+    const AcpiRsdp* root = rsdp ? (const AcpiRsdp*)rsdp : find_rsdp();
+    if (!root)
+        return 0;
+
+    const AcpiMadt* madt = (const AcpiMadt*)find_table(root, "APIC");
+    if (!madt)
+        return 0;
+
+    u32 count = 0;
+    const u8* entry = madt->entries;
+    const u8* end = (const u8*)madt + madt->header.length;
+    while (entry + sizeof(AcpiMadtEntry) <= end && count < max_count) {
+        const AcpiMadtEntry* e = (const AcpiMadtEntry*)entry;
+        if (e->length < sizeof(AcpiMadtEntry))
+            break;
+
+        if (e->type == MADT_LOCAL_APIC) {
+            const AcpiMadtLocalApic* local_apic = (const AcpiMadtLocalApic*)entry;
+            if (local_apic->flags & LOCAL_APIC_ENABLED)
+                apic_ids[count++] = local_apic->apic_id;
+        }
+        entry += e->length;
+    }
+
+    return count;
+}
+
+/**
+ * @brief   Search for RSDP in the first 1KB of Extended BIOS Data Area and in BIOS read-only memory
+ * @return  nullptr if not found
+ */
+const AcpiRsdp* Acpi::find_rsdp() {
+    const u16 ebda_segment = *(const u16*)HigherHalf::phys_to_virt(0x40E);
+    const size_t ebda = (size_t)ebda_segment << 4;
+    if (ebda)
+        if (const AcpiRsdp* rsdp = find_rsdp(ebda, ebda + 1024 - 1))
+            return rsdp;
+
+    return find_rsdp(0xE0000, 0xFFFFF);
+}
+
+/**
+ * @brief   Search for RSDP in physical memory "first_byte".."last_byte"; RSDP is 16 bytes aligned
+ */
+const AcpiRsdp* Acpi::find_rsdp(size_t first_byte, size_t last_byte) {
+    for (size_t addr = first_byte; addr + sizeof(AcpiRsdp) <= last_byte + 1; addr += 16) {
+        const AcpiRsdp* rsdp = (const AcpiRsdp*)HigherHalf::phys_to_virt(addr);
+        if (memcmp(rsdp->signature, "RSD PTR ", sizeof(rsdp->signature)) == 0 && is_checksum_valid(rsdp, 20))
+            return rsdp;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief   Find table of given "signature" in XSDT, or in RSDT for ACPI 1.0
+ * @return  nullptr if not found or broken
+ */
+const AcpiSdtHeader* Acpi::find_table(const AcpiRsdp* rsdp, const char* signature) {
+    const bool has_xsdt = rsdp->revision >= 2 && rsdp->xsdt_address;
+    const AcpiSdtHeader* root = map_table(has_xsdt ? rsdp->xsdt_address : rsdp->rsdt_address);
+    if (!root)
+        return nullptr;
+
+    const size_t entry_size = has_xsdt ? sizeof(u64) : sizeof(u32);
+    const size_t count = (root->length - sizeof(AcpiSdtHeader)) / entry_size;
+    const u8* entries = (const u8*)root + sizeof(AcpiSdtHeader);
+    for (size_t i = 0; i < count; i++) {
+        const u64 table_phys_addr = has_xsdt ? *(const u64*)(entries + i * entry_size) : *(const u32*)(entries + i * entry_size);
+        const AcpiSdtHeader* table = map_table(table_phys_addr);
+        if (table && memcmp(table->signature, signature, sizeof(table->signature)) == 0)
+            return table;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief   Make table at "phys_addr" accessible
+ * @return  Table virtual address, nullptr if it cant be mapped or its checksum is wrong
+ */
+const AcpiSdtHeader* Acpi::map_table(u64 phys_addr) {
+    if (!phys_addr || !PageTables::map_reserved_memory(phys_addr, sizeof(AcpiSdtHeader), false))
+        return nullptr;
+
+    const AcpiSdtHeader* table = (const AcpiSdtHeader*)HigherHalf::phys_to_virt(phys_addr);
+    if (table->length < sizeof(AcpiSdtHeader) || !PageTables::map_reserved_memory(phys_addr, table->length, false))
+        return nullptr;
+
+    return is_checksum_valid(table, table->length) ? table : nullptr;
+}
+
+/**
+ * @brief   ACPI structures are valid if all their bytes sum up to 0
+ */
+bool Acpi::is_checksum_valid(const void* data, size_t size) {
+    u8 sum = 0;
+    for (size_t i = 0; i < size; i++)
+        sum += ((const u8*)data)[i];
+
+    return sum == 0;
+}
+
+} /* namespace acpi */
@@ -0,0 +1,90 @@
+/**
+ *   @file: Acpi.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_MODULES_ACPI_ACPI_H_
+#define KERNEL_MODULES_ACPI_ACPI_H_
+
+#include "types.h"
+
+namespace acpi {
+
+/**
+ * @brief   Root System Description Pointer; points to the table of all the other tables
+ */
+struct AcpiRsdp {
+    char    signature[8];       // "RSD PTR "
+    u8      checksum;           // of the first 20 bytes
+    char    oem_id[6];
+    u8      revision;           // 0 for ACPI 1.0, 2 for ACPI 2.0+
+    u32     rsdt_address;
+    // ACPI 2.0+ fields
+    u32     length;
+    u64     xsdt_address;
+    u8      extended_checksum;  // of the whole struct
+    u8      reserved[3];
+} __attribute__((packed));
+
+/**
+ * @brief   Header common to all the System Description Tables
+ */
+struct AcpiSdtHeader {
+    char    signature[4];
+    u32     length;             // including the header
+    u8      revision;
+    u8      checksum;           // of the whole table
+    char    oem_id[6];
+    char    oem_table_id[8];
+    u32     oem_revision;
+    u32     creator_id;
+    u32     creator_revision;
+} __attribute__((packed));
+
+/**
+ * @brief   Multiple APIC Description Table; lists the interrupt controllers, one Local APIC for each cpu
+ */
+struct AcpiMadt {
+    AcpiSdtHeader   header;     // signature "APIC"
+    u32             local_apic_address;
+    u32             flags;
+    u8              entries[0]; // variable length entries, each starting with AcpiMadtEntry
+} __attribute__((packed));
+
+struct AcpiMadtEntry {
+    u8      type;               // 0 for Processor Local APIC
+    u8      length;
+} __attribute__((packed));
+
+struct AcpiMadtLocalApic {
+    AcpiMadtEntry   header;
+    u8              acpi_processor_id;
+    u8              apic_id;
+    u32             flags;      // bit 0 - enabled, bit 1 - can be enabled
+} __attribute__((packed));
+
+/**
+ * @brief   This class reads the ACPI tables that describe the machine; so far the cpus are of interest
+ * @see     https://uefi.org/sites/default/files/resources/ACPI_6_3_final_Jan30.pdf, 5.2 ACPI System Description Tables
+ * @note    Static-class, used once at boot
+ */
+class Acpi {
+public:
+    static u32 get_local_apic_ids(const void* rsdp, u32* apic_ids, u32 max_count);
+
+private:
+    static constexpr u8 MADT_LOCAL_APIC     {0};
+    static constexpr u32 LOCAL_APIC_ENABLED {1};
+
+    static const AcpiRsdp* find_rsdp();
+    static const AcpiRsdp* find_rsdp(size_t first_byte, size_t last_byte);
+    static const AcpiSdtHeader* find_table(const AcpiRsdp* rsdp, const char* signature);
+    static const AcpiSdtHeader* map_table(u64 phys_addr);
+    static bool is_checksum_valid(const void* data, size_t size);
+};
+
+} /* namespace acpi */
+
+#endif /* KERNEL_MODULES_ACPI_ACPI_H_ */
@@ -139,32 +139,24 @@ bool Elf64::is_elf64(const void* elf64_data) {
 }
 
 /**
- * @brief   Load ELF64 executable from memory pointed by "elf64_data" into current address space
- * @return  Address of the executable entry point
- * @note    This can only work with statically linked -nostdlib binaries; very early stage of ELF64 support :)
+ * @brief   Get number of bytes at the beginning of the file that hold the ELF header and program headers table
+ * @note    Only the ELF header needs to be available under "elf64_data"
  */
-u64 Elf64::load_into_current_addressspace(void* elf64_data) {
-    if (!is_elf64(elf64_data))
-        return -1;
-
+size_t Elf64::get_headers_size(const void* elf64_data) {
     Elf64_Ehdr* hdr = (Elf64_Ehdr*) elf64_data;
+    return hdr->e_phoff + hdr->e_phnum * sizeof(Elf64_Phdr);
+}
 
-    Elf64_Phdr* segment = (Elf64_Phdr*)((char*)elf64_data + hdr->e_phoff);
-    for (auto i = 0; i < hdr->e_phnum; i++) {
-        if (segment->p_type == 1) { // PT_LOAD
-            // TODO: add checks to ensure that segment->p_vaddr..segment->p_vaddr+segment->p_filesz stays out of kernel address space
-            memset((u8*)segment->p_vaddr, 0, segment->p_memsz); // clear memory in case file size < memory size
-            memcpy((u8*)segment->p_vaddr, (u8*)elf64_data + segment->p_offset, segment->p_filesz); // copy segment
-        }
-
-        segment++;
-    }
-
+/**
+ * @brief   Get virtual address of the executable entry point
+ */
+u64 Elf64::get_entry_point(const void* elf64_data) {
+    Elf64_Ehdr* hdr = (Elf64_Ehdr*) elf64_data;
     return hdr->e_entry;
 }
 
 /**
- * @brief   Get first unused virtual mem byte after loading elf with load_into_current_addressspace
+ * @brief   Get first unused virtual mem byte above the elf program segments
  */
 s64 Elf64::get_available_memory_first_byte(void* elf64_data) {
     u64 highest_byte = 0;
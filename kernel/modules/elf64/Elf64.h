@@ -113,7 +113,8 @@ public:
     static cstd::string section_header_to_string(const char* section_names, Elf64_Shdr* section_header);
     static cstd::string segment_header_to_string(Elf64_Phdr* segment_header);
     static bool is_elf64(const void* elf64_data);
-    static u64 load_into_current_addressspace(void* elf64_data);
+    static size_t get_headers_size(const void* elf64_data);
+    static u64 get_entry_point(const void* elf64_data);
     static s64 get_available_memory_first_byte(void* elf64_data);
 };
 
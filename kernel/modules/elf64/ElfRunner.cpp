@@ -38,15 +38,14 @@ static char** string_vec_to_argv(const vector<string>& src_vec, AddressSpace& ad
 
 /**
  * @brief   ELF loader kernel task that runs already in the task address space
- *          and thus is able to load the elf program segments into memory at virtual addresses starting at "0"
- * @note    This function frees the elf_file_data and args
+ *          and thus is able to put the program arguments into the task memory.
+ *          The elf program segments are not copied here; they get loaded from the file on Page Fault, page by page
+ * @param   args_addr Address of the program arguments vector<string>; a plain u64, so the function is a TaskEntryPoint2
+ * @note    This function frees the args
  *          The actual task gets task_id of elf_loader
  */
-static void load_and_run_elf(u8* elf_file_data, vector<string>* args) {
-    // copy elf sections into address space and remember where free virtual memory starts
-    size_t entry_point = utils::Elf64::load_into_current_addressspace(elf_file_data);
-    delete[] elf_file_data;
-
+static void load_and_run_elf(u64 entry_point, u64 args_addr) {
+    vector<string>* args = (vector<string>*)args_addr;
     TaskManager& task_manager = TaskManager::instance();
     Task& elf_loader_task =  task_manager.get_current_task();
 
@@ -79,39 +78,110 @@ static Task* make_elf_loader_task(const AddressSpace& as) {
 
 /**
  * @brief   Run elf as user task and return immediately
- * @param   elf_data ELF64 file data loaded into kernel memory. This function finally free the "elf_data"
+ * @param   file ELF64 file opened for reading. Only the headers are read here,
+ *          the program segments are mapped into the task address space and read from the file on demand
  * @param   args User-provided cmd line arguments
  * @return  Error code on error, task id on success
  */
-SyscallResult<u32> ElfRunner::run(u8* elf_data, const vector<string>& args) const {
-    // check if elf_data points to actual Elf64
-    if (!Elf64::is_elf64(elf_data))
-        return {ErrorCode::EC_NOEXEC};
+SyscallResult<u32> ElfRunner::run(const filesystem::OpenEntryPtr& file, const vector<string>& args) const {
+    // read elf header and program headers table, just enough to know where the segments go
+    u8* headers;
+    if (auto result = read_headers(file))
+        headers = result.value;
+    else
+        return {result.ec};
 
     // try alloc new address space for our elf program
     AddressSpace as;
-    if (auto result = alloc_address_space(Elf64::get_available_memory_first_byte(elf_data), ELF_VIRTUAL_MEM_BYTES))
+    if (auto result = alloc_address_space(Elf64::get_available_memory_first_byte(headers), ELF_VIRTUAL_MEM_BYTES))
         as = result.value;
-    else
+    else {
+        delete[] headers;
         return {result.ec};
+    }
+
+    // map the program segments; bytes past the segment file size are zero, like .bss
+    Elf64_Ehdr* hdr = (Elf64_Ehdr*)headers;
+    Elf64_Phdr* segment = (Elf64_Phdr*)(headers + hdr->e_phoff);
+    for (auto i = 0; i < hdr->e_phnum; i++, segment++)
+        if (segment->p_type == 1 && segment->p_memsz > 0) // PT_LOAD
+            as.memory_areas.push_back({segment->p_vaddr, segment->p_vaddr + segment->p_memsz - 1, segment->p_offset, segment->p_filesz, file, true});
+
+    const u64 entry_point = Elf64::get_entry_point(headers);
+    delete[] headers;
 
     // alloc arguments in kernel address space so they can be safely passed to elf_loader kernel task
     vector<string>* pargs = new vector<string>(args);
 
-    // prepare elf_loader kernel task with fresh address space to load elf segments into
-    Task* elf_loader = make_elf_loader_task(as)->set_arg1(elf_data)->set_arg2(pargs);
+    // prepare elf_loader kernel task with fresh address space to run the elf in
+    Task* elf_loader = make_elf_loader_task(as)->set_arg1(entry_point)->set_arg2(pargs);
 
     // try run the elf_loader; it will release the memory
     TaskManager& task_manager = TaskManager::instance();
     if (u32 tid = task_manager.add_task(elf_loader)) {
         return {tid};
     }
-    // on failure release the memory by ourself
+    // on failure release the memory by ourself; add_task already deleted elf_loader, and its task group data
+    // released the address space "as" along with it, so releasing "as" here again would free its frames twice
     else {
-        delete[] elf_data;
         delete pargs;
         return {ErrorCode::EC_PERM};  // running new task not permitted at this time
     }
 }
 
+/**
+ * @brief   Read ELF64 header and program headers table from the beginning of the "file"
+ * @return  Headers allocated with new[] on success, EC_NOEXEC if the file is not a loadable ELF64
+ */
+SyscallResult<u8*> ElfRunner::read_headers(const filesystem::OpenEntryPtr& file) {
+    Elf64_Ehdr hdr;
+    file->seek(0);
+    if (file->read(&hdr, sizeof(hdr)).value != sizeof(hdr) || !Elf64::is_elf64(&hdr))
+        return {ErrorCode::EC_NOEXEC};
+
+    // program headers are walked as an array of Elf64_Phdr
+    if (hdr.e_phentsize != sizeof(Elf64_Phdr))
+        return {ErrorCode::EC_NOEXEC};
+
+    const u64 file_size = file->get_size().value;
+    const size_t headers_size = Elf64::get_headers_size(&hdr);
+    if (hdr.e_phoff > file_size || headers_size > file_size)
+        return {ErrorCode::EC_NOEXEC};
+
+    u8* headers = new u8[headers_size];
+    if (!headers)
+        return {ErrorCode::EC_NOMEM};
+
+    file->seek(0);
+    if (file->read(headers, headers_size).value != headers_size || !has_valid_segments(headers, file_size)) {
+        delete[] headers;
+        return {ErrorCode::EC_NOEXEC};
+    }
+
+    return {headers};
+}
+
+/**
+ * @brief   Check if all the loadable segments fit in user virtual memory and their data fit in the "file_size" bytes file
+ */
+bool ElfRunner::has_valid_segments(const u8* headers, u64 file_size) {
+    Elf64_Ehdr* hdr = (Elf64_Ehdr*)headers;
+    Elf64_Phdr* segment = (Elf64_Phdr*)(headers + hdr->e_phoff);
+    for (auto i = 0; i < hdr->e_phnum; i++, segment++) {
+        if (segment->p_type != 1) // PT_LOAD
+            continue;
+
+        if (segment->p_filesz > segment->p_memsz)
+            return false;
+
+        if (segment->p_offset > file_size || segment->p_filesz > file_size - segment->p_offset)
+            return false;
+
+        if (segment->p_vaddr >= ELF_VIRTUAL_MEM_BYTES || segment->p_memsz > ELF_VIRTUAL_MEM_BYTES - segment->p_vaddr)
+            return false;
+    }
+
+    return true;
+}
+
 } /* namespace elf64 */
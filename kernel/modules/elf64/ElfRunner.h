@@ -9,6 +9,7 @@
 #define SRC_USERSPACE_ELFRUNNER_H_
 
 #include "Vector.h"
+#include "OpenEntry.h"
 #include "SyscallResult.h"
 
 namespace elf64 {
@@ -18,9 +19,12 @@ namespace elf64 {
  */
 class ElfRunner {
 public:
-    utils::SyscallResult<u32> run(u8* elf_data, const cstd::vector<cstd::string>& args) const;
+    utils::SyscallResult<u32> run(const filesystem::OpenEntryPtr& file, const cstd::vector<cstd::string>& args) const;
 
 private:
+    static utils::SyscallResult<u8*> read_headers(const filesystem::OpenEntryPtr& file);
+    static bool has_valid_segments(const u8* headers, u64 file_size);
+
     static constexpr size_t ELF_VIRTUAL_MEM_BYTES   = 1024*1024*1024;  // 1GB of virtual memory can be dynamically mapped on Page Fault, as for now
 };
 
@@ -29,12 +29,14 @@ MassStorageMsDos::MassStorageMsDos(const AtaDevice& hdd) {
     if (!verify(hdd))
         return;
 
-    // collect all FAT32 volumes
+    // collect all FAT32 volumes and swap partitions
     MasterBootRecord mbr = read_mbr(hdd);
     for (u8 i = 0; i < 4; i++) {
         const auto& p = mbr.primary_partition[i];
         if (p.partition_id == PARTITION_TYPE_FAT32)
             volumes.emplace_back(hdd, p.bootable, p.start_lba, p.length);
+        else if (p.partition_id == PARTITION_TYPE_SWAP)
+            swap_partitions.push_back(p);
     }
 }
 
@@ -42,5 +44,12 @@ vector<VolumeFat32>& MassStorageMsDos::get_volumes() {
     return volumes;
 }
 
+/**
+ * @brief   Get partitions of Linux swap type; they hold no filesystem and are used as raw swap space
+ */
+const vector<PartitionTableEntry>& MassStorageMsDos::get_swap_partitions() const {
+    return swap_partitions;
+}
+
 } /* namespace fat32 */
 } /* namespace filesystem */
@@ -51,6 +51,7 @@ public:
     static bool verify(const drivers::AtaDevice& hdd);
     MassStorageMsDos(const drivers::AtaDevice& hdd);
     cstd::vector<VolumeFat32>& get_volumes();
+    const cstd::vector<PartitionTableEntry>& get_swap_partitions() const;
 
 private:
     static MasterBootRecord read_mbr(const drivers::AtaDevice& hdd);
@@ -58,8 +59,10 @@ private:
     // see https://www.win.tue.nl/~aeb/partitions/partition_types-1.html
     static const u8 PARTITION_TYPE_NONE     = 0x00;
     static const u8 PARTITION_TYPE_FAT32    = 0x0B;
+    static const u8 PARTITION_TYPE_SWAP     = 0x82;
 
     cstd::vector<VolumeFat32> volumes;  // in the future should be of type: shared_ptr<GenericVolume>
+    cstd::vector<PartitionTableEntry> swap_partitions;
 };
 
 } /* namespace fat32 */
@@ -23,11 +23,13 @@ CommandLine* Multiboot2::cmd;
 BootLoader* Multiboot2::bl;
 FrameBuffer* Multiboot2::fb;
 MemoryMap* Multiboot2::mm;
-MemoryMapEntry* Multiboot2::mme[20];    // 20 is selected arbitrarily
+MemoryMapEntry* Multiboot2::mme[MAX_MEMORY_MAP_ENTRIES];
 unsigned int Multiboot2::mme_count;
 Elf64Sections* Multiboot2::es;
 Elf64_Shdr* Multiboot2::esh[50];// 50 is selected arbitrarily
 unsigned int Multiboot2::esh_count;
+unsigned char Multiboot2::acpi_rsdp[MAX_ACPI_RSDP_SIZE];
+unsigned int Multiboot2::acpi_rsdp_type;
 
 
 /**
@@ -75,7 +77,7 @@ void Multiboot2::initialize(void *multiboot2_info_ptr) {
         case 6: {
             MemoryMap *mmp = (MemoryMap*)tag_ptr;
             mm = mmp;
-            mme_count = (mm->size - sizeof(MemoryMap)) / mm->entry_size;
+            mme_count = min((mm->size - sizeof(MemoryMap)) / mm->entry_size, (size_t)MAX_MEMORY_MAP_ENTRIES);
 
             char *entry_ptr = tag_ptr + sizeof(MemoryMap);
             for (int i = 0; i < mme_count; i++) {
@@ -93,6 +95,18 @@ void Multiboot2::initialize(void *multiboot2_info_ptr) {
             break;
         }
 
+        case 14:
+        case 15: {
+            // prefer ACPI 2.0+ RSDP, it points to 64bit tables
+            AcpiRsdpCopy *rsdpp = (AcpiRsdpCopy*)tag_ptr;
+            if (rsdpp->type < acpi_rsdp_type)
+                break;
+
+            memcpy(acpi_rsdp, rsdpp->rsdp, min(rsdpp->size - sizeof(AcpiRsdpCopy), (size_t)MAX_ACPI_RSDP_SIZE));
+            acpi_rsdp_type = rsdpp->type;
+            break;
+        }
+
         case 9: {
             Elf64Sections *esp = (Elf64Sections*)tag_ptr;
             es = esp;
@@ -119,6 +133,14 @@ void Multiboot2::initialize(void *multiboot2_info_ptr) {
     }
 }
 
+/**
+ * @brief   Get copy of ACPI Root System Description Pointer, as given by the boot loader
+ * @return  nullptr if the boot loader gave none
+ */
+const void* Multiboot2::get_acpi_rsdp() {
+    return acpi_rsdp_type ? acpi_rsdp : nullptr;
+}
+
 /**
  * @return  First byte of physical memory available for use
  */
@@ -142,9 +164,41 @@ size_t Multiboot2::get_available_memory_first_byte() {
 
 /**
  * @return  Last byte of physical memory available for use
+ * @note    Memory below this byte can have holes; see get_available_memory_map
  */
 size_t Multiboot2::get_available_memory_last_byte() {
-    return bmi->upper * 1024 ;
+    if (mme_count == 0)
+        return bmi->upper * 1024; // no memory map provided by the boot loader
+
+    return get_available_memory_map().get_last_byte();
+}
+
+/**
+ * @return  All the physical memory regions available for use, past kernel image and multiboot2 structures
+ * @note    Falls back to single region ending at basic memory info "upper" limit if no memory map provided by the boot loader
+ */
+PhysicalMemoryMap Multiboot2::get_available_memory_map() {
+    const size_t first_byte = get_available_memory_first_byte();
+    PhysicalMemoryMap result;
+
+    if (mme_count == 0) {
+        result.add_region(first_byte, bmi->upper * 1024);
+        return result;
+    }
+
+    for (u32 i = 0; i < mme_count; i++) {
+        if (mme[i]->type != 1 || mme[i]->length == 0) // only type 1 is available for use
+            continue;
+
+        const size_t region_first = mme[i]->address;
+        const size_t region_last = mme[i]->address + mme[i]->length - 1;
+        if (region_last < first_byte)
+            continue;
+
+        result.add_region(max(region_first, first_byte), region_last);
+    }
+
+    return result;
 }
 
 /**
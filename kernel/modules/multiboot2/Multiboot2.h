@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include "Elf64.h"
+#include "PhysicalMemoryMap.h"
 
 namespace utils {
 
@@ -70,6 +71,12 @@ struct FrameBuffer {
     // here color palette if fb_type == 0
 } __attribute__((packed));
 
+struct AcpiRsdpCopy {
+    unsigned int type;  // = 14 for ACPI 1.0 RSDP, 15 for ACPI 2.0+ one
+    unsigned int size;
+    unsigned char rsdp[0];  // copy of the Root System Description Pointer
+} __attribute__((packed));
+
 struct Elf64Sections {
     unsigned int type;  // = 9
     unsigned int size;
@@ -92,11 +99,16 @@ public:
     static void initialize(void *multiboot2_info_ptr);
     static size_t get_available_memory_first_byte();
     static size_t get_available_memory_last_byte();
+    static memory::PhysicalMemoryMap get_available_memory_map();
+    static const void* get_acpi_rsdp();
     static cstd::string to_string();
 
 private:
     Multiboot2() = delete;  // don't instantiate this class
 
+    static constexpr unsigned int MAX_MEMORY_MAP_ENTRIES {memory::PhysicalMemoryMap::MAX_REGIONS};
+    static constexpr unsigned int MAX_ACPI_RSDP_SIZE {36};  // ACPI 2.0+ RSDP size
+
     static size_t multiboot2_info_addr;
     static size_t multiboot2_info_totalsize;
     static BasicMemInfo* bmi;
@@ -109,6 +121,8 @@ private:
     static Elf64Sections* es;
     static Elf64_Shdr* esh[];
     static unsigned int esh_count;
+    static unsigned char acpi_rsdp[];   // copied, as the multiboot2 info memory is not reserved and gets reused
+    static unsigned int acpi_rsdp_type;
 };
 
 } // namespace utils
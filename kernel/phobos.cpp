@@ -17,12 +17,17 @@
 #include "Mouse.h"
 #include "MouseDriver.h"
 #include "PitDriver.h"
+#include "LocalApicTimerDriver.h"
+#include "LocalApic.h"
+#include "CpuInfo.h"
+#include "Smp.h"
+#include "Acpi.h"
 #include "Int80hDriver.h"
 #include "PCIController.h"
 #include "PageFaultHandler.h"
 #include "PageTables.h"
 #include "BumpAllocationPolicy.h"
-#include "WyoosAllocationPolicy.h"
+#include "SlabAllocationPolicy.h"
 #include "Assert.h"
 #include "KernelLog.h"
 
@@ -33,13 +38,16 @@
 #include "VfsMemInfoEntry.h"
 #include "VfsDateEntry.h"
 #include "VfsCpuInfoEntry.h"
+#include "VfsLocksInfoEntry.h"
 #include "VfsPciInfoEntry.h"
 #include "VfsPsInfoEntry.h"
+#include "VfsTaskDirEntry.h"
 #include "VfsMountInfoEntry.h"
 #include "MassStorageMsDos.h"
 #include "VfsFat32MountPoint.h"
 #include "PageFault.h"
 #include "AddressSpaceManager.h"
+#include "Swap.h"
 #include "phobos.h"
 
 #include "services/cpuexceptions/Requests.h"
@@ -48,6 +56,7 @@
 #include "services/filesystem/Requests.h"
 #include "services/ipc/Requests.h"
 #include "modules/fat32/Requests.h"
+#include "services/memory/Requests.h"
 
 using namespace cstd;
 using namespace logging;
@@ -65,7 +74,9 @@ using namespace middlespace;
 
 namespace phobos {
     namespace details {
-        constexpr u32           PIT_FREQUENCY_HZ    {20};
+        constexpr u32           PIT_FREQUENCY_HZ    {20};   // ticks only till the Local APIC timer takes over, see setup_cpu_timers
+        constexpr u64           SCHED_TICK_US       {1000 * 1000 / PIT_FREQUENCY_HZ};  // schedulers count time slices in these
+        constexpr u64           NO_DEADLINE         {LocalApicTimerDriver::NO_DEADLINE};
         KernelLog&              klog                {logging::KernelLog::instance()};
         MemoryManager&          memory_manager      {memory::MemoryManager::instance()};
         ExceptionManager&       exception_manager   {cpuexceptions::ExceptionManager::instance()};
@@ -77,11 +88,14 @@ namespace phobos {
         KeyboardDriver          keyboard            {scs1};
         MouseDriver             mouse;
         PitDriver               pit;
+        LocalApicTimerDriver    apic_timer;
         AtaPrimaryBusDriver     ata_primary_bus;
         AtaSecondaryBusDriver   ata_secondary_bus;
         VgaDriver               vga;
         Int80hDriver            int80h;
         PageFaultHandler        page_fault;
+        bool                    is_tickless         {false};    // cpus run one-shot Local APIC timers instead of PIT ticks
+        u64                     sched_tick_at_us[PerCpu::MAX_CPUS]; // per cpu; when the running task gets next scheduler tick
 
         /**
          * @brief   Install ram fs /dev
@@ -104,11 +118,53 @@ namespace phobos {
             vfs_manager.attach("/proc", cstd::make_shared<VfsCpuInfoEntry>());
             vfs_manager.attach("/proc", cstd::make_shared<VfsPciInfoEntry>());
             vfs_manager.attach("/proc", cstd::make_shared<VfsPsInfoEntry>());
+            vfs_manager.attach("/proc", cstd::make_shared<VfsTaskDirEntry>());
             vfs_manager.attach("/proc", cstd::make_shared<VfsMountInfoEntry>());
+            vfs_manager.attach("/proc", cstd::make_shared<VfsLocksInfoEntry>());
         }
 
         /**
-         * @brief   Mount all volumes available in "hdd" under the root
+         * @brief	Requests that memory component sends to the kernel; swap pages are kept on a swap partition
+         */
+        class MemoryRequests : public memory::Requests {
+        public:
+            void log(const char* s) override {
+                klog.put(s);
+            }
+            bool read_swap_page(size_t slot, void* page) override {
+                for (u32 i = 0; i < SECTORS_PER_PAGE; i++)
+                    if (!swap_hdd->read28(swap_first_sector + slot * SECTORS_PER_PAGE + i, (u8*)page + i * AtaDevice::BYTES_PER_SECTOR, AtaDevice::BYTES_PER_SECTOR))
+                        return false;
+                return true;
+            }
+            bool write_swap_page(size_t slot, const void* page) override {
+                for (u32 i = 0; i < SECTORS_PER_PAGE; i++)
+                    if (!swap_hdd->write28(swap_first_sector + slot * SECTORS_PER_PAGE + i, (const u8*)page + i * AtaDevice::BYTES_PER_SECTOR, AtaDevice::BYTES_PER_SECTOR))
+                        return false;
+                return true;
+            }
+
+            static constexpr u32 SECTORS_PER_PAGE {PageTables::get_page_size() / AtaDevice::BYTES_PER_SECTOR};
+            const AtaDevice*    swap_hdd            {nullptr};
+            u32                 swap_first_sector   {0};
+        } memory_requests;
+
+        /**
+         * @brief   Use "partition" of "hdd" as swap space, unless swap space is already there
+         */
+        void install_swap_partition(const AtaDevice& hdd, const fat32::PartitionTableEntry& partition) {
+            if (Swap::is_installed())
+                return;
+
+            memory_requests.swap_hdd = &hdd;
+            memory_requests.swap_first_sector = partition.start_lba;
+            memory::requests = &memory_requests;
+            if (Swap::install(partition.length / MemoryRequests::SECTORS_PER_PAGE))
+                klog.format("Swap partition installed: % MB\n", partition.length / 2 / 1024);
+        }
+
+        /**
+         * @brief   Mount all volumes available in "hdd" under the root, use the first swap partition found as swap space
          */
         void mount_hdd_fat32_volumes(const AtaDevice& hdd) {
             if (!fat32::MassStorageMsDos::verify(hdd))
@@ -117,6 +173,9 @@ namespace phobos {
             fat32::MassStorageMsDos ms(hdd);
             for (const auto& v : ms.get_volumes())
                 vfs_manager.attach("/", cstd::make_shared<fat32::VfsFat32MountPoint>(v));
+
+            for (const auto& p : ms.get_swap_partitions())
+                install_swap_partition(hdd, p);
         }
 
         /**
@@ -124,7 +183,7 @@ namespace phobos {
          */
         class Fat32Requests : public filesystem::fat32::Requests {
         public:
-            void log(const cstd::string& s) override {
+            void log(const char* s) override {
                 klog.put(s);
             }
         } fat32_requests;
@@ -221,7 +280,44 @@ namespace phobos {
          */
         CpuState* handle_timer_tick(CpuState* cpu_state) {
             time_manager.tick();
-            return task_manager.schedule(cpu_state);
+            return task_manager.on_timer_tick(cpu_state);
+        }
+
+        /**
+         * @brief   Local APIC timer handling; the timer fires at the nearest deadline of the cpu, or when other cpu queued a task for it
+         */
+        CpuState* handle_cpu_timer_tick(CpuState* cpu_state) {
+            u64& sched_tick_at = sched_tick_at_us[PerCpu::current().index];
+
+            time_manager.expire_timers();
+            if (task_manager.is_current_task_idle() || time_manager.get_uptime_us() >= sched_tick_at) {
+                sched_tick_at = NO_DEADLINE;
+                cpu_state = task_manager.on_timer_tick(cpu_state);
+            }
+            return cpu_state;
+        }
+
+        /**
+         * @brief   Arm the timer of current cpu for its nearest deadline: the soonest timer, and next scheduler tick if a task runs.
+         *          Idle cpu gets no scheduler ticks; it sleeps till the soonest timer or till other cpu wakes it up for a new task
+         * @note    Run on interrupt exit, when the task to run is already picked and the timers are updated
+         */
+        void arm_cpu_timer() {
+            if (!is_tickless)
+                return;
+
+            u64& sched_tick_at = sched_tick_at_us[PerCpu::current().index];
+            const u64 now = time_manager.get_uptime_us();
+            u64 deadline = time_manager.get_next_expire_us();
+            if (task_manager.is_current_task_idle())
+                sched_tick_at = NO_DEADLINE;
+            else {
+                if (sched_tick_at == NO_DEADLINE)
+                    sched_tick_at = now + SCHED_TICK_US;
+                deadline = min(deadline, sched_tick_at);
+            }
+
+            apic_timer.set_deadline(now, deadline);
         }
 
         /**
@@ -242,7 +338,7 @@ namespace phobos {
          */
         class DriversRequests : public drivers::Requests {
         public:
-            void log(const cstd::string& s) override {
+            void log(const char* s) override {
                 klog.put(s);
             }
         } drivers_requests;
@@ -253,6 +349,7 @@ namespace phobos {
             driver_manager.install_driver(&keyboard);
             driver_manager.install_driver(&mouse);
             driver_manager.install_driver(&pit);
+            driver_manager.install_driver(&apic_timer);
             driver_manager.install_driver(&ata_primary_bus);
             driver_manager.install_driver(&ata_secondary_bus);
             driver_manager.install_driver(&vga);
@@ -264,7 +361,7 @@ namespace phobos {
          */
         class FilesystemRequests : public filesystem::Requests {
         public:
-            void log(const cstd::string& s) override {
+            void log(const char* s) override {
                 klog.put(s);
             }
         } filesystem_requests;
@@ -282,14 +379,21 @@ namespace phobos {
          */
         class CpuExceptinsRequests : public cpuexceptions::Requests {
         public:
-        	void log(const cstd::string& s) override {
+        	void log(const char* s) override {
         		klog.put(s);
         	}
         	PageFaultActualReason get_page_fault_reason(u64 faulty_address, u64 pml4_phys_addr, u64 cpu_error_code) override {
                 return PageFault::get_page_fault_reason(faulty_address, pml4_phys_addr, cpu_error_code);
         	}
         	bool alloc_missing_page(u64 virtual_address, u64 pml4_phys_addr) override {
-                return PageFault::alloc_missing_page(virtual_address, pml4_phys_addr);
+                const TaskGroupDataPtr& task_group_data = task_manager.get_current_task().task_group_data;
+                if (!task_group_data) // boot task, before multitasking starts; has no address space of its own
+                    return PageFault::alloc_missing_page(virtual_address, pml4_phys_addr, boot_address_space);
+
+                return PageFault::alloc_missing_page(virtual_address, pml4_phys_addr, task_group_data->address_space);
+        	}
+        	bool copy_on_write(u64 virtual_address, u64 pml4_phys_addr) override {
+                return PageFault::copy_on_write(virtual_address, pml4_phys_addr);
         	}
         	cstd::string& get_current_task_name() override {
         		return task_manager.get_current_task().name;
@@ -298,8 +402,12 @@ namespace phobos {
         		return task_manager.get_current_task().is_user_space;
         	}
         	hardware::CpuState* kill_current_task_group() override {
+                // the faulting code holds a spin lock that would never be released, and the task teardown takes the same locks
+                utils::phobos_assert(!IrqSpinLock::is_any_held(), "Page fault in kernel code that holds a spin lock; cant kill the task");
         		return task_manager.kill_current_task_group();
         	}
+        private:
+            AddressSpace boot_address_space {};    // no memory areas, no heap; only counts the boot task page faults
         } cpuexceptions_requests;
 
         void setup_cpuexceptions() {
@@ -312,26 +420,39 @@ namespace phobos {
          */
         class MultitaskingRequests: public multitasking::Requests {
         public:
-        	void log(const cstd::string& s) override {
+        	void log(const char* s) override {
         		klog.put(s);
         	}
-        	void timer_emplace(u32 millis, const OnTimerExpire& on_expire) override {
-        		time_manager.emplace(millis, on_expire);
+        	void timer_emplace(u64 micros, const OnTimerExpire& on_expire) override {
+        		time_manager.emplace_us(micros, 0, on_expire);
         	}
+            void wake_cpu(u32 cpu) override {
+                if (is_tickless)
+                    apic_timer.fire_on_cpu(cpu);    // PIT ticks make idle bootstrap cpu look for tasks otherwise
+            }
+            u64 get_uptime_us() override {
+                return time_manager.get_uptime_us();
+            }
             void* alloc_stack_and_mark_guard_page(AddressSpace& as, size_t num_bytes) override {
                 return memory::alloc_stack_and_mark_guard_page(as, num_bytes);
             }
+            void release_stack(AddressSpace& as, void* stack_addr, size_t num_bytes) override {
+                memory::release_stack(as, stack_addr, num_bytes);
+            }
             AddressSpace get_kernel_address_space() override {
                 return {HigherHalf::get_kernel_heap_low_limit(), 
                     HigherHalf::get_kernel_heap_high_limit(),
                     PageTables::get_kernel_pml4_phys_addr()};
             }
             void load_address_space(const AddressSpace& as) override {
-                PageTables::load_address_space(as.pml4_phys_addr);
+                PageTables::load_address_space(as.pml4_phys_addr, as.pcid);
             }
             void release_address_space(AddressSpace& as) override {
                 memory::release_address_space(as);
             }
+            bool refill_zeroed_frame_pool() override {
+                return ZeroedFramePool::refill_one_frame();
+            }
         } multitasking_requests;
 
         void setup_multitasking() {
@@ -339,13 +460,102 @@ namespace phobos {
         	task_manager.install_multitasking();
         }
 
+        /**
+         * @brief   Measure the Local APIC timer and the cpu timestamp counter speeds against the PIT channel 2 countdown,
+         *          the way CpuSpeedEstimator does; neither of the two frequencies is known up front
+         * @return  Timestamp counter frequency in Hz
+         */
+        u64 calibrate_local_apic_timer() {
+            constexpr u32 PIT_COUNTDOWN_START   {0xFFFF};
+            constexpr u32 PIT_MEASURE_TICKS     {PitDriver::PIT_OSCILLATOR_HZ / 25};  // 40ms; the countdown runs out after 55ms
+            constexpr u32 APIC_COUNTDOWN_START  {0xFFFFFFFF};
+
+            const u16 interrupt_mask = interrupt_manager.disable_interrupts();
+            pit.set_channel2_count(PIT_COUNTDOWN_START);
+            LocalApic::start_timer_countdown(APIC_COUNTDOWN_START);
+            const u64 start_cycles = CpuInfo().get_rtdsc();
+
+            u32 pit_ticks;
+            while ((pit_ticks = PIT_COUNTDOWN_START - pit.get_channel2_count()) < PIT_MEASURE_TICKS)
+                asm volatile("pause");
+
+            const u64 cycles = CpuInfo().get_rtdsc() - start_cycles;
+            const u64 apic_ticks = APIC_COUNTDOWN_START - LocalApic::get_timer_count();
+            interrupt_manager.enable_interrupts(interrupt_mask);
+
+            LocalApic::set_timer_ticks_per_ms(apic_ticks * PitDriver::PIT_OSCILLATOR_HZ / pit_ticks / 1000);
+            return cycles * PitDriver::PIT_OSCILLATOR_HZ / pit_ticks;
+        }
+
+        /**
+         * @brief   Replace the PIT ticks with one-shot Local APIC timers: time is read from the timestamp counter
+         *          running at "cycles_per_second", and every cpu programs its timer for the nearest deadline it has, see arm_cpu_timer
+         * @note    Local APIC timer must be calibrated
+         */
+        void setup_cpu_timers(u64 cycles_per_second) {
+            for (u64& sched_tick_at : sched_tick_at_us)
+                sched_tick_at = NO_DEADLINE;
+
+            interrupt_manager.mask_interrupt(Interrupts::PIT);
+            time_manager.set_clock([] { return CpuInfo().get_rtdsc(); }, cycles_per_second);
+            is_tickless = true;
+            arm_cpu_timer();
+        }
+
+        /**
+         * @brief   Entry point of application cpu, see Smp::boot_application_cpus. The cpu sets itself up the way the bootstrap cpu is set up,
+         *          waits till the kernel is booted and then runs tasks from its timer interrupts on
+         */
+        [[noreturn]] void run_application_cpu(u64 cpu_index) {
+            cpuconfig::activate_legacy_sse();
+            Smp::install_application_cpu(cpu_index);
+            PageTables::load_kernel_address_space();
+            interrupt_manager.config_application_cpu_interrupts();
+            syscall_manager.config_and_activate_syscalls();
+            Smp::wait_for_release();
+
+            // wait for other cpu to queue a task for this one, see MultitaskingRequests::wake_cpu
+            while (true)
+                asm volatile("sti; hlt");
+        }
+
+        /**
+         * @brief   Enable the Local APIC, boot the application cpus listed in ACPI tables and switch to the Local APIC timers.
+         *          The system runs on the bootstrap cpu alone if there is no Local APIC or no ACPI tables;
+         *          with no Local APIC it keeps the PIT ticks
+         * @note    Dynamic memory and PIT interrupts must be available
+         */
+        void setup_smp() {
+            if (!LocalApic::is_present())
+                return;
+
+            const u64 local_apic_phys_addr = LocalApic::get_phys_address();
+            if (!PageTables::map_reserved_memory(local_apic_phys_addr, PageTables::get_page_size(), true))
+                return;
+
+            LocalApic::install(HigherHalf::phys_to_virt(local_apic_phys_addr));
+            LocalApic::enable();
+            PerCpu::current().apic_id = LocalApic::get_id();
+            const u64 cycles_per_second = calibrate_local_apic_timer();
+
+            // application cpus booting delays use the Local APIC timer, so it is not yet armed for the deadlines
+            u32 apic_ids[PerCpu::MAX_CPUS];
+            const u32 apic_count = acpi::Acpi::get_local_apic_ids(Multiboot2::get_acpi_rsdp(), apic_ids, PerCpu::MAX_CPUS);
+            if (apic_count >= 2) {
+                const u32 cpu_count = Smp::boot_application_cpus(apic_ids, apic_count, run_application_cpu);
+                klog.format("Cpus booted: % of %\n", cpu_count, apic_count);
+            }
+
+            setup_cpu_timers(cycles_per_second);
+        }
+
         class IpcRequests : public ipc::Requests {
         public:
             void block_current_task(TaskList& list) override  {
                 task_manager.block_current_task(list);
             }
             void unblock_tasks(TaskList& list) override {
-                task_manager.unblock_tasks(list);
+                task_manager.unblock_tasks(list, true);   // tasks waiting on FIFOs are interactive, eg. terminal waiting for keys
             }
         } ipc_requests;
 
@@ -373,8 +583,10 @@ namespace phobos {
     [[noreturn]] void boot_and_start_multitasking(void* multiboot2_info_ptr, const InitTaskPtr init_task) {
         using namespace details;
 
-        // 0. activate the SSE so the kernel code compiled under -O2 can actually run, remap the kernel to higher half
+        // 0. activate the SSE so the kernel code compiled under -O2 can actually run, remap the kernel to higher half;
+        //    per cpu data goes first, as interrupts and locks need it
         cpuconfig::activate_legacy_sse();
+        Smp::install_bootstrap_cpu();
         PageTables::map_and_load_kernel_address_space();
 
         // 1. initialize multiboot2 info from the data provided by the boot loader
@@ -394,6 +606,7 @@ namespace phobos {
         time_manager.set_hz(PIT_FREQUENCY_HZ);
         pit.set_channel0_hz(PIT_FREQUENCY_HZ);
         pit.set_channel0_on_tick(handle_timer_tick);
+        apic_timer.set_on_tick(handle_cpu_timer_tick);
         keyboard.set_on_key_press(handle_key_press);
         mouse.set_on_down(handle_mouse_down);
         mouse.set_on_up(handle_mouse_up);
@@ -409,32 +622,37 @@ namespace phobos {
 
         // 8. configure interrupt manager so that it forwards interrupts and exceptions to proper managers
         interrupt_manager.set_exception_handler([] (u8 exc_no, CpuState *cpu) { return exception_manager.on_exception(exc_no, cpu); } );
-        interrupt_manager.set_interrupt_handler([] (u8 int_no, CpuState *cpu) { return driver_manager.on_interrupt(int_no, cpu); } );
+        interrupt_manager.set_interrupt_handler([] (u8 int_no, CpuState *cpu) { cpu = driver_manager.on_interrupt(int_no, cpu); arm_cpu_timer(); return cpu; } );
         interrupt_manager.config_and_activate_exceptions_and_interrupts(); // on-page-fault allocation available from here, as page_fault handler installed and activated
         printer.println("  installing interrupts...done");
 
         // 9. configure dynamic memory management
-        MemoryManager::install_allocation_policy<WyoosAllocationPolicy>(Multiboot2::get_available_memory_first_byte(), Multiboot2::get_available_memory_last_byte());
+        MemoryManager::install_allocation_policy<SlabAllocationPolicy>(Multiboot2::get_available_memory_map());
         printer.println("  installing dynamic memory...done");
 
-        // 10. configure and activate system calls through "syscall" instruction
+        // 10. boot application cpus; they wait till the kernel is booted
+        setup_smp();
+        printer.println("  installing application cpus...done");
+
+        // 11. configure and activate system calls through "syscall" instruction
         syscall_manager.config_and_activate_syscalls();
         printer.println("  installing system calls...done");
 
-        // 11. install filesystems
+        // 12. install filesystems
         setup_filesystem();
         printer.println("  installing virtual file system...done");
 
-        // 12. setup inter process communication before multitasking starts
+        // 13. setup inter process communication before multitasking starts
         setup_ipc();
 
-        // 13. start multitasking
+        // 14. start multitasking on all the cpus
         setup_multitasking();
     	printer.println("  installing multitasking...done");
     	task_manager.add_task(TaskFactory::make_kernel_task(init_task, "init"));
+    	Smp::release_application_cpus();
     	Task::idle();
 
-        // 14. we nerver get past Task::idle()
+        // 15. we nerver get past Task::idle()
         __builtin_unreachable();
     }
 
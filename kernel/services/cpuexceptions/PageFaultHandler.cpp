@@ -24,7 +24,8 @@ const char* PageFaultHandler::PF_REASON[] = {
         "INSTRUCTION_FETCH",
         "STACK_OVERFLOW",
         "PROTECTION_VIOLATION",
-        "INVALID_ADDRESS_SPACE"
+        "INVALID_ADDRESS_SPACE",
+        "COPY_ON_WRITE"
 };
 
 s16 PageFaultHandler::handled_exception_no() {
@@ -34,13 +35,25 @@ s16 PageFaultHandler::handled_exception_no() {
 /**
  * @brief   Handle page fault by either:
  *          - allocating the page if fault caused by page non present
+ *          - copying the page if fault caused by write to copy-on-write page
  *          - logging proper information and killing the task if fault caused by protection violation or memory exhaustion
  */
 CpuState* PageFaultHandler::on_exception(CpuState* cpu_state) {
-    u64 pml4_phys_addr = cpu_state->cr3;
+    u64 pml4_phys_addr = cpu_state->cr3 & ~4095;   // lower bits hold PCID
     u64 faulty_address = get_faulty_address();
     PageFaultActualReason pf_reason = requests->get_page_fault_reason(faulty_address, pml4_phys_addr, cpu_state->error_code);
 
+    // check if PageFault caused by write to a page shared with cloned address space
+    if (pf_reason == PageFaultActualReason::COPY_ON_WRITE) {
+        if (!requests->copy_on_write(faulty_address, pml4_phys_addr)) {
+            requests->log(" [PAGE FAULT at % (%MB, %GB) by \"%\". Could not copy frame. KILLING] \n",
+                        faulty_address, faulty_address /1024 / 1024, faulty_address /1024 / 1024 / 1024, requests->get_current_task_name().c_str());
+            return requests->kill_current_task_group();
+        }
+
+        return cpu_state;
+    }
+
     // check if PageFault caused by Page Non Present
     if (pf_reason != PageFaultActualReason::PAGE_NOT_PRESENT) {
         requests->log(" [PAGE FAULT at % (%MB, %GB) by \"%\". %. KILLING] \n",
@@ -24,12 +24,18 @@ class Requests {
 public: // Boilerplate
 	virtual ~Requests() = default;
 	template<typename ... Args>
-	void log(const cstd::string& fmt, Args ... args) { log(cstd::StringUtils::format(fmt, args...)); }
+	void log(const char* fmt, const Args& ... args) {
+		char line[256];	// longer lines get cut off; formatting into the stack keeps logging allocation free
+		cstd::StringUtils::format_to(line, sizeof(line), fmt, args...);
+		log(line);
+	}
+	void log(const cstd::string& s) { log(s.c_str()); }
 
 public: // Actual methods to implement
-	virtual void log(const cstd::string& s) = 0;
+	virtual void log(const char* s) = 0;
 	virtual hardware::PageFaultActualReason get_page_fault_reason(u64 faulty_address, u64 pml4_phys_addr, u64 cpu_error_code) = 0;
 	virtual bool alloc_missing_page(u64 virtual_address, u64 pml4_phys_addr) = 0;
+	virtual bool copy_on_write(u64 virtual_address, u64 pml4_phys_addr) = 0;
 	virtual cstd::string& get_current_task_name() = 0;
 	virtual bool is_current_task_userspace_task() = 0;
 	virtual hardware::CpuState* kill_current_task_group() = 0;
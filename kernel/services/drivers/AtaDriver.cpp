@@ -5,6 +5,7 @@
  * @author: Mateusz Midor
  */
 
+#include "cstd.h"
 #include "AtaDriver.h"
 #include "Requests.h"
 
@@ -55,9 +56,14 @@ bool AtaDevice::is_present() const {
     return true;
 }
 
+/**
+ * @brief   Read "count" bytes from the beginning of "sector"
+ * @note    Sector is read into a kernel buffer first, so the transfer is not interrupted by page fault on user "data"
+ *          (page fault may swap pages in and out using this very device)
+ */
 bool AtaDevice::read28(u32 sector, void* data, u32 count) const {
     const u32 SECTOR_LIMIT = 1 << 28;
-    u8* dst = (u8*)data;
+    u8 sector_data[BYTES_PER_SECTOR];
 
     if (sector >= SECTOR_LIMIT) {
         requests->log("AtaDevice::read28: Cant read from sector that far: % >= %\n", sector, SECTOR_LIMIT);
@@ -82,24 +88,24 @@ bool AtaDevice::read28(u32 sector, void* data, u32 count) const {
     // wait for the data to be ready
     u8 status = poll_ata_device();
 
-    // read data from sector
-    for (u16 i = 0; i < count; i += 2) {
+    // read data from sector, we always need to read entire sector
+    for (u16 i = 0; i < BYTES_PER_SECTOR; i += 2) {
         u16 data_chunk = data_port.read();
-        dst[i] = data_chunk & 0xFF;
-        if (i + 1 < count)
-            dst[i + 1] = data_chunk >> 8;
+        sector_data[i] = data_chunk & 0xFF;
+        sector_data[i + 1] = data_chunk >> 8;
     }
 
-    // read rest of the sector, we always need to read entire sector
-    for (u16 i = count + (count % 2); i < BYTES_PER_SECTOR; i += 2)
-        data_port.read();
-
+    memcpy(data, sector_data, count);
     return true;
 }
 
+/**
+ * @brief   Write "count" bytes to the beginning of "sector"; rest of the sector is filled with zeros
+ * @note    Data is copied into a kernel buffer first, so the transfer is not interrupted by page fault on user "data"
+ */
 bool AtaDevice::write28(u32 sector, void const* data, u32 count) const {
     const u32 SECTOR_LIMIT = 1 << 28;
-    u8 const* dst = (u8*)data;
+    u8 sector_data[BYTES_PER_SECTOR];
 
     if (sector >= SECTOR_LIMIT) {
         requests->log("AtaDevice::write28: Cant write to sector that far: % >= %\n", sector, SECTOR_LIMIT);
@@ -107,10 +113,14 @@ bool AtaDevice::write28(u32 sector, void const* data, u32 count) const {
     }
 
     if (count > BYTES_PER_SECTOR) {
-        requests->log("AtaDevice::write28: Cant write across % bytes sectors: sector %, count %\n", BYTES_PER_SECTOR, sector, count);
+        requests->log("AtaDevice::write28: Cant write across 512 bytes sectors: sector %, count %\n", sector, count);
         return false;
     }
 
+    // fill up rest of the sector with blanks, we always need to write entire sector
+    memcpy(sector_data, data, count);
+    memset(sector_data + count, 0, BYTES_PER_SECTOR - count);
+
     // select the device
     device_port.write((is_master ? 0xE0 : 0xF0) | ((sector & 0x0F000000) >> 24));
     error_port.write(0);
@@ -122,18 +132,8 @@ bool AtaDevice::write28(u32 sector, void const* data, u32 count) const {
     cmd_status_port.write(CMD_WRITE_SECTORS); // write
 
     // write data to sector
-    for (u16 i = 0; i < count; i += 2) {
-        u16 data_chunk = dst[i];
-        if (i + 1 < count)
-            data_chunk |= dst[i+1] << 8;
-
-        data_port.write(data_chunk);
-    }
-
-    // fill up rest of the sector with blanks, we always need to write entire sector
-    for (u16 i = count + (count % 2); i < BYTES_PER_SECTOR; i += 2)
-        data_port.write(0x0000);
-
+    for (u16 i = 0; i < BYTES_PER_SECTOR; i += 2)
+        data_port.write(sector_data[i] | (sector_data[i + 1] << 8));
 
     return flush_cache();
 }
@@ -0,0 +1,62 @@
+/**
+ *   @file: LocalApicTimerDriver.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "LocalApicTimerDriver.h"
+#include "LocalApic.h"
+
+using namespace hardware;
+
+namespace drivers {
+
+LocalApicTimerDriver::LocalApicTimerDriver() {
+    for (u64& deadline : armed_deadlines)
+        deadline = NO_DEADLINE;
+}
+
+s16 LocalApicTimerDriver::handled_interrupt_no() {
+    return Interrupts::LocalApicTimer;
+}
+
+/**
+ * @brief   Timer fired or other cpu asked this one to look for work; either way the cpu has no deadline armed anymore
+ */
+hardware::CpuState* LocalApicTimerDriver::on_interrupt(hardware::CpuState* cpu_state) {
+    armed_deadlines[PerCpu::current().index] = NO_DEADLINE;
+    return on_tick(cpu_state);
+}
+
+void LocalApicTimerDriver::set_on_tick(const OnTickEvent &event) {
+    on_tick = event;
+}
+
+/**
+ * @brief   Make the timer of current cpu fire at uptime "deadline_us", NO_DEADLINE means no need to fire.
+ *          Deadline later than the one already armed is left for the timer interrupt to rearm; it is just an early wakeup,
+ *          and programming the timer is costly under virtualization
+ * @note    LocalApic timer must be calibrated first, see LocalApic::set_timer_ticks_per_ms
+ */
+void LocalApicTimerDriver::set_deadline(u64 now_us, u64 deadline_us) {
+    constexpr u64 MAX_COUNT {0xFFFFFFFF};
+
+    u64& armed_deadline = armed_deadlines[PerCpu::current().index];
+    if (deadline_us >= armed_deadline)
+        return;
+
+    armed_deadline = deadline_us;
+    const u64 wait_us = deadline_us > now_us ? deadline_us - now_us : 0;
+    const u64 count = wait_us * LocalApic::get_timer_ticks_per_ms() / 1000 + 1;   // count of 0 would stop the timer
+    LocalApic::start_timer_oneshot(count > MAX_COUNT ? MAX_COUNT : count, Interrupts::LocalApicTimer); // too far deadline just gets rearmed
+}
+
+/**
+ * @brief   Raise the timer interrupt on "cpu" now, eg. so idle cpu picks the task that just became runnable
+ */
+void LocalApicTimerDriver::fire_on_cpu(u32 cpu) {
+    LocalApic::send_to(PerCpu::get(cpu).apic_id, Interrupts::LocalApicTimer);
+}
+
+} /* namespace drivers */
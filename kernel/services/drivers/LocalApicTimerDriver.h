@@ -0,0 +1,40 @@
+/**
+ *   @file: LocalApicTimerDriver.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_DRIVERS_LOCALAPICTIMERDRIVER_H_
+#define KERNEL_SERVICES_DRIVERS_LOCALAPICTIMERDRIVER_H_
+
+#include "PitDriver.h"
+#include "PerCpu.h"
+
+namespace drivers {
+
+/**
+ * @brief   This is a driver for the Local APIC timer; every cpu runs its own one in one-shot mode,
+ *          programmed for the nearest deadline the cpu has, so there are no interrupts when there is nothing to do
+ */
+class LocalApicTimerDriver: public DeviceDriver {
+public:
+    static constexpr u64 NO_DEADLINE {0xFFFFFFFFFFFFFFFF};
+
+    LocalApicTimerDriver();
+    static s16 handled_interrupt_no();
+    hardware::CpuState* on_interrupt(hardware::CpuState* cpu_state) override;
+    void set_on_tick(const OnTickEvent &event);
+    void set_deadline(u64 now_us, u64 deadline_us);
+    void fire_on_cpu(u32 cpu);
+
+private:
+    static constexpr u32 MAX_CPUS   {hardware::PerCpu::MAX_CPUS};
+
+    OnTickEvent on_tick = [](hardware::CpuState* cpu_state) { return cpu_state; };
+    u64         armed_deadlines[MAX_CPUS];  // per cpu; interrupt is due at this uptime
+};
+
+} /* namespace drivers */
+
+#endif /* KERNEL_SERVICES_DRIVERS_LOCALAPICTIMERDRIVER_H_ */
@@ -64,6 +64,9 @@ void PitDriver::set_channel2_count(u32 count) {
  * @rbrief  Get PIT channel2 current countdown counter value
  */
 u16 PitDriver::get_channel2_count() const {
+    const u8 LATCH = 0x80;  // channel 2 + counter latch, so the low and high byte come from the same count
+
+    pit_cmd.write(LATCH);
     u8 lo = pit_channel_2.read();
     u8 hi = pit_channel_2.read();
     return (hi << 8) + lo;
@@ -117,6 +117,14 @@ void VgaDriver::flush_video_buffer(const EgaColor64* buff) {
     memcpy(framebuffer_segment, buff, screen_width() * screen_height() * sizeof(EgaColor64));
 }
 
+/**
+ * @brief   Get video memory that makes the screen in graphics mode
+ * @return  nullptr if not in graphics mode
+ */
+u8* VgaDriver::get_video_buffer() const {
+    return framebuffer_segment_copy ? framebuffer_segment : nullptr;
+}
+
 /**
  * @ref http://wiki.osdev.org/Text_Mode_Cursor#Source_in_C_2
  */
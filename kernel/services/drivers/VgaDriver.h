@@ -36,6 +36,7 @@ public:
     void set_graphics_mode_320_200_256();
     void put_pixel(u16 x, u16 y, middlespace::EgaColor64 color_index) const;
     void flush_video_buffer(const middlespace::EgaColor64* buff);
+    u8* get_video_buffer() const;
 
 private:
     void write_registers(u8* registers) const;
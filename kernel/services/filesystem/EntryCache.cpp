@@ -26,7 +26,7 @@ VfsCachedEntryPtr EntryCache::allocate(const VfsEntryPtr& e, const UnixPath& pat
  */
 bool EntryCache::deallocate(const VfsCachedEntryPtr& e) {
     const auto found = path_to_entry.find_by_val(e);
-    if (found == path_to_entry.cend())
+    if (found == path_to_entry.end())
         return false;
 
     path_to_entry.erase(found);
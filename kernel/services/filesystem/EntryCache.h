@@ -8,7 +8,7 @@
 #ifndef KERNEL_SERVICES_FILESYSTEM_ENTRYCACHE_H_
 #define KERNEL_SERVICES_FILESYSTEM_ENTRYCACHE_H_
 
-#include "Map.h"
+#include "HashMap.h"
 #include "VfsCachedEntry.h"
 
 namespace filesystem {
@@ -26,7 +26,7 @@ public:
     VfsCachedEntryPtr find(const UnixPath& path) const;
 
 private:
-    cstd::Map<UnixPath, VfsCachedEntryPtr>   path_to_entry;
+    cstd::HashMap<UnixPath, VfsCachedEntryPtr>   path_to_entry;
 };
 
 } /* namespace filesystem */
@@ -22,10 +22,15 @@ class Requests {
 public: // Boilerplate
 	virtual ~Requests() = default;
 	template<typename ... Args>
-	void log(const cstd::string& fmt, Args ... args) { log(cstd::StringUtils::format(fmt, args...)); }
+	void log(const char* fmt, const Args& ... args) {
+		char line[256];	// longer lines get cut off; formatting into the stack keeps logging allocation free
+		cstd::StringUtils::format_to(line, sizeof(line), fmt, args...);
+		log(line);
+	}
+	void log(const cstd::string& s) { log(s.c_str()); }
 
 public: // Actual methods to implement
-	virtual void log(const cstd::string& s) = 0;
+	virtual void log(const char* s) = 0;
 };
 
 /**
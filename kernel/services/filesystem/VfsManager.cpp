@@ -11,6 +11,7 @@
 
 using namespace utils;
 using namespace middlespace;
+using namespace multitasking;
 
 namespace filesystem {
 
@@ -24,10 +25,16 @@ VfsManager& VfsManager::instance() {
  * @brief   Install vfs root "/" directory
  */
 void VfsManager::install() {
+    WriteLockGuard guard(lock);
     tree.install();
 }
 
+/**
+ * @note    Lookup brings the entry to the cache, so it takes the lock for writing
+ */
 utils::SyscallResult<OpenEntryPtr> VfsManager::open(const UnixPath& path) {
+    WriteLockGuard guard(lock);
+
     auto entry = tree.get_or_bring_entry_to_cache(path);
     if (!entry)
         return {ErrorCode::EC_NOENT};
@@ -38,33 +45,47 @@ utils::SyscallResult<OpenEntryPtr> VfsManager::open(const UnixPath& path) {
 
     auto state = open_result.value;
 
-    const auto on_destroy = rtg::run_this_guy(&VfsTree::release_cached, tree);
+    const auto on_destroy = rtg::run_this_guy(&VfsManager::release_cached, *this);
 
     return {cstd::make_shared<VfsOpenEntry>(entry, state, on_destroy)};
 }
 
 utils::SyscallResult<void> VfsManager::attach(const UnixPath& path, const VfsEntryPtr& entry) {
+    WriteLockGuard guard(lock);
     return tree.attach(entry, path);
 }
 
 utils::SyscallResult<UnixPath> VfsManager::create(const UnixPath& path, bool is_directory) {
+    WriteLockGuard guard(lock);
     return tree.create(path, is_directory);
 }
 
 utils::SyscallResult<void> VfsManager::remove(const UnixPath& path) {
+    WriteLockGuard guard(lock);
     return tree.remove(path);
 }
 
 utils::SyscallResult<void> VfsManager::copy(const UnixPath& path_from, const UnixPath& path_to) {
+    WriteLockGuard guard(lock);
     return tree.copy(path_from, path_to);
 }
 
 utils::SyscallResult<void> VfsManager::move(const UnixPath& path_from, const UnixPath& path_to) {
+    WriteLockGuard guard(lock);
     return tree.move(path_from, path_to);
 }
 
 bool VfsManager::exists(const UnixPath& path) const {
+    ReadLockGuard guard(lock);
     return tree.exists(path);
 }
 
+/**
+ * @brief   Drop the entry from the cache when its last VfsOpenEntry is gone
+ */
+bool VfsManager::release_cached(const VfsCachedEntryPtr& e) {
+    WriteLockGuard guard(lock);
+    return tree.release_cached(e);
+}
+
 } /* namespace filesystem */
@@ -10,11 +10,13 @@
 
 #include "VfsTree.h"
 #include "OpenEntry.h"
+#include "RwSpinLock.h"
 
 namespace filesystem {
 
 /**
  * @brief   This class provides and interface to the Virtual File System.
+ * @note    The tree and entry cache are guarded by a reader-writer lock; reading and writing an open entry is not
  */
 class VfsManager {
 public:
@@ -32,8 +34,11 @@ public:
     bool exists(const UnixPath& path) const;
 
 private:
-    static VfsManager   _instance;
-    VfsTree             tree;
+    bool release_cached(const VfsCachedEntryPtr& e);
+
+    static VfsManager               _instance;
+    VfsTree                         tree;
+    mutable multitasking::RwSpinLock lock   {"vfs"};
 };
 
 } /* namespace filesystem */
@@ -109,6 +109,37 @@ CpuMultimediaExtensions CpuInfo::get_multimedia_extensions() const {
     return ext;
 }
 
+/**
+ * @brief   Check if Process-Context Identifiers are supported, so TLB entries can be tagged with address space id
+ */
+bool CpuInfo::has_pcid() const {
+    int cpuinfo[4];
+    __cpuid(cpuinfo, 1);
+    return cpuinfo[2] & (1 << 17);
+}
+
+/**
+ * @brief   Check if Enhanced REP MOVSB/STOSB is supported, so "rep movsb" is the fastest way to copy big memory blocks
+ */
+bool CpuInfo::has_erms() const {
+    int cpuinfo[4];
+    __cpuid(cpuinfo, 0);
+    if (cpuinfo[0] < 7)
+        return false;
+
+    __cpuid(cpuinfo, 7);
+    return cpuinfo[1] & (1 << 9);
+}
+
+/**
+ * @brief   Check if the cpu has on-chip Local APIC, needed for starting other cpus and for interrupts between cpus
+ */
+bool CpuInfo::has_apic() const {
+    int cpuinfo[4];
+    __cpuid(cpuinfo, 1);
+    return cpuinfo[3] & (1 << 9);
+}
+
 /**
  * @see     https://gist.github.com/hi2p-perim/7855506
  */
@@ -118,7 +149,7 @@ void CpuInfo::__cpuid(int* cpuinfo, int info) const {
         "cpuid;"
         "xchg %%ebx, %%edi;"
         :"=a" (cpuinfo[0]), "=D" (cpuinfo[1]), "=c" (cpuinfo[2]), "=d" (cpuinfo[3])
-        :"0" (info)
+        :"0" (info), "2" (0)    // sub-leaf 0 for the leaves that have sub-leaves, eg. 7
         :"%rbx" // this missing used to cause page fault at 2054MB in lscpu terminal command
     );
 }
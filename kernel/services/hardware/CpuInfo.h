@@ -36,6 +36,9 @@ public:
 	u64 get_rtdsc() const;
     cstd::string get_vendor() const;
     CpuMultimediaExtensions get_multimedia_extensions() const;
+    bool has_pcid() const;
+    bool has_erms() const;
+    bool has_apic() const;
 
 private:
     void __cpuid(int* cpuinfo, int info) const;
@@ -23,28 +23,34 @@ u8 kernel_stack_safe[2*4096] __attribute__ ((aligned (16)));
 
 namespace hardware {
 
-TaskStateSegment64 Gdt::tss;
-std::array<GdtEntry, Gate64::GDT_MAX> Gdt::gdt;
+/**
+ * @brief   Replace current Global Descriptor Table with a new, ready for user-mode, one; for the bootstrap cpu
+ */
+void Gdt::reinstall_gdt() {
+    reinstall_gdt((u64)kernel_stack_top, (u64)kernel_stack_safe + sizeof(kernel_stack_safe));
+}
 
 /**
  * @brief   Replace current Global Descriptor Table with a new, ready for user-mode, one
+ * @param   kernel_stack_top Stack for interrupts that come in user mode
+ * @param   emergency_stack_top Stack for handling Non-maskable Interrupts, Double faults and Machine Checks
  */
-void Gdt::reinstall_gdt() {
-    setup_task_state_segment();
+void Gdt::reinstall_gdt(u64 kernel_stack_top, u64 emergency_stack_top) {
+    setup_task_state_segment(kernel_stack_top, emergency_stack_top);
     setup_global_descriptor_table();
     install_global_descriptor_table();
     install_task_state_segment();
 }
 
-void Gdt::setup_task_state_segment() {
+void Gdt::setup_task_state_segment(u64 kernel_stack_top, u64 emergency_stack_top) {
     // clear entire structure
     memset(&tss, 0, sizeof(tss));
 
     // set normal kernel stack pointer for ring0
-    tss.rsp0 = (u64)kernel_stack_top;
+    tss.rsp0 = kernel_stack_top;
 
     // set emergency kernel stack for handling emergency situation exceptions
-    tss.ist1 = (u64)kernel_stack_safe + sizeof(kernel_stack_safe);
+    tss.ist1 = emergency_stack_top;
 
 
     // set io ports bitmap to deny any port access from rings other than ring0
@@ -105,10 +105,12 @@ struct GdtSizeAddress {
 
 /**
  * @brief   Global Descriptor Table abstraction
+ * @note    Every cpu needs a Gdt of its own, as the TSS it holds has the cpu stacks and gets marked busy when loaded
  */
 class Gdt {
 public:
     void reinstall_gdt();
+    void reinstall_gdt(u64 kernel_stack_top, u64 emergency_stack_top);
     static u64 get_null_segment_selector() { return gate_to_segment_selector(Gate64::GDT_NULL); };
     static u64 get_kernel_code_segment_selector() { return gate_to_segment_selector(Gate64::GDT_KERNEL_CODE); };
     static u64 get_kernel_data_segment_selector() { return gate_to_segment_selector(Gate64::GDT_KERNEL_DATA); };      // GDT_NULL probably can be used here as there is no ds in kernel space long mode
@@ -117,7 +119,7 @@ public:
     static u64 get_tss_segment_selector() { return gate_to_segment_selector(Gate64::GDT_TSS); };
 
 private:
-    void setup_task_state_segment();
+    void setup_task_state_segment(u64 kernel_stack_top, u64 emergency_stack_top);
     void setup_global_descriptor_table();
     void install_global_descriptor_table();
     void install_task_state_segment();
@@ -128,8 +130,8 @@ private:
     static u32 gate_to_segment_selector(Gate64 gate_num) { return gate_num * sizeof(GdtEntry); }
 
 
-    static TaskStateSegment64 tss;
-    static std::array<GdtEntry, Gate64::GDT_MAX> gdt;
+    TaskStateSegment64 tss;
+    std::array<GdtEntry, Gate64::GDT_MAX> gdt;
 };
 
 } /* namespace hardware */
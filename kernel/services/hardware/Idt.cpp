@@ -41,6 +41,10 @@ extern "C" void handle_interrupt_no_0x2E();
 extern "C" void handle_interrupt_no_0x2F();
 extern "C" void handle_interrupt_no_0x80(); // old fashioned syscall "int 0x80", now we use "syscall"
 
+// local APIC interrupts, defined in "interrupts.S"
+extern "C" void handle_interrupt_no_0x30();
+extern "C" void handle_tlb_shootdown();
+
 namespace hardware {
 
 void Idt::reinstall_idt() {
@@ -48,6 +52,13 @@ void Idt::reinstall_idt() {
     install_interrupt_descriptor_table();
 }
 
+/**
+ * @brief   Load the table that is already set up; for application cpus, that share the table with the bootstrap cpu
+ */
+void Idt::install_idt() {
+    install_interrupt_descriptor_table();
+}
+
 /**
  * @brief   Make Interrupt Descriptor Table gate
  * @param   handler_pointer Interrupt handler routine (naked function in asm)
@@ -104,6 +115,8 @@ void Idt::setup_interrupt_descriptor_table() {
     idt[Interrupts::Mouse]          = make_entry((u64) (handle_interrupt_no_0x2C));         // mouse
     idt[Interrupts::PrimaryAta]     = make_entry((u64) (handle_interrupt_no_0x2E));         // primary ata bus
     idt[Interrupts::SecondaryAta]   = make_entry((u64) (handle_interrupt_no_0x2F));         // secondary ata bus
+    idt[Interrupts::LocalApicTimer] = make_entry((u64) (handle_interrupt_no_0x30));         // local apic timer
+    idt[Interrupts::TlbShootdown]   = make_entry((u64) (handle_tlb_shootdown));             // tlb shootdown ipi
     idt[Interrupts::Int80h]         = make_entry((u64) (handle_interrupt_no_0x80), 0, 3);   // "int 0x80"; regular kernel stack, min privilege=user space
 }
 
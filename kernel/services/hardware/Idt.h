@@ -67,6 +67,7 @@ struct IdtSizeAddress {
 class Idt {
 public:
     void reinstall_idt();
+    void install_idt();
 
 private:
     IdtEntry make_entry(u64 handler_pointer, u8 ist_index = 0, u8 min_privilege_level = 0);
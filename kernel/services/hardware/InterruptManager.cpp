@@ -6,6 +6,8 @@
  */
 
 #include "InterruptManager.h"
+#include "LocalApic.h"
+#include "KernelLock.h"
 
 
 namespace hardware {
@@ -35,10 +37,13 @@ void InterruptManager::config_interrupts() {
  * @param   interrupt_no Number of CPU exception/PIC interrupt (offset by IRQ_BASE) being handled
  * @param   cpu_state Pointer to the stack holding current cpu::CpuState struct
  * @return  Pointer to stack pointer holding destination cpu::CpuState struct (for task switching)
+ * @note    The kernel lock taken here is released in interrupts.S, after switching to the returned stack
  */
 hardware::CpuState* InterruptManager::on_interrupt(u8 interrupt_no, hardware::CpuState* cpu_state) {
     hardware::CpuState* new_cpu_state;
 
+    multitasking::KernelLock::lock();
+
     // if its PIC interrupt
     if (interrupt_no >= Interrupts::IRQ_BASE) {
         new_cpu_state = interrupt_handler(interrupt_no, cpu_state);
@@ -52,6 +57,12 @@ hardware::CpuState* InterruptManager::on_interrupt(u8 interrupt_no, hardware::Cp
 }
 
 void InterruptManager::ack_interrupt_handled(u8 interrupt_no) {
+    // local APIC interrupts are confirmed to the local APIC of the cpu
+    if (interrupt_no >= Interrupts::LAPIC_BASE && interrupt_no < Interrupts::LAPIC_MAX) {
+        LocalApic::end_of_interrupt();
+        return;
+    }
+
     // send End Of Interrupt (confirm to PIC that interrupt has been handled)
     if (interrupt_no >= Interrupts::IRQ_BASE + SLAVE_PIC_IRQ_OFFSET)
         pic_slave_cmd.write(0x20);
@@ -63,6 +74,16 @@ void InterruptManager::config_and_activate_exceptions_and_interrupts() {
     asm("sti");
 }
 
+/**
+ * @brief   Make application cpu handle interrupts and exceptions the same way the bootstrap cpu does.
+ *          Interrupts stay disabled; the cpu enables them once it is ready to run tasks
+ * @note    PIC interrupts only go to the bootstrap cpu; application cpus get the local APIC ones
+ */
+void InterruptManager::config_application_cpu_interrupts() {
+    idt.install_idt();
+    LocalApic::enable();
+}
+
 void InterruptManager::set_interrupt_handler(const InterruptHandler &h) {
     interrupt_handler = h;
 }
@@ -123,4 +144,15 @@ void InterruptManager::enable_interrupts(u16 mask) {
     pic_slave_data.write(slave_mask);
 }
 
+/**
+ * @brief   Stop PIC interrupt "interrupt_no" from being raised, eg. because the device is not used anymore
+ */
+void InterruptManager::mask_interrupt(u8 interrupt_no) {
+    const u8 irq = interrupt_no - Interrupts::IRQ_BASE;
+    if (irq >= SLAVE_PIC_IRQ_OFFSET)
+        pic_slave_data.write(pic_slave_data.read() | (1 << (irq - SLAVE_PIC_IRQ_OFFSET)));
+    else
+        pic_master_data.write(pic_master_data.read() | (1 << irq));
+}
+
 } // namespace hardware
@@ -26,6 +26,7 @@ public:
     InterruptManager operator=(InterruptManager&&) = delete;
 
     void config_and_activate_exceptions_and_interrupts();
+    void config_application_cpu_interrupts();
     void set_interrupt_handler(const InterruptHandler &h);
     void set_exception_handler(const ExceptionHandler &h);
 
@@ -33,6 +34,7 @@ public:
 
     u16 disable_interrupts();
     void enable_interrupts(u16 mask);
+    void mask_interrupt(u8 interrupt_no);
 
 private:
     static InterruptManager _instance;
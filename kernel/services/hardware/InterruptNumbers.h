@@ -24,6 +24,12 @@ enum Interrupts : u16 {
     PrimaryAta      = IRQ_BASE + 14,
     SecondaryAta    = IRQ_BASE + 15,
 
+    LAPIC_BASE      = 0x30,             // local APIC interrupts start here, past the PIC ones
+    LocalApicTimer  = LAPIC_BASE + 0,   // scheduling timer of application cpus
+    TlbShootdown    = LAPIC_BASE + 1,   // sent by cpu that changed page tables to the other cpus; handled in interrupts.S
+    LocalApicSpurious = LAPIC_BASE + 15,// lowest 4 bits of spurious vector must be set on older cpus; needs no EOI
+    LAPIC_MAX       = 0x40,
+
     Int80h          = 0x80,             // IRQ_BASE not considered here as int 0x80 is not being called by hw but by the user sofware
     Vga             = 0xFF,             // fake interrupt no; Vga sends no interrupts but it is needed to fit in InterruptManager interface
     IRQ_MAX         = 0x100
@@ -0,0 +1,183 @@
+/**
+ *   @file: LocalApic.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "LocalApic.h"
+#include "CpuInfo.h"
+#include "InterruptNumbers.h"
+
+namespace hardware {
+
+volatile u32*   LocalApic::registers            {nullptr};
+u32             LocalApic::timer_ticks_per_ms   {0};
+
+bool LocalApic::is_present() {
+    return CpuInfo().has_apic();
+}
+
+/**
+ * @brief   Get physical address of the Local APIC registers, from IA32_APIC_BASE MSR
+ */
+u64 LocalApic::get_phys_address() {
+    constexpr u32 IA32_APIC_BASE = 0x1B;
+
+    u32 lo, hi;
+    asm volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(IA32_APIC_BASE));
+    return (((u64)hi << 32) | lo) & 0x000FFFFFFFFFF000;
+}
+
+/**
+ * @brief   Set where the registers got mapped in virtual memory; they must be mapped as uncached
+ */
+void LocalApic::install(u64 registers_virt_address) {
+    registers = (volatile u32*)registers_virt_address;
+}
+
+/**
+ * @brief   Software-enable the Local APIC of current cpu, so it accepts interrupts from other cpus
+ */
+void LocalApic::enable() {
+    constexpr u32 SVR_ENABLE = 0x100;
+
+    write(TPR, 0);  // accept all interrupts
+    write(SVR, SVR_ENABLE | Interrupts::LocalApicSpurious);
+}
+
+u32 LocalApic::get_id() {
+    return read(ID) >> 24;
+}
+
+void LocalApic::end_of_interrupt() {
+    write(EOI, 0);
+}
+
+/**
+ * @brief   Reset cpu "apic_id"; it then waits for Startup IPI
+ */
+void LocalApic::send_init(u32 apic_id) {
+    constexpr u32 INIT_ASSERT = 0x4500;
+
+    send_ipi(apic_id, INIT_ASSERT);
+}
+
+/**
+ * @brief   Make cpu "apic_id" that was reset start real mode execution at physical address "vector" * 4096
+ */
+void LocalApic::send_startup(u32 apic_id, u8 vector) {
+    constexpr u32 STARTUP = 0x4600;
+
+    send_ipi(apic_id, STARTUP | vector);
+}
+
+/**
+ * @brief   Raise interrupt "vector" on all the cpus but the current one
+ */
+void LocalApic::send_to_all_but_self(u8 vector) {
+    constexpr u32 ALL_BUT_SELF = 3 << 18;
+
+    send_ipi(0, ALL_BUT_SELF | vector);
+}
+
+/**
+ * @brief   Raise interrupt "vector" on cpu "apic_id"; can be the current cpu
+ */
+void LocalApic::send_to(u32 apic_id, u8 vector) {
+    constexpr u32 FIXED = 0x4000;   // fixed delivery, level assert
+
+    send_ipi(apic_id, FIXED | vector);
+}
+
+/**
+ * @brief   Start the timer counting down from "count", with no interrupt at the end; for time measurement
+ */
+void LocalApic::start_timer_countdown(u32 count) {
+    constexpr u32 LVT_MASKED = 1 << 16;
+    constexpr u32 DIVIDE_BY_16 = 0x3;
+
+    write(TIMER_DIVIDE, DIVIDE_BY_16);
+    write(LVT_TIMER, LVT_MASKED);
+    write(TIMER_INITIAL, count);
+}
+
+/**
+ * @brief   Start the timer raising interrupt "vector" every "count" ticks
+ */
+void LocalApic::start_timer_periodic(u32 count, u8 vector) {
+    constexpr u32 LVT_PERIODIC = 1 << 17;
+    constexpr u32 DIVIDE_BY_16 = 0x3;
+
+    write(TIMER_DIVIDE, DIVIDE_BY_16);
+    write(LVT_TIMER, LVT_PERIODIC | vector);
+    write(TIMER_INITIAL, count);
+}
+
+/**
+ * @brief   Start the timer raising interrupt "vector" once, after "count" ticks; starting it again restarts the countdown
+ */
+void LocalApic::start_timer_oneshot(u32 count, u8 vector) {
+    constexpr u32 LVT_ONESHOT = 0;
+    constexpr u32 DIVIDE_BY_16 = 0x3;
+
+    write(TIMER_DIVIDE, DIVIDE_BY_16);
+    write(LVT_TIMER, LVT_ONESHOT | vector);
+    write(TIMER_INITIAL, count);
+}
+
+/**
+ * @brief   Stop the timer; it raises no more interrupts till started again
+ */
+void LocalApic::stop_timer() {
+    write(TIMER_INITIAL, 0);
+}
+
+u32 LocalApic::get_timer_count() {
+    return read(TIMER_CURRENT);
+}
+
+/**
+ * @brief   Set timer speed, as measured against other clock; the timer frequency is not known up front
+ */
+void LocalApic::set_timer_ticks_per_ms(u32 ticks) {
+    timer_ticks_per_ms = ticks;
+}
+
+u32 LocalApic::get_timer_ticks_per_ms() {
+    return timer_ticks_per_ms;
+}
+
+/**
+ * @brief   Busy wait "us" microseconds
+ * @note    Uses the timer, so it is only for the time before the timer gets armed for the cpu deadlines
+ */
+void LocalApic::delay_us(u32 us) {
+    const u64 count = (u64)us * timer_ticks_per_ms / 1000 + 1;
+    start_timer_countdown(count > 0xFFFFFFFF ? 0xFFFFFFFF : count);
+    while (get_timer_count() > 0)
+        asm volatile("pause");
+}
+
+u32 LocalApic::read(u32 reg) {
+    return registers[reg / sizeof(u32)];
+}
+
+void LocalApic::write(u32 reg, u32 value) {
+    registers[reg / sizeof(u32)] = value;
+}
+
+void LocalApic::send_ipi(u32 apic_id, u32 command) {
+    write(ICR_HIGH, apic_id << 24);
+    write(ICR_LOW, command);
+    wait_ipi_delivered();
+}
+
+void LocalApic::wait_ipi_delivered() {
+    constexpr u32 DELIVERY_PENDING = 1 << 12;
+
+    while (read(ICR_LOW) & DELIVERY_PENDING)
+        asm volatile("pause");
+}
+
+} /* namespace hardware */
@@ -0,0 +1,66 @@
+/**
+ *   @file: LocalApic.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_HARDWARE_LOCALAPIC_H_
+#define KERNEL_SERVICES_HARDWARE_LOCALAPIC_H_
+
+#include "types.h"
+
+namespace hardware {
+
+/**
+ * @brief   This class drives the Local APIC of the cpu it runs on. Every cpu has its own Local APIC,
+ *          all of them seen at the same physical address. Local APIC sends and receives the interrupts between cpus,
+ *          and has a timer that the cpus use for timekeeping and scheduling
+ * @see     https://www.intel.com/content/dam/www/public/us/en/documents/manuals/64-ia-32-architectures-software-developer-vol-3a-part-1-manual.pdf, 10 Advanced Programmable Interrupt Controller
+ */
+class LocalApic {
+public:
+    static bool is_present();
+    static u64 get_phys_address();
+    static void install(u64 registers_virt_address);
+    static void enable();
+    static u32 get_id();
+    static void end_of_interrupt();
+    static void send_init(u32 apic_id);
+    static void send_startup(u32 apic_id, u8 vector);
+    static void send_to_all_but_self(u8 vector);
+    static void send_to(u32 apic_id, u8 vector);
+    static void start_timer_countdown(u32 count);
+    static void start_timer_periodic(u32 count, u8 vector);
+    static void start_timer_oneshot(u32 count, u8 vector);
+    static void stop_timer();
+    static u32 get_timer_count();
+    static void set_timer_ticks_per_ms(u32 ticks);
+    static u32 get_timer_ticks_per_ms();
+    static void delay_us(u32 us);
+
+private:
+    // register offsets
+    static constexpr u32 ID             {0x020};
+    static constexpr u32 TPR            {0x080};    // task priority
+    static constexpr u32 EOI            {0x0B0};
+    static constexpr u32 SVR            {0x0F0};    // spurious interrupt vector, also software enable bit
+    static constexpr u32 ICR_LOW        {0x300};    // interrupt command; writing the low half sends the interrupt
+    static constexpr u32 ICR_HIGH       {0x310};
+    static constexpr u32 LVT_TIMER      {0x320};
+    static constexpr u32 TIMER_INITIAL  {0x380};
+    static constexpr u32 TIMER_CURRENT  {0x390};
+    static constexpr u32 TIMER_DIVIDE   {0x3E0};
+
+    static u32 read(u32 reg);
+    static void write(u32 reg, u32 value);
+    static void send_ipi(u32 apic_id, u32 command);
+    static void wait_ipi_delivered();
+
+    static volatile u32*    registers;
+    static u32              timer_ticks_per_ms;
+};
+
+} /* namespace hardware */
+
+#endif /* KERNEL_SERVICES_HARDWARE_LOCALAPIC_H_ */
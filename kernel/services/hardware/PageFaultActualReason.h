@@ -11,7 +11,8 @@ enum PageFaultActualReason {
     INSTRUCTION_FETCH,
     STACK_OVERFLOW,
     UNKNOWN_PROTECTION_VIOLATION,
-    INVALID_ADDRESS_SPACE
+    INVALID_ADDRESS_SPACE,
+    COPY_ON_WRITE
 };
 
 }
@@ -0,0 +1,171 @@
+/**
+ *   @file: Smp.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "kstd.h"
+#include "Smp.h"
+#include "LocalApic.h"
+#include "InterruptNumbers.h"
+
+// defined in boot.S
+extern u8 kernel_stack_top[];
+extern size_t KERNEL_VIRTUAL_BASE;
+extern size_t BOOT_PAGE_TABLES;
+
+// defined in ap_trampoline.S
+extern u8 ap_trampoline_start[];
+extern u8 ap_trampoline_data[];
+extern u8 ap_trampoline_end[];
+
+namespace hardware {
+
+Smp::ApplicationCpu Smp::application_cpus[PerCpu::MAX_CPUS];
+volatile bool       Smp::is_booted      {false};
+volatile bool       Smp::is_released    {false};
+
+/**
+ * @brief   This "C" style function is called from interrupts.S when other cpu asks for TLB flush
+ */
+extern "C" void on_tlb_shootdown() {
+    PerCpu::flush_tlb_if_requested();
+    LocalApic::end_of_interrupt();
+}
+
+/**
+ * @brief   Install PerCpu of the bootstrap cpu; must be done before any interrupt or lock is taken
+ */
+void Smp::install_bootstrap_cpu() {
+    PerCpu::install(0, (u64)kernel_stack_top);
+    PerCpu::current().is_online = true;
+}
+
+/**
+ * @brief   Boot application cpus one by one; each of them starts running "entry" on a stack of its own
+ * @param   apic_ids Local APIC ids of all the cpus, including the bootstrap one
+ * @return  Number of cpus that are up, including the bootstrap one
+ * @note    Needs the Local APIC timer calibrated, for the delays. Cpus above PerCpu::MAX_CPUS are left sleeping
+ */
+u32 Smp::boot_application_cpus(const u32* apic_ids, u32 count, ApplicationCpuEntry entry) {
+    const u32 bootstrap_apic_id = LocalApic::get_id();
+    PerCpu::get(0).apic_id = bootstrap_apic_id;
+
+    // trampoline goes to low memory, where the real mode code can run
+    u8* trampoline = (u8*)(AP_TRAMPOLINE_ADDRESS + KERNEL_VIRTUAL_BASE);
+    memcpy(trampoline, ap_trampoline_start, ap_trampoline_end - ap_trampoline_start);
+
+    ApTrampolineData* data = (ApTrampolineData*)(trampoline + (ap_trampoline_data - ap_trampoline_start));
+    data->pml4 = BOOT_PAGE_TABLES;
+    data->entry = (u64)entry;
+
+    u32 cpu_count = 1;
+    for (u32 i = 0; i < count && cpu_count < PerCpu::MAX_CPUS; i++) {
+        if (apic_ids[i] == bootstrap_apic_id)
+            continue;
+
+        data->stack_top = (u64)application_cpus[cpu_count].kernel_stack + KERNEL_STACK_SIZE;
+        data->cpu_index = cpu_count;
+        PerCpu::get(cpu_count).apic_id = apic_ids[i];
+        if (!boot_application_cpu(apic_ids[i]))
+            continue;
+
+        cpu_count++;
+        PerCpu::set_count(cpu_count);
+    }
+
+    return cpu_count;
+}
+
+/**
+ * @brief   Send INIT-SIPI-SIPI sequence to cpu "apic_id" and wait until it reports being booted
+ * @return  True if the cpu is booted
+ */
+bool Smp::boot_application_cpu(u32 apic_id) {
+    constexpr u32 INIT_DELAY_US = 10000;
+    constexpr u32 BOOT_TIMEOUT_US = 100000;
+    constexpr u32 POLL_PERIOD_US = 100;
+
+    is_booted = false;
+    LocalApic::send_init(apic_id);
+    LocalApic::delay_us(INIT_DELAY_US);
+
+    // second Startup IPI is only needed if the first one got lost
+    for (u32 attempt = 0; attempt < 2; attempt++) {
+        LocalApic::send_startup(apic_id, AP_TRAMPOLINE_ADDRESS / 4096);
+        for (u32 us = 0; us < BOOT_TIMEOUT_US && !is_booted; us += POLL_PERIOD_US)
+            LocalApic::delay_us(POLL_PERIOD_US);
+
+        if (is_booted)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief   Give application cpu "cpu_index" its PerCpu, and Gdt with its own stacks; run by the cpu itself
+ */
+void Smp::install_application_cpu(u32 cpu_index) {
+    ApplicationCpu& cpu = application_cpus[cpu_index];
+    const u64 kernel_stack_top = (u64)cpu.kernel_stack + KERNEL_STACK_SIZE;
+    const u64 emergency_stack_top = (u64)cpu.emergency_stack + EMERGENCY_STACK_SIZE;
+
+    PerCpu::install(cpu_index, kernel_stack_top);
+    cpu.gdt.reinstall_gdt(kernel_stack_top, emergency_stack_top);
+}
+
+/**
+ * @brief   Report the application cpu booted and wait till the bootstrap cpu is done booting the kernel; run by the cpu itself.
+ *          Kernel page tables may have changed in the meantime, so the TLB is flushed on going online
+ */
+void Smp::wait_for_release() {
+    is_booted = true;
+    while (!is_released)
+        asm volatile("pause");
+
+    // online first, so the page tables changes made from now on get shot down here as well
+    PerCpu& cpu = PerCpu::current();
+    cpu.is_online = true;
+    cpu.tlb_flush_requested = true;
+    PerCpu::flush_tlb_if_requested();
+}
+
+/**
+ * @brief   Let the application cpus run tasks
+ */
+void Smp::release_application_cpus() {
+    is_released = true;
+}
+
+/**
+ * @brief   Make the other online cpus drop their TLB entries, after the current cpu changed the page tables.
+ *          Returns when all of them are done
+ * @note    Waiting cpu serves the requests from other cpus meanwhile, so two cpus shooting down at once dont deadlock
+ */
+void Smp::shootdown_tlb() {
+    const u32 current_cpu = PerCpu::current().index;
+    bool is_requested = false;
+
+    for (u32 i = 0; i < PerCpu::count(); i++) {
+        PerCpu& cpu = PerCpu::get(i);
+        if (i == current_cpu || !cpu.is_online)
+            continue;
+
+        __atomic_store_n(&cpu.tlb_flush_requested, true, __ATOMIC_RELEASE);
+        is_requested = true;
+    }
+
+    if (!is_requested)
+        return;
+
+    LocalApic::send_to_all_but_self(Interrupts::TlbShootdown);
+    for (u32 i = 0; i < PerCpu::count(); i++)
+        while (i != current_cpu && PerCpu::get(i).tlb_flush_requested) {
+            PerCpu::flush_tlb_if_requested();
+            asm volatile("pause");
+        }
+}
+
+} /* namespace hardware */
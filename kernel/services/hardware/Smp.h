@@ -0,0 +1,63 @@
+/**
+ *   @file: Smp.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_HARDWARE_SMP_H_
+#define KERNEL_SERVICES_HARDWARE_SMP_H_
+
+#include "Gdt.h"
+#include "PerCpu.h"
+
+namespace hardware {
+
+using ApplicationCpuEntry = void (*)(u64 cpu_index);
+
+/**
+ * @brief   This class brings up the application cpus (all the cpus but the bootstrap one) and keeps their TLBs coherent.
+ *          Application cpus are booted one by one through ap_trampoline.S, get their own stacks, Gdt and PerCpu,
+ *          and wait till the bootstrap cpu finishes booting the kernel.
+ * @see     https://www.intel.com/content/dam/www/public/us/en/documents/manuals/64-ia-32-architectures-software-developer-vol-3a-part-1-manual.pdf, 8.4 Multiple-Processor (MP) Initialization
+ */
+class Smp {
+public:
+    static void install_bootstrap_cpu();
+    static u32 boot_application_cpus(const u32* apic_ids, u32 count, ApplicationCpuEntry entry);
+    static void install_application_cpu(u32 cpu_index);
+    static void wait_for_release();
+    static void release_application_cpus();
+    static void shootdown_tlb();
+
+private:
+    static constexpr u64    AP_TRAMPOLINE_ADDRESS   {0x8000};       // Startup IPI vector 0x08; must match ap_trampoline.S
+    static constexpr size_t KERNEL_STACK_SIZE       {4 * 4096};     // same as the bootstrap cpu one in boot.S
+    static constexpr size_t EMERGENCY_STACK_SIZE    {2 * 4096};
+
+    /**
+     * @brief   Layout of "ap_trampoline_data" in ap_trampoline.S
+     */
+    struct ApTrampolineData {
+        u64 pml4;
+        u64 stack_top;
+        u64 entry;
+        u64 cpu_index;
+    };
+
+    struct ApplicationCpu {
+        Gdt gdt;
+        u8  kernel_stack[KERNEL_STACK_SIZE]         __attribute__ ((aligned (16)));
+        u8  emergency_stack[EMERGENCY_STACK_SIZE]   __attribute__ ((aligned (16)));
+    };
+
+    static bool boot_application_cpu(u32 apic_id);
+
+    static ApplicationCpu   application_cpus[PerCpu::MAX_CPUS];     // entry 0 is not used, bootstrap cpu has its stacks in boot.S
+    static volatile bool    is_booted;                              // set by just booted application cpu
+    static volatile bool    is_released;                            // set by bootstrap cpu when kernel is ready to run tasks
+};
+
+} /* namespace hardware */
+
+#endif /* KERNEL_SERVICES_HARDWARE_SMP_H_ */
@@ -18,11 +18,47 @@ KernelLog& KernelLog::instance() {
     return _instance;
 }
 
-const cstd::string& KernelLog::get_text() const {
-    return log_str;
+size_t KernelLog::get_length() const {
+    return log_length;
+}
+
+/**
+ * @brief   Copy the last "count" chars of the log into "data"
+ * @return  Num of copied chars
+ */
+size_t KernelLog::read_last(char* data, size_t count) const {
+    if (count > log_length)
+        count = log_length;
+
+    size_t first = (log_start + log_length - count) % LOG_SIZE;
+    size_t head_count = min(count, LOG_SIZE - first);
+    memcpy(data, log_buff + first, head_count);
+    memcpy(data + head_count, log_buff, count - head_count);
+    return count;
 }
 
 void KernelLog::clear() {
-    log_str.clear();
+    log_start = 0;
+    log_length = 0;
 }
+
+void KernelLog::put(const char* s, size_t count) {
+    // only the last LOG_SIZE chars would survive anyway
+    if (count > LOG_SIZE) {
+        s += count - LOG_SIZE;
+        count = LOG_SIZE;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        put(s[i]);
+}
+
+void KernelLog::put(char c) {
+    log_buff[(log_start + log_length) % LOG_SIZE] = c;
+    if (log_length < LOG_SIZE)
+        log_length++;
+    else
+        log_start = (log_start + 1) % LOG_SIZE;
+}
+
 } // namespace logging
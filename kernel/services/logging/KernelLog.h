@@ -8,6 +8,7 @@
 #ifndef SRC_KERNELLOG_H_
 #define SRC_KERNELLOG_H_
 
+#include "cstd.h"
 #include "StringUtils.h"
 
 namespace logging {
@@ -15,26 +16,40 @@ namespace logging {
 class KernelLog {
 public:
     static KernelLog& instance();
-    const cstd::string& get_text() const;
+    size_t get_length() const;
+    size_t read_last(char* data, size_t count) const;
     void clear();
 
     /**
      * @name    format
+     * @brief   Format straight into the log, no memory is allocated on the way
      * @example format("CPU: %", cpu_vendor_cstr);
      */
     template<typename ... Args>
-    void format(const cstd::string& fmt, Args ... args) {
-        log_str += cstd::StringUtils::format(fmt, args...);
+    void format(const char* fmt, const Args& ... args) {
+        cstd::StringUtils::format_into(*this, fmt, args...);
     }
 
     void put(const cstd::string& s) {
-    	log_str += s;
+        put(s.data(), s.length());
     }
 
+    void put(const char* s) {
+        put(s, strlen(s));
+    }
+
+    void put(const char* s, size_t count);
+    void put(char c);
+
 private:
+    static constexpr size_t LOG_SIZE    {16 * 1024};    // when the log is full, the oldest text is overwritten
+
     KernelLog();
     static KernelLog _instance;
-    cstd::string log_str;
+
+    char    log_buff[LOG_SIZE];
+    size_t  log_start   {0};    // oldest char in "log_buff"
+    size_t  log_length  {0};
 };
 
 } // namespace logging
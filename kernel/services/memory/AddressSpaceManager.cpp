@@ -7,10 +7,15 @@
 
 #include "AddressSpaceManager.h"
 #include "MemoryManager.h"
+#include "HigherHalf.h"
+#include "Swap.h"
 
 using namespace middlespace;
 namespace memory {
 
+static size_t recycled_stacks_count {0};    // stacks reused from "free_stacks"
+static size_t released_stacks_count {0};    // stacks put on "free_stacks"
+
 /**
  * @brief	Allocate and prepare an address space for new task group
  */
@@ -20,11 +25,120 @@ utils::SyscallResult<AddressSpace> alloc_address_space(u64 heap_low_limit, u64 h
 	if (pml4_phys_addr == 0)
 		return {ErrorCode::EC_NOMEM};
 
-    // create address space mapping for new task group
+    // create address space mapping for new task group, its pages can be swapped out
     PageTables::map_elf_address_space(pml4_phys_addr);
+    Swap::register_address_space(pml4_phys_addr);
 
     // return a ready to use address space
-    return {{heap_low_limit, heap_high_limit, pml4_phys_addr}};
+    return {{heap_low_limit, heap_high_limit, pml4_phys_addr, heap_low_limit, PageTables::alloc_pcid()}};
+}
+
+/**
+ * @brief   Make "page" entry of source address space copy-on-write, so none of its threads can write the frame once it gets shared
+ * @note    Read-only page stays read-only, writing to it is an error in both address spaces; shared memory and device page stay as they are
+ */
+static void write_protect_page(u64& page) {
+    if ((page & PageAttr::PRESENT) != PageAttr::PRESENT || (page & (PageAttr::DEVICE_MEMORY | PageAttr::SHARED_MEMORY)))
+        return;
+
+    if (page & PageAttr::WRITABLE)
+        page = (page & ~(u64)PageAttr::WRITABLE) | PageAttr::COPY_ON_WRITE;
+}
+
+/**
+ * @brief   Make "page" entries of 0..1GB of virtual memory copy-on-write, see write_protect_page
+ */
+static void write_protect_address_space(u64* pde) {
+    for (u32 i = 0; i < 512; i++) {  // scan 512 * 2MB regions
+        if ((pde[i] & PageAttr::PRESENT) != PageAttr::PRESENT || (pde[i] & PageAttr::HUGE_PAGE)) {
+            write_protect_page(pde[i]);
+            continue;
+        }
+
+        PageTable4K* pt = (PageTable4K*)HigherHalf::phys_to_virt(pde[i] & PageTables::FRAME_ADDRESS_MASK);
+        for (u32 j = 0; j < 512; j++)
+            write_protect_page(pt->pte[j]);
+    }
+}
+
+/**
+ * @brief   Share "page" entry of write protected source address space and return same entry for its clone
+ * @note    Non present entries (eg. stack guard pages) are cloned as they are; swapped out page swap slot gets shared
+ */
+static bool share_page(const u64& page) {
+    if (Swap::is_swapped_out(page))
+        return Swap::share_slot(page);  // each address space swaps in its own copy
+
+    if ((page & PageAttr::PRESENT) != PageAttr::PRESENT || (page & PageAttr::DEVICE_MEMORY))
+        return true;    // device memory page is shared as it is
+
+    return MemoryManager::instance().share_frames((void*)(page & PageTables::FRAME_ADDRESS_MASK));
+}
+
+/**
+ * @brief   Clone "src" address space for new task group. Page tables are copied, memory frames are shared:
+ *          both address spaces get the frames mapped read-only and the first one to write to a frame gets its own copy.
+ *          "src" is write protected and its TLB entries shot down on all cpus before any frame gets shared,
+ *          so other threads of the task group cant write a shared frame through a stale writable TLB entry
+ * @note    "src" must be the current address space, as its TLB entries get flushed
+ * @note    Execution context: Task only
+ */
+utils::SyscallResult<AddressSpace> clone_address_space(AddressSpace& src) {
+    auto result = alloc_address_space(src.heap_low_limit, src.heap_high_limit);
+    if (!result)
+        return result;
+
+    AddressSpace& dst = result.value;
+    dst.heap_start = src.heap_start;
+    dst.memory_areas = src.memory_areas;        // pages not yet populated get populated on demand in both address spaces
+    dst.unmapped_ranges = src.unmapped_ranges;
+    dst.free_stacks = src.free_stacks;          // guard pages got cloned along with the page tables
+    dst.stats.stacks_count = 1;                 // only the forking thread goes on in the clone, on its own stack
+    u64* src_pde = PageTables::get_pde_for_virt_address(0, src.pml4_phys_addr); // user task virtual address space starts at virt address 0
+    u64* dst_pde = PageTables::get_pde_for_virt_address(0, dst.pml4_phys_addr);
+
+    // frames that become read-only must not stay writable in any cpu TLB
+    write_protect_address_space(src_pde);
+    PageTables::flush_tlb();
+
+    // scan 0..1GB of virtual memory
+    MemoryManager& mngr = MemoryManager::instance();
+    bool success = true;
+    for (u32 i = 0; i < 512 && success; i++) {  // scan 512 * 2MB regions
+        if ((src_pde[i] & PageAttr::PRESENT) != PageAttr::PRESENT || (src_pde[i] & PageAttr::HUGE_PAGE)) {
+            success = share_page(src_pde[i]);
+            if (success)
+                dst_pde[i] = src_pde[i];
+            continue;
+        }
+
+        // region split into 4KB pages; clone the page table
+        u64 pt_phys_addr = (u64)mngr.alloc_frames(sizeof(PageTable4K));
+        if (pt_phys_addr == 0) {
+            success = false;
+            break;
+        }
+
+        PageTable4K* src_pt = (PageTable4K*)HigherHalf::phys_to_virt(src_pde[i] & PageTables::FRAME_ADDRESS_MASK);
+        PageTable4K* dst_pt = (PageTable4K*)HigherHalf::phys_to_virt(pt_phys_addr);
+        for (u32 j = 0; j < 512; j++) {
+            if (!share_page(src_pt->pte[j])) {
+                memset(&dst_pt->pte[j], 0, (512 - j) * sizeof(u64));   // so release_address_space only drops shared frames
+                success = false;
+                break;
+            }
+            dst_pt->pte[j] = src_pt->pte[j];
+        }
+
+        dst_pde[i] = pt_phys_addr | (src_pde[i] & ~PageTables::FRAME_ADDRESS_MASK);
+    }
+
+    if (!success) {
+        release_address_space(dst);
+        return {ErrorCode::EC_NOMEM};
+    }
+
+    return result;
 }
 
 /**
@@ -35,22 +149,88 @@ void release_address_space(AddressSpace& as) {
     if (as.pml4_phys_addr == 0)
         return;
 
-    u64* pde_virt_addr =  PageTables::get_page_for_virt_address(0, as.pml4_phys_addr); // user task virtual address space starts at virt address 0
+    u64* pde_virt_addr =  PageTables::get_pde_for_virt_address(0, as.pml4_phys_addr); // user task virtual address space starts at virt address 0
 
     // scan 0..1GB of virtual memory
     MemoryManager& mngr = MemoryManager::instance();
-    for (u32 i = 0; i < 512; i++)   // scan 512 * 2MB pages
-        if ((pde_virt_addr[i] & PageAttr::PRESENT) == PageAttr::PRESENT) {
-            mngr.free_frames((void*)pde_virt_addr[i], 1); // 1 byte will always correspond to just 1 frame
+    for (u32 i = 0; i < 512; i++) {  // scan 512 * 2MB regions
+        u64 pde = pde_virt_addr[i];
+        if ((pde & PageAttr::PRESENT) != PageAttr::PRESENT)
+            continue;
+
+        if (pde & PageAttr::HUGE_PAGE) {
+            mngr.free_frames((void*)(pde & PageTables::FRAME_ADDRESS_MASK), PageTables::get_huge_page_size());
+            continue;
         }
 
-    // release the page table itself
+        // region split into 4KB pages; release the pages, then the page table
+        PageTable4K* pt = (PageTable4K*)HigherHalf::phys_to_virt(pde & PageTables::FRAME_ADDRESS_MASK);
+        for (u32 j = 0; j < 512; j++)
+            if ((pt->pte[j] & PageAttr::PRESENT) == PageAttr::PRESENT && !(pt->pte[j] & PageAttr::DEVICE_MEMORY))
+                mngr.free_frames((void*)(pt->pte[j] & PageTables::FRAME_ADDRESS_MASK), PageTables::get_page_size());
+            else if (Swap::is_swapped_out(pt->pte[j]))
+                Swap::free_slot(pt->pte[j]);
+
+        mngr.free_frames((void*)(pde & PageTables::FRAME_ADDRESS_MASK), sizeof(PageTable4K));
+    }
+
+    // release the page table itself, and the PCID
+    Swap::unregister_address_space(as.pml4_phys_addr);
     mngr.free_frames((void*)as.pml4_phys_addr, sizeof(PageTables64));
+    PageTables::release_pcid(as.pcid);
+    as.pcid = 0;
+
+    // and the memory areas, and the stacks waiting for reuse
+    as.memory_areas.clear();
+    as.unmapped_ranges.clear();
+    as.free_stacks.clear();
+    as.stats = {};
 
     // mark address space as invalid
     as.pml4_phys_addr = 0;
 }
 
+/**
+ * @brief   Release frames of the heap pages that lie entirely within "first_byte".."last_byte"
+ * @note    Used when program break moves down; the pages get allocated again on page fault if the heap grows back.
+ *          2MB pages only partially within the range are kept
+ */
+void release_heap_pages(AddressSpace& as, u64 first_byte, u64 last_byte) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+    constexpr u64 HUGE_PAGE_SIZE = PageTables::get_huge_page_size();
+    MemoryManager& mngr = MemoryManager::instance();
+
+    u64 page = (first_byte + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    while (page + PAGE_SIZE - 1 <= last_byte) {
+        const u64 next_region = (page & ~(HUGE_PAGE_SIZE - 1)) + HUGE_PAGE_SIZE;
+        u64* pde = PageTables::get_pde_for_virt_address(page, as.pml4_phys_addr);
+        if (!pde || (*pde & PageAttr::PRESENT) != PageAttr::PRESENT) {
+            page = next_region;
+            continue;
+        }
+
+        if (*pde & PageAttr::HUGE_PAGE) {
+            if ((page & (HUGE_PAGE_SIZE - 1)) == 0 && page + HUGE_PAGE_SIZE - 1 <= last_byte) {
+                mngr.free_frames((void*)(*pde & PageTables::FRAME_ADDRESS_MASK), HUGE_PAGE_SIZE);
+                PageTables::unmap_page(page, as.pml4_phys_addr);
+            }
+            page = next_region;
+            continue;
+        }
+
+        u64* pte = PageTables::get_page_for_virt_address(page, as.pml4_phys_addr);
+        if ((*pte & PageAttr::PRESENT) == PageAttr::PRESENT) {
+            if (!(*pte & PageAttr::DEVICE_MEMORY))
+                mngr.free_frames((void*)(*pte & PageTables::FRAME_ADDRESS_MASK), PAGE_SIZE);
+            PageTables::unmap_page(page, as.pml4_phys_addr);
+        } else if (Swap::is_swapped_out(*pte)) {
+            Swap::free_slot(*pte);
+            *pte = 0;
+        }
+        page += PAGE_SIZE;
+    }
+}
+
 /**
  * @brief   Allocate memory from the top of the heap and return pointer to that memory
  * @return  nullptr if no memory left, pointer to allocated memory otherwise
@@ -68,13 +248,23 @@ void* alloc_static(AddressSpace& as, size_t size) {
 /**
  * @brief   Allocate memory from the top of the heap for a stack and mark a page below as stack guard page
  * @return  nullptr if no memory left, pointer to allocated stack otherwise
- * @note    It will actually allocate a multiplicity of PAGE_SIZE that can accommodate "num_bytes"
- * @note    This memory will not be released until the entire address space is released
- *          means if a thread dies - we have a memory leak
+ * @note    Stack and its guard page are mapped with 4KB pages, so only the stack pages actually touched cost memory
+ * @note    Stack of same size released by a finished thread is reused first; heap is only eaten when there is none
  */
 void* alloc_stack_and_mark_guard_page(AddressSpace& as, size_t num_bytes) {
     constexpr u64 PAGE_SIZE = PageTables::get_page_size();
 
+    // reuse released stack if there is one
+    for (size_t i = 0; i < as.free_stacks.size(); i++)
+        if (as.free_stacks[i].num_bytes == num_bytes) {
+            u64 stack_bottom = as.free_stacks[i].stack_bottom;
+            as.free_stacks[i] = as.free_stacks.back();
+            as.free_stacks.pop_back();
+            as.stats.stacks_count++;
+            recycled_stacks_count++;
+            return (void*)stack_bottom;
+        }
+
     // stack bottom is page aligned
     u64 stack_bottom_page_aligned = (as.heap_high_limit - num_bytes) & (~(PAGE_SIZE-1));
 
@@ -89,9 +279,280 @@ void* alloc_stack_and_mark_guard_page(AddressSpace& as, size_t num_bytes) {
         return nullptr;
 
     // setup guard page
-    PageTables::map_stack_guard_page(guard_bottom_page_aligned, as.pml4_phys_addr);
+    if (!PageTables::map_stack_guard_page(guard_bottom_page_aligned, as.pml4_phys_addr))
+        return nullptr;
 
     as.heap_high_limit = new_heap_high_limit;
+    as.stats.stacks_count++;
     return (void*)stack_bottom_page_aligned;
 }
+
+/**
+ * @brief   Take "num_bytes" from the first large enough range released with unmap_area
+ * @return  False if there is no such range
+ */
+static bool take_unmapped_range(AddressSpace& as, u64 num_bytes, u64& out_first_byte) {
+    for (size_t i = 0; i < as.unmapped_ranges.size(); i++) {
+        VirtualRange& r = as.unmapped_ranges[i];
+        if (r.last_byte - r.first_byte + 1 < num_bytes)
+            continue;
+
+        out_first_byte = r.first_byte;
+        r.first_byte += num_bytes;
+        if (r.first_byte > r.last_byte) {
+            r = as.unmapped_ranges.back();
+            as.unmapped_ranges.pop_back();
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief   Remember page aligned range "first_byte".."last_byte" as free for reuse, merging it with neighbour free ranges.
+ *          Range that borders the top of the heap goes back to the heap
+ */
+static void put_unmapped_range(AddressSpace& as, u64 first_byte, u64 last_byte) {
+    for (size_t i = 0; i < as.unmapped_ranges.size(); ) {
+        VirtualRange& r = as.unmapped_ranges[i];
+        if (r.last_byte + 1 == first_byte || last_byte + 1 == r.first_byte) {
+            first_byte = min(first_byte, r.first_byte);
+            last_byte = max(last_byte, r.last_byte);
+            r = as.unmapped_ranges.back();
+            as.unmapped_ranges.pop_back();
+        }
+        else
+            i++;
+    }
+
+    if (as.heap_high_limit + 1 == first_byte)
+        as.heap_high_limit = last_byte;
+    else
+        as.unmapped_ranges.push_back({first_byte, last_byte});
+}
+
+/**
+ * @brief   Reserve "num_bytes" of virtual memory for a new memory area, populated on page fault:
+ *          from "file" starting at "file_offset", or with zeros if there is no "file"
+ * @return  First byte of the area on success, EC_NOMEM if no virtual memory left
+ * @note    Memory released with unmap_area is reused first; otherwise the area is taken from the top of the heap
+ */
+utils::SyscallResult<u64> map_area(AddressSpace& as, u64 num_bytes, bool writable, const filesystem::OpenEntryPtr& file, u64 file_offset) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    num_bytes = (num_bytes + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if (num_bytes == 0)
+        return {ErrorCode::EC_INVAL};
+
+    u64 first_byte;
+    if (!take_unmapped_range(as, num_bytes, first_byte)) {
+        // area ends right below the page that holds the top of the heap
+        u64 area_end = (as.heap_high_limit + 1) & ~(PAGE_SIZE - 1);
+
+        // check for out of memory
+        if (area_end < as.heap_low_limit + 1 + num_bytes)
+            return {ErrorCode::EC_NOMEM};
+
+        first_byte = area_end - num_bytes;
+        as.heap_high_limit = first_byte - 1;
+    }
+
+    // bytes past the end of file read as zeros
+    u64 file_size = 0;
+    if (file) {
+        u64 size = file->get_size().value;
+        if (file_offset < size)
+            file_size = min(num_bytes, size - file_offset);
+    }
+
+    as.memory_areas.push_back({first_byte, first_byte + num_bytes - 1, file_offset, file_size, file, writable});
+    return {first_byte};
+}
+
+/**
+ * @brief   Remove memory areas from "first_byte".."first_byte + num_bytes - 1" and release their frames.
+ *          Areas only partially within the range are cut down
+ * @return  EC_INVAL if "first_byte" is not page aligned or the range is empty
+ */
+utils::SyscallResult<void> unmap_area(AddressSpace& as, u64 first_byte, u64 num_bytes) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    num_bytes = (num_bytes + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    const u64 last_byte = first_byte + num_bytes - 1;
+    if ((first_byte & (PAGE_SIZE - 1)) || num_bytes == 0 || last_byte < first_byte)
+        return {ErrorCode::EC_INVAL};
+
+    MemoryAreas remaining;
+    for (const MemoryArea& m : as.memory_areas) {
+        if (m.last_byte < first_byte || m.first_byte > last_byte) {
+            remaining.push_back(m);
+            continue;
+        }
+
+        // part below the range stays
+        if (m.first_byte < first_byte) {
+            MemoryArea below = m;
+            below.last_byte = first_byte - 1;
+            below.file_size = min(m.file_size, first_byte - m.first_byte);
+            remaining.push_back(below);
+        }
+
+        // part above the range stays
+        if (m.last_byte > last_byte) {
+            const u64 skipped = last_byte + 1 - m.first_byte;
+            MemoryArea above = m;
+            above.first_byte = last_byte + 1;
+            above.file_offset += skipped;
+            above.file_size = (m.file_size > skipped) ? m.file_size - skipped : 0;
+            remaining.push_back(above);
+        }
+
+        // part within the range goes away, only whole pages can be reused
+        const u64 released_first = max(m.first_byte, first_byte);
+        const u64 released_last = min(m.last_byte, last_byte);
+        release_heap_pages(as, released_first, released_last);
+
+        const u64 reusable_first = (released_first + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+        const u64 reusable_end = (released_last + 1) & ~(PAGE_SIZE - 1);
+        if (reusable_first < reusable_end)
+            put_unmapped_range(as, reusable_first, reusable_end - 1);
+    }
+
+    as.memory_areas = std::move(remaining);
+    return {ErrorCode::EC_OK};
+}
+
+/**
+ * @brief   Map "num_bytes" of device memory starting at physical "phys_addr" into "as" address space.
+ *          All the pages get mapped right away; their frames are never freed nor copied on write
+ * @param   write_combining Let cpu combine writes to the pages into bursts, eg. for framebuffers
+ * @return  First byte of the mapping on success, EC_INVAL if "phys_addr" is not page aligned, EC_NOMEM if no memory left
+ */
+utils::SyscallResult<u64> map_device_memory(AddressSpace& as, u64 phys_addr, u64 num_bytes, bool write_combining) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    if (phys_addr & (PAGE_SIZE - 1))
+        return {ErrorCode::EC_INVAL};
+
+    // reserve virtual memory
+    u64 first_byte;
+    if (auto result = map_area(as, num_bytes, true, {}, 0))
+        first_byte = result.value;
+    else
+        return {result.ec};
+
+    u64 attributes = PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::USER_ACCESSIBLE | PageAttr::DEVICE_MEMORY;
+    if (write_combining)
+        attributes |= PageAttr::WRITE_COMBINING;
+
+    for (u64 offset = 0; offset < num_bytes; offset += PAGE_SIZE) {
+        u64* pte = PageTables::get_or_alloc_page_table_entry(first_byte + offset, as.pml4_phys_addr);
+        if (!pte) {
+            unmap_area(as, first_byte, num_bytes);
+            return {ErrorCode::EC_NOMEM};
+        }
+
+        *pte = (phys_addr + offset) | attributes;
+    }
+
+    return {first_byte};
+}
+
+/**
+ * @brief   Unmap every page of "as" address space that maps device memory "phys_addr".."phys_addr"+"num_bytes"-1,
+ *          eg. when the device stops backing that memory. The virtual range stays reserved as anonymous memory,
+ *          so further access gets a zeroed page instead of reaching the device
+ */
+void unmap_device_memory(AddressSpace& as, u64 phys_addr, u64 num_bytes) {
+    if (as.pml4_phys_addr == 0)
+        return;
+
+    u64* pde_virt_addr = PageTables::get_pde_for_virt_address(0, as.pml4_phys_addr); // user task virtual address space starts at virt address 0
+
+    // scan 0..1GB of virtual memory; device memory is mapped with 4KB pages only
+    for (u32 i = 0; i < 512; i++) {  // scan 512 * 2MB regions
+        u64 pde = pde_virt_addr[i];
+        if ((pde & PageAttr::PRESENT) != PageAttr::PRESENT || (pde & PageAttr::HUGE_PAGE))
+            continue;
+
+        PageTable4K* pt = (PageTable4K*)HigherHalf::phys_to_virt(pde & PageTables::FRAME_ADDRESS_MASK);
+        for (u32 j = 0; j < 512; j++) {
+            const u64 frame_phys_addr = pt->pte[j] & PageTables::FRAME_ADDRESS_MASK;
+            if (!(pt->pte[j] & PageAttr::DEVICE_MEMORY) || frame_phys_addr < phys_addr || frame_phys_addr >= phys_addr + num_bytes)
+                continue;
+
+            pt->pte[j] = 0;
+            PageTables::invalidate_page(i * PageTables::get_huge_page_size() + j * PageTables::get_page_size(), as.pml4_phys_addr);
+        }
+    }
+}
+
+/**
+ * @brief   Release the frames of stack pages touched by a finished thread and keep the stack for the next thread
+ * @note    Execution context: Interrupt only (on kill_current_task, when Task is destroyed)
+ * @note    Only the pages that lie entirely within the stack are released; the top page may be shared with data above the stack
+ */
+void release_stack(AddressSpace& as, void* stack_addr, size_t num_bytes) {
+    if (as.pml4_phys_addr == 0 || !stack_addr)
+        return;
+
+    release_heap_pages(as, (u64)stack_addr, (u64)stack_addr + num_bytes - 1);
+    as.free_stacks.push_back({(u64)stack_addr, num_bytes});
+    if (as.stats.stacks_count > 0)
+        as.stats.stacks_count--;
+    released_stacks_count++;
+}
+
+/**
+ * @brief   Count the pages taken by "as" address space, walking its page tables
+ * @note    Frames shared copy-on-write count in every address space that maps them; device memory doesnt count
+ */
+AddressSpaceUsage get_memory_usage(const AddressSpace& as) {
+    constexpr u64 PAGES_PER_HUGE_PAGE = PageTables::get_huge_page_size() / PageTables::get_page_size();
+
+    AddressSpaceUsage usage {0, 0, 0};
+    if (as.pml4_phys_addr == 0)
+        return usage;
+
+    usage.page_table_pages = sizeof(PageTables64) / PageTables::get_page_size();
+    u64* pde_virt_addr = PageTables::get_pde_for_virt_address(0, as.pml4_phys_addr); // user task virtual address space starts at virt address 0
+
+    // scan 0..1GB of virtual memory
+    for (u32 i = 0; i < 512; i++) {  // scan 512 * 2MB regions
+        u64 pde = pde_virt_addr[i];
+        if ((pde & PageAttr::PRESENT) != PageAttr::PRESENT)
+            continue;
+
+        if (pde & PageAttr::HUGE_PAGE) {
+            usage.resident_pages += PAGES_PER_HUGE_PAGE;
+            continue;
+        }
+
+        usage.page_table_pages++;
+        PageTable4K* pt = (PageTable4K*)HigherHalf::phys_to_virt(pde & PageTables::FRAME_ADDRESS_MASK);
+        for (u32 j = 0; j < 512; j++)
+            if ((pt->pte[j] & PageAttr::PRESENT) == PageAttr::PRESENT && !(pt->pte[j] & PageAttr::DEVICE_MEMORY))
+                usage.resident_pages++;
+            else if (Swap::is_swapped_out(pt->pte[j]))
+                usage.swapped_out_pages++;
+    }
+
+    return usage;
+}
+
+/**
+ * @brief   Number of stacks handed to new threads from released stacks, since boot
+ */
+size_t get_recycled_stacks_count() {
+    return recycled_stacks_count;
+}
+
+/**
+ * @brief   Number of stacks released by finished threads, since boot
+ */
+size_t get_released_stacks_count() {
+    return released_stacks_count;
+}
+
 }
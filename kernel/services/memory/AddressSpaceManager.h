@@ -13,10 +13,29 @@
 
 namespace memory {
 
+/**
+ * @brief   Memory taken by an address space, in 4KB pages
+ */
+struct AddressSpaceUsage {
+    u64 resident_pages;     // user pages backed by frames; 2MB page counts as 512 pages
+    u64 swapped_out_pages;  // user pages waiting in swap space
+    u64 page_table_pages;   // frames taken by the page tables
+};
+
 utils::SyscallResult<AddressSpace> alloc_address_space(u64 heap_low_limit, u64 heap_high_limit);
+utils::SyscallResult<AddressSpace> clone_address_space(AddressSpace& src);
 void release_address_space(AddressSpace& as);
+void release_heap_pages(AddressSpace& as, u64 first_byte, u64 last_byte);
 void* alloc_static(AddressSpace& as, size_t size);
 void* alloc_stack_and_mark_guard_page(AddressSpace& as, size_t num_bytes);
+void release_stack(AddressSpace& as, void* stack_addr, size_t num_bytes);
+utils::SyscallResult<u64> map_area(AddressSpace& as, u64 num_bytes, bool writable, const filesystem::OpenEntryPtr& file, u64 file_offset);
+utils::SyscallResult<void> unmap_area(AddressSpace& as, u64 first_byte, u64 num_bytes);
+utils::SyscallResult<u64> map_device_memory(AddressSpace& as, u64 phys_addr, u64 num_bytes, bool write_combining);
+void unmap_device_memory(AddressSpace& as, u64 phys_addr, u64 num_bytes);
+AddressSpaceUsage get_memory_usage(const AddressSpace& as);
+size_t get_recycled_stacks_count();
+size_t get_released_stacks_count();
 
 }
 
@@ -0,0 +1,168 @@
+/**
+ *   @file: BuddyAllocator.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "cstd.h"
+#include "BuddyAllocator.h"
+#include "HigherHalf.h"
+#include "PageTables.h"
+
+namespace memory {
+
+/**
+ * @brief   Prepare the allocator for "frames_count" frames, all of them initially taken
+ * @param   storage Memory for the free block bitmaps, at least get_storage_words_count(frames_count) words long
+ */
+void BuddyAllocator::init(u64* storage, size_t frames_count) {
+    free_bitmap = storage;
+
+    size_t offset = 0;
+    for (u8 order = 0; order <= MAX_ORDER; order++) {
+        const size_t blocks_count = (frames_count + (1ULL << order) - 1) >> order;
+        order_offset[order] = offset;
+        order_words[order] = (blocks_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+        free_count[order] = 0;
+        free_list[order] = nullptr;
+        offset += order_words[order];
+    }
+
+    memset(free_bitmap, 0, offset * sizeof(u64));
+}
+
+/**
+ * @brief   Make frames "first_index".."last_index" available, as the biggest aligned blocks that fit the range
+ */
+void BuddyAllocator::release_range(size_t first_index, size_t last_index) {
+    size_t i = first_index;
+    while (i <= last_index) {
+        u8 order = 0;
+        while (order < MAX_ORDER) {
+            const size_t next_size = 1ULL << (order + 1);
+            if ((i & (next_size - 1)) != 0 || i + next_size - 1 > last_index)
+                break; // not aligned or doesnt fit in the range
+            order++;
+        }
+
+        free_block(i, order);
+        i += 1ULL << order;
+    }
+}
+
+/**
+ * @brief   Take a block of 2^order frames, splitting a bigger block if no block of that order is free
+ * @return  -1 on failure, index of the first frame on success
+ */
+ssize_t BuddyAllocator::alloc_block(u8 order) {
+    if (order > MAX_ORDER)
+        return -1;
+
+    // find the smallest order with a free block
+    u8 found_order = order;
+    while (found_order <= MAX_ORDER && free_count[found_order] == 0)
+        found_order++;
+
+    if (found_order > MAX_ORDER)
+        return -1;
+
+    size_t block_index = to_block_index(found_order, free_list[found_order]);
+    mark_taken(found_order, block_index);
+
+    // split down to the requested order; lower halves are taken further, upper halves stay free
+    while (found_order > order) {
+        found_order--;
+        block_index *= 2;
+        mark_free(found_order, block_index + 1);
+    }
+
+    return block_index << order;
+}
+
+/**
+ * @brief   Return a block of 2^order frames starting at "first_index", merging it with its free buddies
+ */
+void BuddyAllocator::free_block(size_t first_index, u8 order) {
+    size_t block_index = first_index >> order;
+
+    while (order < MAX_ORDER) {
+        const size_t buddy_index = block_index ^ 1;
+        if (buddy_index / BITS_PER_WORD >= order_words[order] || !is_free(order, buddy_index))
+            break;
+
+        mark_taken(order, buddy_index);
+        block_index /= 2;
+        order++;
+    }
+
+    mark_free(order, block_index);
+}
+
+/**
+ * @brief   How many free blocks of given order are there?
+ */
+size_t BuddyAllocator::get_free_blocks_count(u8 order) const {
+    return order <= MAX_ORDER ? free_count[order] : 0;
+}
+
+/**
+ * @brief   Smallest order whose block can hold "num_frames" frames
+ */
+u8 BuddyAllocator::frames_to_order(size_t num_frames) {
+    u8 order = 0;
+    while ((1ULL << order) < num_frames)
+        order++;
+    return order;
+}
+
+bool BuddyAllocator::is_free(u8 order, size_t block_index) const {
+    const u64 word = free_bitmap[order_offset[order] + block_index / BITS_PER_WORD];
+    return word & (1ULL << (block_index % BITS_PER_WORD));
+}
+
+/**
+ * @brief   Mark the block free and put it at the head of its order free list
+ */
+void BuddyAllocator::mark_free(u8 order, size_t block_index) {
+    free_bitmap[order_offset[order] + block_index / BITS_PER_WORD] |= 1ULL << (block_index % BITS_PER_WORD);
+    free_count[order]++;
+
+    BuddyFreeBlock* block = to_free_block(order, block_index);
+    block->prev = nullptr;
+    block->next = free_list[order];
+    if (block->next)
+        block->next->prev = block;
+    free_list[order] = block;
+}
+
+/**
+ * @brief   Mark the block taken and unlink it from its order free list
+ */
+void BuddyAllocator::mark_taken(u8 order, size_t block_index) {
+    free_bitmap[order_offset[order] + block_index / BITS_PER_WORD] &= ~(1ULL << (block_index % BITS_PER_WORD));
+    free_count[order]--;
+
+    BuddyFreeBlock* block = to_free_block(order, block_index);
+    if (block->prev)
+        block->prev->next = block->next;
+    else
+        free_list[order] = block->next;
+    if (block->next)
+        block->next->prev = block->prev;
+}
+
+/**
+ * @brief   Get the list links of a free block; they lie at the beginning of the block first frame
+ */
+BuddyFreeBlock* BuddyAllocator::to_free_block(u8 order, size_t block_index) {
+    const size_t first_frame_index = block_index << order;
+    return (BuddyFreeBlock*)HigherHalf::phys_to_virt(first_frame_index * PageTables::get_page_size());
+}
+
+size_t BuddyAllocator::to_block_index(u8 order, const BuddyFreeBlock* block) {
+    const size_t first_frame_index = HigherHalf::virt_to_phys(block) / PageTables::get_page_size();
+    return first_frame_index >> order;
+}
+
+} /* namespace memory */
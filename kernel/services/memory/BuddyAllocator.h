@@ -0,0 +1,69 @@
+/**
+ *   @file: BuddyAllocator.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef SRC_MEMORY_BUDDYALLOCATOR_H_
+#define SRC_MEMORY_BUDDYALLOCATOR_H_
+
+#include "types.h"
+
+namespace memory {
+
+/**
+ * @brief   Links of a free block on its order free list, kept in the first bytes of the free block memory itself
+ */
+struct BuddyFreeBlock {
+    BuddyFreeBlock* prev;
+    BuddyFreeBlock* next;
+};
+
+/**
+ * @brief   Binary buddy allocator over a range of frame indices.
+ *          Free memory is kept as power-of-two sized, naturally aligned blocks; block of "order" k spans 2^k frames.
+ *          Allocation splits a bigger block in halves until the requested order is reached,
+ *          freeing merges a block with its buddy (the other half of the parent block) for as long as the buddy is free.
+ *          Free blocks of each order form a doubly-linked list, so alloc takes the list head and free unlinks the buddy
+ *          in O(1) per order; both run in O(log n)
+ * @note    Each order also has a bitmap of free blocks, kept in the caller-provided storage, to tell in O(1) if a buddy is free.
+ *          List links live in the free frames, reached through the direct map, so the allocator itself needs no dynamic
+ *          memory and can run before the kernel heap exists
+ */
+class BuddyAllocator {
+public:
+    static constexpr u8     MAX_ORDER       {18};   // 2^18 frames * 4KB = 1GB in a single block
+    static constexpr size_t BITS_PER_WORD   {64};
+
+    /**
+     * @brief   Number of u64 words that "init" needs as storage to handle "frames_count" frames
+     */
+    static constexpr size_t get_storage_words_count(size_t frames_count) {
+        return (2 * frames_count) / BITS_PER_WORD + MAX_ORDER + 2;
+    }
+
+    void init(u64* storage, size_t frames_count);
+    void release_range(size_t first_index, size_t last_index);
+    ssize_t alloc_block(u8 order);
+    void free_block(size_t first_index, u8 order);
+    size_t get_free_blocks_count(u8 order) const;
+    static u8 frames_to_order(size_t num_frames);
+
+private:
+    bool is_free(u8 order, size_t block_index) const;
+    void mark_free(u8 order, size_t block_index);
+    void mark_taken(u8 order, size_t block_index);
+    static BuddyFreeBlock* to_free_block(u8 order, size_t block_index);
+    static size_t to_block_index(u8 order, const BuddyFreeBlock* block);
+
+    u64*            free_bitmap                 {nullptr};  // bitmaps of all orders, one after another
+    size_t          order_offset[MAX_ORDER + 1] {};         // where given order bitmap starts in "free_bitmap", in words
+    size_t          order_words[MAX_ORDER + 1]  {};         // given order bitmap length, in words
+    size_t          free_count[MAX_ORDER + 1]   {};         // number of free blocks of given order, so empty orders are skipped at once
+    BuddyFreeBlock* free_list[MAX_ORDER + 1]    {};         // free blocks of given order
+};
+
+} /* namespace memory */
+
+#endif /* SRC_MEMORY_BUDDYALLOCATOR_H_ */
@@ -7,36 +7,78 @@
 
 #include "cstd.h"
 #include "FrameAllocator.h"
+#include "HigherHalf.h"
 
 namespace memory {
 
-size_t  FrameAllocator::total_frames {0};
-bool    FrameAllocator::frames_allocated[128*1024*1024 / FrameAllocator::get_frame_size()]; // map enough pages to handle 128MB
+size_t          FrameAllocator::max_frames {0};
+size_t          FrameAllocator::total_frames {0};
+size_t          FrameAllocator::used_frames {0};
+u64*            FrameAllocator::frames_bitmap {nullptr};
+BuddyAllocator  FrameAllocator::buddy;
+u16*            FrameAllocator::frame_shares {nullptr};
+u8*             FrameAllocator::block_orders {nullptr};
 
 
-void FrameAllocator::init(size_t first_available_memory_byte, size_t last_available_memory_byte) {
-    const size_t first_index = first_available_memory_byte / get_frame_size() + 1;
-    const size_t last_index = last_available_memory_byte / get_frame_size();
-    total_frames = min(last_index + 1, sizeof(frames_allocated) / sizeof(frames_allocated[0]));
-
-    for (size_t i = 0; i < first_index; i++)
-        frames_allocated[i] = true;
-
-    for (size_t i = last_index + 1; i < get_total_frames_count(); i++)
-        frames_allocated[i] = true;
+/**
+ * @brief   Start tracking frames of all the "map" regions; holes between the regions are never handed out
+ * @note    Bitmap, buddy, share counter and order storage are carved out of "map" from below 1GB, so they can be accessed before and after
+ *          physical memory above 1GB gets mapped
+ */
+void FrameAllocator::init(PhysicalMemoryMap& map) {
+    const size_t frames_count = map.get_last_byte() / get_frame_size() + 1;
+    const size_t bitmap_words = (frames_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    const size_t buddy_words = BuddyAllocator::get_storage_words_count(frames_count);
+    const size_t shares_bytes = frames_count * sizeof(u16);
+    const size_t orders_bytes = frames_count * sizeof(u8);
+
+    const ssize_t storage_phys_addr = map.carve((bitmap_words + buddy_words) * sizeof(u64) + shares_bytes + orders_bytes, HigherHalf::get_kernel_static_memory_size());
+    if (storage_phys_addr == -1)
+        return; // no memory to manage
+
+    max_frames = frames_count;
+    frames_bitmap = (u64*)HigherHalf::phys_to_virt(storage_phys_addr);
+
+    // start with everything allocated, including the holes and the bits past "max_frames" in the last word
+    for (size_t w = 0; w < bitmap_words; w++)
+        frames_bitmap[w] = ~0ULL;
+
+    // no frame is shared at the beginning
+    frame_shares = (u16*)(frames_bitmap + bitmap_words + buddy_words);
+    memset(frame_shares, 0, shares_bytes);
+
+    // and no chain is allocated
+    block_orders = (u8*)(frame_shares + frames_count);
+    memset(block_orders, NO_BLOCK, orders_bytes);
+
+    // then release the available regions, both in the bitmap and in the buddy allocator
+    buddy.init(frames_bitmap + bitmap_words, max_frames);
+    total_frames = 0;
+    used_frames = 0;
+    for (u32 r = 0; r < map.get_regions_count(); r++) {
+        const size_t first_index = map.get_region(r).first_byte / get_frame_size();
+        const size_t last_index = map.get_region(r).last_byte / get_frame_size();
+
+        for (size_t i = first_index; i <= last_index; i++)
+            frames_bitmap[i / BITS_PER_WORD] &= ~(1ULL << (i % BITS_PER_WORD));
+
+        buddy.release_range(first_index, last_index);
+        total_frames += last_index - first_index + 1;
+    }
 }
 
 /**
- * @brief   Find first free frame and allocate it
+ * @brief   Allocate single frame
  * @return  -1 on failure, frame physical address on success
  */
 ssize_t FrameAllocator::alloc_frame() {
-    const ssize_t index = find_unused_starting_at(0);
+    const ssize_t index = buddy.alloc_block(0);
 
     if (index == -1)
         return -1; // no free page available
 
-    frames_allocated[index] = true;
+    mark_allocated(index);
+    block_orders[index] = 0;
     return index * get_frame_size();
 }
 
@@ -44,92 +86,81 @@ ssize_t FrameAllocator::alloc_frame() {
  * @brief   Find frame that starts at "physical_address" and deallocate it
  */
 void FrameAllocator::free_frame(size_t physical_address) {
-    const size_t index = physical_address / get_frame_size();
-    if (index < get_total_frames_count())
-        frames_allocated[index] = false;
+    free_consecutive_frames(physical_address, 1);
 }
 
 /**
- * @brief   Find and allocate a chain of consecutive frames that is capable to hold at least "num_bytes"
+ * @brief   Allocate a chain of consecutive frames that is capable to hold at least "num_bytes"
  * @return  -1 on failure, first frame physical address on success
+ * @note    The chain is rounded up to power-of-two frames; free_consecutive_frames must be given same "num_bytes",
+ *          as the chain remembers its order
  */
 ssize_t FrameAllocator::alloc_consecutive_frames(size_t num_bytes) {
-    const size_t num_needed_frames = num_bytes / get_frame_size() + 1;
-
-    ssize_t index = 0;
-    size_t consecutive_unused_count = 0;
-    while ((index = find_unused_starting_at(index)) > -1) {
-        consecutive_unused_count = check_consecutive_unused_count_at(index, num_needed_frames);
-        if (consecutive_unused_count == num_needed_frames)
-            break; // found
-        else
-            index += consecutive_unused_count; // continue search
-    }
+    const u8 order = BuddyAllocator::frames_to_order(bytes_to_frames(num_bytes));
+    const ssize_t index = buddy.alloc_block(order);
 
     // no long enough chain of frames found
-    if (consecutive_unused_count < num_needed_frames)
+    if (index == -1)
         return -1;
 
     // mark frames as allocated
-    for (size_t i = index; i < index + num_needed_frames; i++)
-        frames_allocated[i] = true;
+    for (size_t i = index; i < index + (1ULL << order); i++)
+        mark_allocated(i);
 
+    block_orders[index] = order;
     return index  * get_frame_size();
 }
 
 /**
- * @brief   Find first free frame index starting at "start_index"
- * @return  -1 on failure, frame index on success
+ * @brief   Find consecutive frame chain that starts at "physical_address" and deallocate all its frames
+ * @note    Shared chain only loses one owner; it is deallocated when the last owner frees it
  */
-ssize_t FrameAllocator::find_unused_starting_at(size_t start_index) {
-    for (size_t i = start_index; i < get_total_frames_count(); i++)
-        if (!frames_allocated[i])
-            return i;
+void FrameAllocator::free_consecutive_frames(size_t physical_address, size_t num_bytes) {
+    const size_t index = physical_address / get_frame_size();
+    const u8 order = BuddyAllocator::frames_to_order(bytes_to_frames(num_bytes));
+
+    // dont let invalid, double or wrong size free corrupt the buddy lists
+    if (index >= max_frames || block_orders[index] != order)
+        return;
+
+    if (frame_shares[index] > 0) {
+        frame_shares[index]--;
+        return;
+    }
 
-    return -1;  // not found
+    for (size_t i = index; i < index + (1ULL << order); i++)
+        mark_unused(i);
+
+    block_orders[index] = NO_BLOCK;
+    buddy.free_block(index, order);
 }
 
 /**
- * @brief   Check how many consecutive free frames start at "start_index", check for at most "required_frames_count"
+ * @brief   Add an owner to allocated frame or frame chain that starts at "physical_address"
+ * @return  False if the frame is not allocated or has too many owners already
  */
-size_t FrameAllocator::check_consecutive_unused_count_at(size_t start_index, size_t required_frames_count) {
-    size_t result = 0;
-    for (size_t i = start_index; i < get_total_frames_count(); i++) {
-        if (result == required_frames_count)
-            break;
-
-        if (frames_allocated[i])
-           break; // break if no more consecutive free frames
-
-        result++;
-    }
+bool FrameAllocator::share_frames(size_t physical_address) {
+    const size_t index = physical_address / get_frame_size();
+    if (index >= max_frames || !is_allocated(index) || frame_shares[index] == MAX_SHARES)
+        return false;
 
-    return result;
+    frame_shares[index]++;
+    return true;
 }
 
 /**
- * @brief   Find consecutive frame chain that starts at "physical_address" and deallocate all its frames
+ * @brief   Check if frame or frame chain that starts at "physical_address" has more than one owner
  */
-void FrameAllocator::free_consecutive_frames(size_t physical_address, size_t num_bytes) {
+bool FrameAllocator::is_frame_shared(size_t physical_address) {
     const size_t index = physical_address / get_frame_size();
-    const size_t num_frames = num_bytes / get_frame_size() + 1;
-
-    if (index < get_total_frames_count())
-        for (size_t i = index; i < index + num_frames; i++)
-            frames_allocated[index] = false;
+    return index < max_frames && frame_shares[index] > 0;
 }
 
 /**
  * @brief   How many frames are currently allocated?
  */
 size_t FrameAllocator::get_used_frames_count() {
-    size_t result = 0;
-
-    for (u32 i = 0; i < get_total_frames_count(); i++)
-        if (frames_allocated[i])
-            result++;
-
-    return result;
+    return used_frames;
 }
 
 /**
@@ -139,4 +170,32 @@ size_t FrameAllocator::get_total_frames_count() {
     return total_frames;
 }
 
+/**
+ * @brief   How many frames are needed to hold "num_bytes"? At least one.
+ */
+size_t FrameAllocator::bytes_to_frames(size_t num_bytes) {
+    const size_t num_frames = (num_bytes + get_frame_size() - 1) / get_frame_size();
+    return num_frames > 0 ? num_frames : 1;
+}
+
+bool FrameAllocator::is_allocated(size_t index) {
+    return frames_bitmap[index / BITS_PER_WORD] & (1ULL << (index % BITS_PER_WORD));
+}
+
+void FrameAllocator::mark_allocated(size_t index) {
+    if (is_allocated(index))
+        return;
+
+    frames_bitmap[index / BITS_PER_WORD] |= (1ULL << (index % BITS_PER_WORD));
+    used_frames++;
+}
+
+void FrameAllocator::mark_unused(size_t index) {
+    if (!is_allocated(index))
+        return;
+
+    frames_bitmap[index / BITS_PER_WORD] &= ~(1ULL << (index % BITS_PER_WORD));
+    used_frames--;
+}
+
 } /* namespace memory */
@@ -10,26 +10,50 @@
 
 #include "types.h"
 #include "PageTables.h"
+#include "BuddyAllocator.h"
+#include "PhysicalMemoryMap.h"
 
 namespace memory {
 
+/**
+ * @brief   This class keeps track of physical memory frames. Each frame is represented by a single bit in a bitmap:
+ *          1 means allocated, 0 means free. Free frames themselves are handed out by a buddy allocator,
+ *          so both single frames and contiguous runs are found in O(log n) and freed runs merge back into bigger blocks
+ * @note    Frame (or frame chain) can be shared by cloned address spaces; each extra owner is counted
+ *          and the frame is only released when the last owner frees it
+ * @note    Each allocated chain remembers its buddy order, so a free with wrong size or not at the chain start is ignored
+ * @note    Bitmap, buddy, share counter and order storage are sized at boot to the highest available physical byte and carved out of physical memory itself
+ */
 class FrameAllocator {
 public:
-    static void init(size_t first_available_memory_byte, size_t last_available_memory_byte);
+    static void init(PhysicalMemoryMap& map);
     static ssize_t alloc_frame();
     static void free_frame(size_t physical_address);
     static ssize_t alloc_consecutive_frames(size_t num_bytes);
     static void free_consecutive_frames(size_t physical_address, size_t num_bytes);
+    static bool share_frames(size_t physical_address);
+    static bool is_frame_shared(size_t physical_address);
     static size_t get_used_frames_count();
     static size_t get_total_frames_count();
     static constexpr size_t get_frame_size() { return PageTables::get_page_size(); };
 
 private:
-    static ssize_t find_unused_starting_at(size_t start_index);
-    static size_t check_consecutive_unused_count_at(size_t start_index, size_t required_frames_count);
-
-    static size_t   total_frames;
-    static bool     frames_allocated[]; // each entry maps 1 page
+    static constexpr size_t BITS_PER_WORD   {64};
+    static constexpr u16    MAX_SHARES      {0xFFFF};
+    static constexpr u8     NO_BLOCK        {0xFF};     // "block_orders" value of a frame that does not start an allocated chain
+
+    static size_t bytes_to_frames(size_t num_bytes);
+    static bool is_allocated(size_t index);
+    static void mark_allocated(size_t index);
+    static void mark_unused(size_t index);
+
+    static size_t           max_frames;         // frames 0..max_frames-1 are tracked, holes included
+    static size_t           total_frames;       // frames available for allocation
+    static size_t           used_frames;        // maintained on every alloc/free, so no need to count the bits
+    static u64*             frames_bitmap;      // each bit maps 1 frame
+    static BuddyAllocator   buddy;              // hands out free blocks of 2^order frames
+    static u16*             frame_shares;       // number of extra owners of allocated frame or frame chain, by first frame index
+    static u8*              block_orders;       // buddy order of allocated frame chain, by first frame index
 };
 
 } /* namespace memory */
@@ -15,6 +15,8 @@ namespace memory {
 
 /**
  * @brief   This class provides phys-to-virt and virt-to-phys memory address conversion methods for higher half kernel
+ * @note    Physical 0..1GB is mapped at -2GB together with the kernel image, all physical memory above 1GB is mapped at
+ *          the direct map base (-128TB) by PageTables::map_physical_memory
  */
 class HigherHalf {
 public:
@@ -23,7 +25,10 @@ public:
      */
     template <class T>
     static size_t virt_to_phys(T virtual_addr) {
-        return (size_t)virtual_addr - get_kernel_offset();
+        if ((size_t)virtual_addr >= get_kernel_offset())
+            return (size_t)virtual_addr - get_kernel_offset();
+        else
+            return (size_t)virtual_addr - get_direct_map_base();
     }
 
     /**
@@ -31,7 +36,24 @@ public:
      */
     template <class T>
     static size_t phys_to_virt(T physical_addr) {
-        return (size_t)physical_addr + get_kernel_offset();
+        if ((size_t)physical_addr < get_kernel_static_memory_size())
+            return (size_t)physical_addr + get_kernel_offset();
+        else
+            return (size_t)physical_addr + get_direct_map_base();
+    }
+
+    /**
+     * @brief   Physical memory mapped along with the kernel image at -2GB
+     */
+    static constexpr size_t get_kernel_static_memory_size() {
+        return 1024*1024*1024;
+    }
+
+    /**
+     * @brief   Entire physical memory is mapped at -128TB, the beginning of the upper half of virtual memory (pml4[256])
+     */
+    static constexpr size_t get_direct_map_base() {
+        return 0xFFFF800000000000;
     }
 
     /**
@@ -7,7 +7,7 @@
 
 #include "MemoryManager.h"
 #include "HigherHalf.h"
-#include "KLockGuard.h"
+#include "SpinLock.h"
 
 using namespace multitasking;
 
@@ -15,6 +15,7 @@ namespace memory {
 
 MemoryManager MemoryManager::_instance;
 cstd::AllocationPolicy* MemoryManager::allocation_policy;
+IrqSpinLock MemoryManager::lock {"memory"};
 
 MemoryManager& MemoryManager::instance() {
     return _instance;
@@ -23,9 +24,10 @@ MemoryManager& MemoryManager::instance() {
 /**
  * @brief   Allocate a contiguous, frame-size aligned block of physical memory that can hold "size" bytes, or return nullptr on failure
  * @note    Allocated memory chunk physical address on success, nullptr on failure
+ * @note    Block is taken from buddy allocator so it spans power-of-two frames; free it with the same "size"
  */
 void* MemoryManager::alloc_frames(size_t size) const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     ssize_t phys_addr = FrameAllocator::alloc_consecutive_frames(size);
     if (phys_addr == -1)
@@ -39,17 +41,27 @@ void* MemoryManager::alloc_frames(size_t size) const {
  *          A number of frames necessary to hold "size" bytes will be freed
  */
 void MemoryManager::free_frames(void* address, size_t size) const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     FrameAllocator::free_consecutive_frames((size_t)address, size);
 }
 
+/**
+ * @brief   Add an owner to memory block located at physical address, so it takes one more "free_frames" to release it
+ * @return  False if the block is not allocated or has too many owners already
+ */
+bool MemoryManager::share_frames(void* address) const {
+    LockGuard<IrqSpinLock> guard(lock);
+
+    return FrameAllocator::share_frames((size_t)address);
+}
+
 /**
  * @brief   Allocate and return a memory block virtual address, or return nullptr on failure
  * @note    Memory frames will be allocated by PageFaulHandler
  */
 void* MemoryManager::alloc_virt_memory(size_t size) const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     return allocation_policy->alloc_bytes(size);
 }
@@ -58,7 +70,7 @@ void* MemoryManager::alloc_virt_memory(size_t size) const {
  * @brief   Release memory block located at virtual address
  */
 void MemoryManager::free_virt_memory(void* virtual_address) const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     if (!virtual_address)
         return;
@@ -70,7 +82,7 @@ void MemoryManager::free_virt_memory(void* virtual_address) const {
  * @brief   Get amount of memory left for dynamic allocation.
  */
 size_t MemoryManager::get_free_memory_in_bytes() const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     return allocation_policy->free_memory_in_bytes();
 }
@@ -81,7 +93,7 @@ size_t MemoryManager::get_free_memory_in_bytes() const {
  *          since the first megabytes are used for kernel code/data and multiboot2 structures (eg. 0..2MB in release build, 0..7MB in debug build)
  */
 size_t MemoryManager::get_total_memory_in_bytes() const {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     return allocation_policy->total_memory_in_bytes();
 }
@@ -8,15 +8,18 @@
 #ifndef SRC_MEMORY_MEMORYMANAGER_H_
 #define SRC_MEMORY_MEMORYMANAGER_H_
 
+#include "cstd.h"
 #include "HigherHalf.h"
 #include "FrameAllocator.h"
 #include "AllocationPolicy.h"
+#include "SpinLock.h"
 
 namespace memory {
 
 /**
  * @class   MemoryManager
  * @brief   This guy will manage dynamic memory (new/delete) in the system
+ * @note    Not reentrant; the allocation policy must not allocate nor free while serving the request
  */
 class MemoryManager {
 public:
@@ -24,6 +27,7 @@ public:
 
     void* alloc_frames(size_t size) const;
     void free_frames(void* address, size_t size) const;
+    bool share_frames(void* address) const;
 
     void* alloc_virt_memory(size_t size) const;
     void free_virt_memory(void* address) const;
@@ -33,16 +37,18 @@ public:
 
     /**
      * @brief   Setup how the memory manager will handle memory. This must be done before running any other C/C++ code that needs dynamic memory
-     * @param   first_byte    First physical byte available for allocation. Set it high enough not to overwrite kernel code/data that start at 1MB
-     * @param   last_byte     Last physical byte available for allocation.
+     * @param   map   Physical memory available for allocation. Make sure it doesnt overlap kernel code/data that start at 1MB
+     * @note    Kernel heap is limited to the -1GB..0 virtual window, no matter how much physical memory there is
      */
     template <typename AllocationPolicyType>
-    static void install_allocation_policy(size_t first_phys_byte, size_t last_phys_byte) {
-        FrameAllocator::init(first_phys_byte, last_phys_byte);
+    static void install_allocation_policy(PhysicalMemoryMap map) {
+        PageTables::map_physical_memory(map);
+        FrameAllocator::init(map);
         static char storage[sizeof(AllocationPolicyType)]; // policy is stored here since no dynamic memory is available yet, but we're just working on it :)
 
         size_t dynamic_start = HigherHalf::get_kernel_heap_low_limit();
-        size_t dynamic_end = dynamic_start + (last_phys_byte - first_phys_byte);
+        size_t dynamic_size = min(map.get_available_bytes(), HigherHalf::get_kernel_heap_high_limit() - dynamic_start);
+        size_t dynamic_end = dynamic_start + dynamic_size;
         allocation_policy = new (storage) AllocationPolicyType(dynamic_start, dynamic_end);
     }
 
@@ -51,6 +57,7 @@ private:
 
     static MemoryManager _instance;
     static cstd::AllocationPolicy* allocation_policy;
+    static multitasking::IrqSpinLock lock;     // interrupt handlers allocate too; kernel heap page faults are served without taking it
 };
 
 } /* namespace memory */
@@ -1,9 +1,13 @@
 #ifndef PAGE_FAULT_H
 #define PAGE_FAULT_H
 
+#include "cstd.h"
 #include "HigherHalf.h"
 #include "PageTables.h"
 #include "FrameAllocator.h"
+#include "ZeroedFramePool.h"
+#include "Swap.h"
+#include "AddressSpace.h"
 #include "PageFaultActualReason.h"
 
 namespace memory{
@@ -58,6 +62,10 @@ static hardware::PageFaultActualReason get_page_fault_reason(u64 faulty_address,
     bool caused_by_write = is_flag_set(cpu_error_code, PageFaultErrorCode::WRITE);
     bool page_readonly = !is_flag_set(violated_page, PageAttr::WRITABLE);
     bool readonly_violation = caused_by_write && page_readonly;
+    bool copy_on_write = is_flag_set(violated_page, PageAttr::COPY_ON_WRITE);
+    if (readonly_violation && copy_on_write)
+        return hardware::PageFaultActualReason::COPY_ON_WRITE;
+
     if (readonly_violation)
         return hardware::PageFaultActualReason::READONLY_VIOLATION;
 
@@ -80,26 +88,184 @@ static hardware::PageFaultActualReason get_page_fault_reason(u64 faulty_address,
 }
 
 /**
- * @brief   Allocate missing page
- *          Give WRITABLE permission by default.
- *          This can change in future to provide more detailed control eg. for kernel/elf readonly and read/write data sections.
+ * @brief   Map "virtual_address" 2MB region with a fresh 2MB frame
+ * @note    User accessible frame is zeroed, so no data leaks between address spaces
+ */
+static bool alloc_huge_page(u64* pde, u64 virtual_address, u64 attributes) {
+    s64 frame_phys_addr = FrameAllocator::alloc_consecutive_frames(PageTables::get_huge_page_size());
+    if (frame_phys_addr == -1)
+        return false;
+
+    if (attributes & PageAttr::USER_ACCESSIBLE)
+        ZeroedFramePool::zero_frames(frame_phys_addr, PageTables::get_huge_page_size());
+
+    *pde = frame_phys_addr | PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::HUGE_PAGE | attributes;
+    asm volatile("invlpg (%0)" ::"r" (virtual_address) : "memory");
+    return true;
+}
+
+/**
+ * @brief   Get a zeroed 4KB frame; if no frame is left, take one from a page that gets swapped out
+ * @return  -1 if no frame could be found
+ */
+static ssize_t alloc_zeroed_frame() {
+    ssize_t frame_phys_addr = ZeroedFramePool::alloc_frame();
+    if (frame_phys_addr == -1 && (frame_phys_addr = Swap::swap_out_page()) != -1)
+        ZeroedFramePool::zero_frames(frame_phys_addr, PageTables::get_page_size());
+
+    return frame_phys_addr;
+}
+
+/**
+ * @brief   Map "virtual_address" 4KB page with a fresh, zeroed 4KB frame, allocating the Page Table if needed
+ */
+static bool alloc_small_page(u64 virtual_address, u64 pml4_phys_addr) {
+    u64* pte = PageTables::get_or_alloc_page_table_entry(virtual_address, pml4_phys_addr);
+    if (!pte)
+        return false;
+
+    s64 frame_phys_addr = alloc_zeroed_frame();
+    if (frame_phys_addr == -1)
+        return false;
+
+    *pte = frame_phys_addr | PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::USER_ACCESSIBLE;
+    asm volatile("invlpg (%0)" ::"r" (virtual_address) : "memory");
+    return true;
+}
+
+/**
+ * @brief   Check if any of "as" memory areas covers any byte of "first_byte".."last_byte"
+ */
+static bool is_in_memory_area(const AddressSpace& as, u64 first_byte, u64 last_byte) {
+    for (const MemoryArea& m : as.memory_areas)
+        if (m.first_byte <= last_byte && m.last_byte >= first_byte)
+            return true;
+
+    return false;
+}
+
+/**
+ * @brief   Map "virtual_address" 4KB page with a fresh 4KB frame filled with data of the files mapped at that page
+ * @note    Page can be covered by more than one area, eg. when ELF segments are not page aligned;
+ *          bytes not covered by any file data are zeroed. Page is writable if any of the areas is writable
+ * @note    File position is restored after reading, as the file can also be used with "read" syscall
  */
-static bool alloc_missing_page(u64 virtual_address, u64 pml4_phys_addr) {
-    s64 frame_phys_addr = FrameAllocator::alloc_frame();
+static bool alloc_area_page(u64 virtual_address, u64 pml4_phys_addr, const AddressSpace& as) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    u64* pte = PageTables::get_or_alloc_page_table_entry(virtual_address, pml4_phys_addr);
+    if (!pte)
+        return false;
+
+    s64 frame_phys_addr = alloc_zeroed_frame();
     if (frame_phys_addr == -1)
         return false;
 
-    u64* page_virt_addr = PageTables::get_page_for_virt_address(virtual_address, pml4_phys_addr);
-    *page_virt_addr = frame_phys_addr | PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::HUGE_PAGE;
+    // fill the frame through kernel address, as the page is not mapped yet
+    u8* page_data = (u8*)HigherHalf::phys_to_virt(frame_phys_addr);
+
+    const u64 page_first_byte = virtual_address & ~(PAGE_SIZE - 1);
+    const u64 page_last_byte = page_first_byte + PAGE_SIZE - 1;
+    u64 attributes = PageAttr::PRESENT | PageAttr::USER_ACCESSIBLE;
+    for (const MemoryArea& m : as.memory_areas) {
+        if (m.first_byte > page_last_byte || m.last_byte < page_first_byte)
+            continue;
+
+        if (m.writable)
+            attributes |= PageAttr::WRITABLE;
+
+        if (m.file_size == 0)
+            continue;
+
+        const u64 first_byte = max(page_first_byte, m.first_byte);
+        const u64 last_byte = min(page_last_byte, m.first_byte + m.file_size - 1);
+        if (first_byte > last_byte)
+            continue;
+
+        const u32 count = last_byte - first_byte + 1;
+        const u64 position = m.file->get_position().value;
+        bool seek_ok = (bool)m.file->seek(m.file_offset + first_byte - m.first_byte);
+        bool read_ok = seek_ok && m.file->read(page_data + first_byte - page_first_byte, count).value == count;
+        m.file->seek(position);
+        if (!read_ok) {
+            FrameAllocator::free_frame(frame_phys_addr);
+            return false;
+        }
+    }
+
+    *pte = frame_phys_addr | attributes;
+    asm volatile("invlpg (%0)" ::"r" (virtual_address) : "memory");
+    return true;
+}
+
+/**
+ * @brief   Allocate missing page, or bring it back from swap space if it was swapped out
+ *          Give WRITABLE permission by default; memory area pages are writable only if the area is.
+ * @param   as  Address space of current task group; its page fault counters get updated. Pages of its memory areas are filled from the file or zeroed, one 4KB page at a time.
+ *              User memory 2MB regions that end below the program break are considered large contiguous regions (heap)
+ *              and get mapped with a single 2MB page, unless some 4KB pages are mapped in the region already
+ *              or the region overlaps a memory area. Everything else gets 4KB pages.
+ *              Kernel memory is always mapped with 2MB pages.
+ */
+static bool alloc_missing_page(u64 virtual_address, u64 pml4_phys_addr, AddressSpace& as) {
+    constexpr u64 HUGE_PAGE_SIZE = PageTables::get_huge_page_size();
+
+    u64* pde = PageTables::get_pde_for_virt_address(virtual_address, pml4_phys_addr);
+    if (!pde)
+        return false;
 
     bool is_kernel_address_space = (u64)virtual_address >= HigherHalf::get_kernel_heap_low_limit();
     if (is_kernel_address_space)
-        *page_virt_addr |= PageAttr::GLOBAL_PAGE;
-    else
-        *page_virt_addr |= PageAttr::USER_ACCESSIBLE;
+        return alloc_huge_page(pde, virtual_address, PageAttr::GLOBAL_PAGE);
 
-    asm volatile("invlpg (%0)" ::"r" (virtual_address) : "memory");
+    as.stats.page_faults++;
+    u64* page = PageTables::get_page_for_virt_address(virtual_address, pml4_phys_addr);
+    if (Swap::is_swapped_out(*page)) {
+        as.stats.swap_in_faults++;
+        return Swap::swap_in_page(page, virtual_address);
+    }
+
+    if (is_in_memory_area(as, virtual_address, virtual_address))
+        return alloc_area_page(virtual_address, pml4_phys_addr, as);
+
+    u64 region_start = virtual_address & ~(HUGE_PAGE_SIZE - 1);
+    u64 region_end = region_start + HUGE_PAGE_SIZE;
+    bool is_large_region = (region_end <= as.heap_low_limit) && !(*pde & PageAttr::PRESENT) && !is_in_memory_area(as, region_start, region_end - 1);
+    if (is_large_region && alloc_huge_page(pde, virtual_address, PageAttr::USER_ACCESSIBLE))
+        return true;
+
+    // no 2MB frame left? fall back to 4KB page
+    return alloc_small_page(virtual_address, pml4_phys_addr);
+}
+
+/**
+ * @brief   Give the address space its own, writable copy of the copy-on-write page that contains "virtual_address"
+ *          If the page frame is no longer shared, it is just made writable
+ */
+static bool copy_on_write(u64 virtual_address, u64 pml4_phys_addr) {
+    u64* page = PageTables::get_page_for_virt_address(virtual_address, pml4_phys_addr);
+    if (!page)
+        return false;
+
+    u64 frame_phys_addr = *page & PageTables::FRAME_ADDRESS_MASK;
+    u64 attributes = (*page & ~PageTables::FRAME_ADDRESS_MASK & ~(u64)PageAttr::COPY_ON_WRITE) | PageAttr::WRITABLE;
+    if (FrameAllocator::is_frame_shared(frame_phys_addr)) {
+        bool is_huge_page = *page & PageAttr::HUGE_PAGE;
+        size_t page_size = is_huge_page ? PageTables::get_huge_page_size() : PageTables::get_page_size();
+        s64 copy_phys_addr = FrameAllocator::alloc_consecutive_frames(page_size);
+        if (copy_phys_addr == -1 && !is_huge_page)
+            copy_phys_addr = Swap::swap_out_page();
+
+        if (copy_phys_addr == -1)
+            return false;
+
+        memcpy((void*)HigherHalf::phys_to_virt(copy_phys_addr), (void*)HigherHalf::phys_to_virt(frame_phys_addr), page_size);
+        FrameAllocator::free_consecutive_frames(frame_phys_addr, page_size); // drop this address space ownership
+        frame_phys_addr = copy_phys_addr;
+    }
 
+    *page = frame_phys_addr | attributes;
+    PageTables::invalidate_page(virtual_address, pml4_phys_addr);   // other cpus may hold the read-only entry too
     return true;
 }
 
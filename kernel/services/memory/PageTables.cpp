@@ -9,10 +9,18 @@
 #include "kstd.h"
 #include "PageTables.h"
 #include "HigherHalf.h"
+#include "MemoryManager.h"
+#include "ZeroedFramePool.h"
+#include "CpuInfo.h"
+#include "Smp.h"
 
 namespace memory {
 
 PageTables64  PageTables::kernel_page_tables  __attribute__ ((aligned (4096)));
+bool PageTables::pcid_enabled {false};
+u64  PageTables::used_pcids[PCID_COUNT / 64];
+u32  PageTables::pcid_flush_generation[hardware::PerCpu::MAX_CPUS][PCID_COUNT];
+u32  PageTables::tlb_generation {1};
 
 /**
  * @brief   Map the kernel -2GB virtual memory address space at physical address 0 (where it already is loaded by bootloader)
@@ -22,19 +30,164 @@ PageTables64  PageTables::kernel_page_tables  __attribute__ ((aligned (4096)));
  *          cr3 -> pml4
  *                  -pdpt
  *                     -pde
- *                       -pte (not used when 2MB HUGE pages are used)
+ *                       -pte (not used when 2MB HUGE pages are used; user memory uses it for 4KB pages)
  */
 void PageTables::map_and_load_kernel_address_space() {
+    prepare_higher_half_kernel_page_tables(kernel_page_tables);
+    load_kernel_address_space();
+}
+
+/**
+ * @brief   Configure paging of current cpu and load the kernel address space; application cpus run it
+ *          to get from the boot page tables to the ones prepared by the bootstrap cpu
+ */
+void PageTables::load_kernel_address_space() {
     asm volatile (
             // enable Global Page Extension (CR4 bit 7), so later setting PageAttr::GLOBAL_PAGE takes effect
             // see: http://developer.amd.com/wordpress/media/2012/10/24593_APM_v21.pdf, 5.5.1 Global Pages
             "mov %cr4, %rax ;"
             "or $0x80, %rax ;"
             "mov %rax, %cr4 ;"
+
+            // enable Write Protect (CR0 bit 16), so also kernel writes to read-only user pages fault and copy-on-write pages get copied
+            "mov %cr0, %rax ;"
+            "or $0x10000, %rax ;"
+            "mov %rax, %cr0 ;"
     );
-    prepare_higher_half_kernel_page_tables(kernel_page_tables);
+    setup_page_attribute_table();
     u64 pml4_physical_address = HigherHalf::virt_to_phys(kernel_page_tables.pml4);
     load_address_space(pml4_physical_address);
+    enable_process_context_identifiers();
+}
+
+/**
+ * @brief   Enable Process-Context Identifiers (CR4 bit 17) if the cpu supports them. TLB entries then get tagged with
+ *          the PCID of the address space they come from, and survive switching to another address space and back
+ * @note    Must be done with PCID 0 loaded in cr3
+ * @see     https://www.intel.com/content/dam/www/public/us/en/documents/manuals/64-ia-32-architectures-software-developer-vol-3a-part-1-manual.pdf, 4.10.1 Process-Context Identifiers
+ */
+void PageTables::enable_process_context_identifiers() {
+    if (!hardware::CpuInfo().has_pcid())
+        return;
+
+    asm volatile (
+            "mov %%cr4, %%rax ;"
+            "or $0x20000, %%rax ;"
+            "mov %%rax, %%cr4 ;"
+            :
+            :
+            : "rax"
+    );
+
+    used_pcids[0] = 1;  // PCID 0 is for kernel address space and the address spaces that didnt get a PCID of their own
+    pcid_enabled = true;
+}
+
+/**
+ * @brief   Program Page Attribute Table so that PAT entry 4, selected by PageAttr::WRITE_COMBINING, means write-combining.
+ *          The other entries keep their power-on values, so pages without the PAT bit are cached as before
+ * @note    Every x86-64 cpu supports PAT. No write-combining pages exist yet, so no cache flush is needed
+ * @see     https://www.intel.com/content/dam/www/public/us/en/documents/manuals/64-ia-32-architectures-software-developer-vol-3a-part-1-manual.pdf, 11.12 Page Attribute Table
+ */
+void PageTables::setup_page_attribute_table() {
+    constexpr u32 IA32_PAT = 0x277;
+    constexpr u64 PAT_ENTRIES = 0x0007040100070406; // PA0..PA7 = WB, WT, UC-, UC, WC, WT, UC-, UC
+
+    asm volatile("wrmsr" : : "c"(IA32_PAT), "a"((u32)PAT_ENTRIES), "d"((u32)(PAT_ENTRIES >> 32)));
+}
+
+/**
+ * @brief   Map physical memory above 1GB at HigherHalf::get_direct_map_base() with 2MB pages,
+ *          so HigherHalf::phys_to_virt can reach every available frame
+ * @param   map Available physical memory; page tables for the mapping are carved out of it, from below 1GB that is already mapped.
+ *          Memory that could not be mapped is truncated off the map
+ * @note    Only 2MB chunks that contain available memory are mapped; holes like PCI memory windows stay unmapped
+ */
+void PageTables::map_physical_memory(PhysicalMemoryMap& map) {
+    const u16 PRESENT_WRITABLE = PageAttr::PRESENT | PageAttr::WRITABLE;
+    const u16 PRESENT_WRITABLE_HUGE_GLOBAL = PRESENT_WRITABLE | PageAttr::HUGE_PAGE | PageAttr::GLOBAL_PAGE;
+    const size_t ONE_GB = HigherHalf::get_kernel_static_memory_size();
+
+    if (map.get_last_byte() < ONE_GB)
+        return; // all memory already mapped at -2GB
+
+    // single pdpt maps 512GB
+    const size_t gigabytes_count = min(map.get_last_byte() / ONE_GB + 1, (size_t)512);
+    const ssize_t pdpt_phys_addr = map.carve(sizeof(PageTable4K), ONE_GB);
+    if (pdpt_phys_addr == -1) {
+        map.truncate(ONE_GB - 1);
+        return;
+    }
+
+    u64* pdpt = (u64*)HigherHalf::phys_to_virt(pdpt_phys_addr);
+    memset(pdpt, 0, sizeof(PageTable4K));
+
+    size_t gb;
+    for (gb = 1; gb < gigabytes_count; gb++) {
+        const ssize_t pde_phys_addr = map.carve(sizeof(PageTable4K), ONE_GB);
+        if (pde_phys_addr == -1)
+            break;
+
+        u64* pde = (u64*)HigherHalf::phys_to_virt(pde_phys_addr);
+        for (u16 i = 0; i < 512; i++) {
+            const size_t first_byte = gb * ONE_GB + i * HUGE_PAGE_SIZE;
+            pde[i] = map.overlaps(first_byte, first_byte + HUGE_PAGE_SIZE - 1) ? first_byte | PRESENT_WRITABLE_HUGE_GLOBAL : 0;
+        }
+
+        pdpt[gb] = pde_phys_addr | PRESENT_WRITABLE;
+    }
+
+    map.truncate(gb * ONE_GB - 1);
+    kernel_page_tables.pml4[DIRECT_MAP_PML4_INDEX] = pdpt_phys_addr | PRESENT_WRITABLE;
+}
+
+/**
+ * @brief   Map physical memory that is not available RAM, like ACPI tables or Local APIC registers, at
+ *          HigherHalf::get_direct_map_base() with 2MB pages, so HigherHalf::phys_to_virt can reach it.
+ *          Memory below 1GB is mapped at -2GB already
+ * @param   is_uncached True for device registers
+ * @return  False if no memory for the page tables
+ * @note    Must be done before any user address space gets created, as they copy the direct map pml4 entry
+ */
+bool PageTables::map_reserved_memory(size_t phys_addr, size_t num_bytes, bool is_uncached) {
+    const u16 PRESENT_WRITABLE = PageAttr::PRESENT | PageAttr::WRITABLE;
+    const u16 PRESENT_WRITABLE_HUGE_GLOBAL = PRESENT_WRITABLE | PageAttr::HUGE_PAGE | PageAttr::GLOBAL_PAGE;
+    const u16 UNCACHED = PageAttr::CACHE_DISABLE | PageAttr::WRITE_THROUGH;
+    const size_t ONE_GB = HigherHalf::get_kernel_static_memory_size();
+
+    u64& pml4_entry = kernel_page_tables.pml4[DIRECT_MAP_PML4_INDEX];
+    const size_t first_page = phys_addr & ~(HUGE_PAGE_SIZE - 1);
+    for (size_t page = first_page; page < phys_addr + num_bytes; page += HUGE_PAGE_SIZE) {
+        if (page < ONE_GB)
+            continue;
+
+        if (!pml4_entry) {
+            const ssize_t pdpt_phys_addr = ZeroedFramePool::alloc_frame();
+            if (pdpt_phys_addr == -1)
+                return false;
+
+            pml4_entry = pdpt_phys_addr | PRESENT_WRITABLE;
+        }
+
+        // single pdpt maps 512GB
+        u64* pdpt = (u64*)HigherHalf::phys_to_virt(pml4_entry & FRAME_ADDRESS_MASK);
+        u64& pdpt_entry = pdpt[(page / ONE_GB) % 512];
+        if (!pdpt_entry) {
+            const ssize_t pde_phys_addr = ZeroedFramePool::alloc_frame();
+            if (pde_phys_addr == -1)
+                return false;
+
+            pdpt_entry = pde_phys_addr | PRESENT_WRITABLE;
+        }
+
+        // 2MB chunk already mapped, eg. available memory
+        u64* pde = (u64*)HigherHalf::phys_to_virt(pdpt_entry & FRAME_ADDRESS_MASK);
+        u64& pde_entry = pde[(page / HUGE_PAGE_SIZE) % 512];
+        if (!pde_entry)
+            pde_entry = page | PRESENT_WRITABLE_HUGE_GLOBAL | (is_uncached ? UNCACHED : 0);
+    }
+
+    return true;
 }
 
 /**
@@ -59,13 +212,48 @@ void PageTables::map_elf_address_space(size_t pml4_phys_addr) {
  * @brief   Setup page table entry for "virtual_address" to be a stack guard,
  *          so accessing it can be recognized as stack overflow when page fault occurs
  * @param   virtual_address Address that maps to the page supposed to be used as stack guard page
+ * @return  False if no memory for the page table
  */
-void PageTables::map_stack_guard_page(size_t virtual_address, size_t pml4_phys_addr) {
+bool PageTables::map_stack_guard_page(size_t virtual_address, size_t pml4_phys_addr) {
+    u64* page = get_or_alloc_page_table_entry(virtual_address, pml4_phys_addr);
+    if (!page)
+        return false;
+
+    const bool was_present = (*page & PageAttr::PRESENT);
+    *page = PageAttr::STACK_GUARD_PAGE;
+    if (was_present)
+        invalidate_page(virtual_address, pml4_phys_addr);
+    return true;
+}
+
+/**
+ * @brief   Mark page containing "virtual_address" as not present and drop its stale TLB entry
+ * @note    Frame the page was mapped to is not released here
+ */
+void PageTables::unmap_page(size_t virtual_address, size_t pml4_phys_addr) {
     if (u64* page = get_page_for_virt_address(virtual_address, pml4_phys_addr)) {
-        *page = PageAttr::STACK_GUARD_PAGE ;
+        *page = 0;
+        invalidate_page(virtual_address, pml4_phys_addr);
     }
 }
 
+/**
+ * @brief   Drop stale TLB entry of the page containing "virtual_address" in "pml4_phys_addr" address space.
+ *          Entries of non-current address space cant be dropped one by one; instead, every PCID gets its TLB entries
+ *          dropped on its next load. Other cpus drop all their TLB entries
+ */
+void PageTables::invalidate_page(size_t virtual_address, size_t pml4_phys_addr) {
+    u64 cr3;
+    asm volatile("mov %%cr3, %0" : "=r"(cr3));
+
+    if ((cr3 & ~4095) == pml4_phys_addr)
+        asm volatile("invlpg (%0)" : : "r"(virtual_address) : "memory");
+    else
+        tlb_generation++;
+
+    hardware::Smp::shootdown_tlb();
+}
+
 /**
  * @brief   Fill PageTables64 with mapping of -2..-1GB virt addresses to 0..1GB phys addresses
  * @note    Kernel memory is not accessible from user space
@@ -97,6 +285,7 @@ void PageTables::prepare_elf_page_tables(PageTables64& pt) {
     pt.pml4[511] = HigherHalf::virt_to_phys(kernel_page_tables.pdpt)                | PRESENT_WRITABLE;     // last 512 GB chunk
     pt.pdpt[510] = HigherHalf::virt_to_phys(kernel_page_tables.pde_kernel_static)   | PRESENT_WRITABLE;     // -2BG..-1GB chunk
     pt.pdpt[511] = HigherHalf::virt_to_phys(kernel_page_tables.pde_kernel_dynamic)  | PRESENT_WRITABLE;     // -1GB..0GB chunk
+    pt.pml4[DIRECT_MAP_PML4_INDEX] = kernel_page_tables.pml4[DIRECT_MAP_PML4_INDEX];                        // physical memory above 1GB
     // specific frame allocation in pde_user for the lower 1GB will happen in PageFault handler
 }
 
@@ -109,21 +298,123 @@ size_t PageTables::get_kernel_pml4_phys_addr() {
 
 /**
  * @brief   Load pml4_physical_address(page tables root) into cr3, effectively setting new memory address space
+ * @param   pcid PCID of the address space. TLB entries of a PCID other than 0 are kept, unless they may have gone stale
+ *          since last load; PCID 0 always starts with a clean TLB
+ */
+void PageTables::load_address_space(size_t pml4_physical_address, u16 pcid) {
+    u32& flush_generation = pcid_flush_generation[hardware::PerCpu::current().index][pcid];
+    u64 cr3 = pml4_physical_address | pcid;
+    if (pcid != 0 && flush_generation == tlb_generation)
+        cr3 |= CR3_NOFLUSH;
+    else
+        flush_generation = tlb_generation;
+
+    asm volatile (
+            "mov %%rax, %%cr3       ;"
+            :
+            : "a"(cr3)
+            : "memory"
+    );
+}
+
+/**
+ * @brief   Get PCID for new address space
+ * @return  0 if PCIDs are not enabled or all taken; such address space has its TLB entries dropped on every load
+ */
+u16 PageTables::alloc_pcid() {
+    if (!pcid_enabled)
+        return 0;
+
+    for (u32 i = 0; i < PCID_COUNT / 64; i++) {
+        if (used_pcids[i] == ~0ULL)
+            continue;
+
+        const u16 pcid = i * 64 + __builtin_ctzll(~used_pcids[i]);
+        used_pcids[i] |= 1ULL << (pcid % 64);
+        for (auto& cpu_flush_generation : pcid_flush_generation)
+            cpu_flush_generation[pcid] = 0; // TLB may still hold entries of the previous PCID owner
+        return pcid;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   Give back PCID of released address space, so it can be used by another one
  */
-void PageTables::load_address_space(size_t pml4_physical_address) {
+void PageTables::release_pcid(u16 pcid) {
+    if (pcid == 0)
+        return;
+
+    used_pcids[pcid / 64] &= ~(1ULL << (pcid % 64));
+}
+
+bool PageTables::is_pcid_enabled() {
+    return pcid_enabled;
+}
+
+/**
+ * @brief   Drop all non-global TLB entries of current address space, so changes to its page tables take effect.
+ *          Other cpus drop all their TLB entries
+ */
+void PageTables::flush_tlb() {
     asm volatile (
+            "mov %%cr3, %%rax       ;"
             "mov %%rax, %%cr3       ;"
             :
-            : "a"(pml4_physical_address)
             :
+            : "rax", "memory"
     );
+
+    hardware::Smp::shootdown_tlb();
 }
 
 /**
  * @brief   Get Kernel space virtual address of page in "pml4_phys_addr" address space that contains "virtual_address"
  *          or nullptr if "virtual_address" is outside of the address space
+ * @note    This is the 4KB page table entry if the 2MB region containing "virtual_address" is split into 4KB pages,
+ *          page directory entry otherwise
  */
 u64* PageTables::get_page_for_virt_address(size_t virtual_address, size_t pml4_phys_addr) {
+    u64* pde = get_pde_for_virt_address(virtual_address, pml4_phys_addr);
+    if (!pde)
+        return nullptr;
+
+    const bool is_page_table = (*pde & PageAttr::PRESENT) && !(*pde & PageAttr::HUGE_PAGE);
+    if (!is_page_table)
+        return pde;
+
+    PageTable4K* pt = (PageTable4K*)HigherHalf::phys_to_virt(*pde & FRAME_ADDRESS_MASK);
+    return &pt->pte[(virtual_address >> 12) & 511];
+}
+
+/**
+ * @brief   Get Kernel space virtual address of page table entry for "virtual_address", allocating the 4KB Page Table if needed
+ * @return  nullptr if no memory for the Page Table, or the region is already mapped with a 2MB page
+ */
+u64* PageTables::get_or_alloc_page_table_entry(size_t virtual_address, size_t pml4_phys_addr) {
+    const u16 PRESENT_WRITABLE_USERSPACE = PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::USER_ACCESSIBLE;
+
+    u64* pde = get_pde_for_virt_address(virtual_address, pml4_phys_addr);
+    if (!pde || (*pde & PageAttr::HUGE_PAGE))
+        return nullptr;
+
+    if (!(*pde & PageAttr::PRESENT)) {
+        ssize_t pt_phys_addr = ZeroedFramePool::alloc_frame();
+        if (pt_phys_addr == -1)
+            return nullptr;
+
+        *pde = pt_phys_addr | PRESENT_WRITABLE_USERSPACE; // access rights are narrowed down by page table entries
+    }
+
+    return get_page_for_virt_address(virtual_address, pml4_phys_addr);
+}
+
+/**
+ * @brief   Get Kernel space virtual address of page directory entry in "pml4_phys_addr" address space that maps "virtual_address"
+ *          or nullptr if "virtual_address" is outside of the address space
+ */
+u64* PageTables::get_pde_for_virt_address(size_t virtual_address, size_t pml4_phys_addr) {
     u16 pml4_index = (virtual_address >> 39) & 511;
     u16 pdpt_index = (virtual_address >> 30) & 511;
     u16 pde_index = (virtual_address >> 21) & 511;
@@ -135,12 +426,12 @@ u64* PageTables::get_page_for_virt_address(size_t virtual_address, size_t pml4_p
 
     if (pml4_virt_addr[pml4_index] == 0)
         return nullptr;
-    u64* pdpt_virt_addr = (u64*)HigherHalf::phys_to_virt(pml4_virt_addr[pml4_index] & ~4095); // & ~4095 to remove page flags
+    u64* pdpt_virt_addr = (u64*)HigherHalf::phys_to_virt(pml4_virt_addr[pml4_index] & FRAME_ADDRESS_MASK);
 
     if (pdpt_virt_addr[pdpt_index] == 0)
         return nullptr;
 
-    u64* pde_virt_addr =  (u64*)HigherHalf::phys_to_virt(pdpt_virt_addr[pdpt_index] & ~4095); // & ~4095 to remove page flags
+    u64* pde_virt_addr =  (u64*)HigherHalf::phys_to_virt(pdpt_virt_addr[pdpt_index] & FRAME_ADDRESS_MASK);
 
     return &pde_virt_addr[pde_index];
 }
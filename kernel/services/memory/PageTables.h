@@ -9,6 +9,8 @@
 #define SRC_HARDWARE_PAGETABLES_H_
 
 #include "types.h"
+#include "PhysicalMemoryMap.h"
+#include "PerCpu.h"
 
 namespace memory {
 
@@ -21,9 +23,18 @@ enum PageAttr {
     PRESENT             = 1,    // page is mapped to physical address
     WRITABLE            = 2,    // page can be read/written
     USER_ACCESSIBLE     = 4,    // page can be accessed from protection ring 3 (user space)
+    ACCESSED            = 32,   // set by cpu when the page is read or written; cleared by Swap when looking for pages to swap out
+    WRITE_THROUGH       = 8,    // writes go straight to memory
+    CACHE_DISABLE       = 16,   // page is not cached; for device registers
+    DIRTY               = 64,   // set by cpu when the page is written
     HUGE_PAGE           = 128,  // page is 2MB (if used in pde) or 1GB (if used in pdpt) instead of standard 4096 bytes
+    WRITE_COMBINING     = 128,  // 4KB page only (pte); PAT bit, selects PAT entry 4 that is programmed as write-combining
     GLOBAL_PAGE         = 256,  // page is shared across processes (useful for kernel pages)
     STACK_GUARD_PAGE    = 512,  // page is a stack guard; together with "non present" allows for detection of stack overflows
+    COPY_ON_WRITE       = 1024, // page frame is shared by cloned address spaces; together with "non writable" gets copied on write
+    SHARED_MEMORY       = 2048, // page frame belongs to shared memory segment; stays shared and writable in cloned address spaces
+    DEVICE_MEMORY       = 1ULL << 52,   // page maps device memory, not a frame from FrameAllocator; never freed nor copied on write
+    SWAPPED_OUT         = 1ULL << 53,   // page is swapped out; together with "non present" the frame address bits hold swap slot number
 };
 
 struct PageTables64 {
@@ -31,7 +42,14 @@ struct PageTables64 {
     u64  pdpt[512];                 // Page Directory Pointer Table
     u64  pde_kernel_static[512];    // Page Directory Entry for 2MB pages; identity map kernel [-2GB..-1GB] virt -> [0GB..1GB] phys
     u64  pde_kernel_dynamic[512];   // Page Directory Entry for 2MB pages; map kernel -1GB..0GB -> mapped by PageFaultHandler
-    u64  pde_user[512];             // Page Directory Entry for 2MB pages; map elf [0GB..1GB] virt -> mapped by PageFaultHandler
+    u64  pde_user[512];             // Page Directory Entry for 2MB pages or 4KB Page Tables; map elf [0GB..1GB] virt -> mapped by PageFaultHandler
+};
+
+/**
+ * @brief   Page Table; maps a 2MB region of user memory with 4KB pages. Allocated on demand, one frame each
+ */
+struct PageTable4K {
+    u64  pte[512];
 };
 
 /**
@@ -40,18 +58,42 @@ struct PageTables64 {
 class PageTables {
 public:
     static void map_and_load_kernel_address_space();
+    static void load_kernel_address_space();
+    static void map_physical_memory(PhysicalMemoryMap& map);
+    static bool map_reserved_memory(size_t phys_addr, size_t num_bytes, bool is_uncached);
     static void map_elf_address_space(size_t pml4_phys_addr);
-    static void map_stack_guard_page(size_t virtual_address, size_t pml4_phys_addr);
+    static bool map_stack_guard_page(size_t virtual_address, size_t pml4_phys_addr);
+    static void unmap_page(size_t virtual_address, size_t pml4_phys_addr);
+    static u64* get_or_alloc_page_table_entry(size_t virtual_address, size_t pml4_phys_addr);
     static size_t get_kernel_pml4_phys_addr();
-    static void load_address_space(size_t pml4_physical_address);
+    static void load_address_space(size_t pml4_physical_address, u16 pcid = 0);
+    static void flush_tlb();
+    static u16 alloc_pcid();
+    static void release_pcid(u16 pcid);
+    static bool is_pcid_enabled();
+    static void invalidate_page(size_t virtual_address, size_t pml4_phys_addr);
     static u64* get_page_for_virt_address(size_t virtual_address, size_t pml4_phys_addr);
+    static u64* get_pde_for_virt_address(size_t virtual_address, size_t pml4_phys_addr);
     static size_t bytes_to_pages(size_t num_bytes);
     static constexpr size_t get_page_size() { return PAGE_SIZE; };
+    static constexpr size_t get_huge_page_size() { return HUGE_PAGE_SIZE; };
+
+    static constexpr u64    FRAME_ADDRESS_MASK = 0x000FFFFFFFFFF000;   // page entry bits that hold the frame physical address
 
 private:
-    static constexpr size_t PAGE_SIZE = 2 * 1024 * 1024; // 2MB huge pages
+    static constexpr size_t PAGE_SIZE = 4 * 1024;               // 4KB pages, for user memory
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;   // 2MB huge pages, for kernel and large user regions
+    static constexpr u16    DIRECT_MAP_PML4_INDEX = 256;        // physical memory above 1GB is mapped here
+    static constexpr u32    PCID_COUNT = 4096;                  // cr3 bits 0..11
+    static constexpr u64    CR3_NOFLUSH = 1ULL << 63;           // keep the TLB entries tagged with the loaded PCID
     static PageTables64 kernel_page_tables;
+    static bool pcid_enabled;
+    static u64  used_pcids[PCID_COUNT / 64];                    // bit set = PCID taken by an address space; PCID 0 is for untagged ones
+    static u32  pcid_flush_generation[hardware::PerCpu::MAX_CPUS][PCID_COUNT]; // "tlb_generation" when the PCID TLB entries were last dropped, per cpu
+    static u32  tlb_generation;                                 // bumped when page tables of non-current address space lose a page
 
+    static void setup_page_attribute_table();
+    static void enable_process_context_identifiers();
     static void prepare_higher_half_kernel_page_tables(PageTables64& pt);
     static void prepare_elf_page_tables(PageTables64& pt);
 };
@@ -0,0 +1,113 @@
+/**
+ *   @file: PhysicalMemoryMap.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "PhysicalMemoryMap.h"
+#include "PageTables.h"
+
+namespace memory {
+
+/**
+ * @brief   Add "first_byte".."last_byte" range to the map, shrunk to whole frames
+ * @note    Ranges too small to hold a frame, or not fitting in the map, are ignored
+ */
+void PhysicalMemoryMap::add_region(size_t first_byte, size_t last_byte) {
+    const size_t FRAME_SIZE = PageTables::get_page_size();
+    const size_t first = (first_byte + FRAME_SIZE - 1) / FRAME_SIZE * FRAME_SIZE;
+    const size_t end = (last_byte + 1) / FRAME_SIZE * FRAME_SIZE;
+    if (last_byte < first_byte || end <= first || regions_count == MAX_REGIONS)
+        return;
+
+    // keep the regions sorted
+    u32 i = regions_count;
+    while (i > 0 && regions[i - 1].first_byte > first) {
+        regions[i] = regions[i - 1];
+        i--;
+    }
+
+    regions[i] = {first, end - 1};
+    regions_count++;
+}
+
+/**
+ * @brief   Take "num_bytes" rounded up to whole frames off the first region that can hold them below "below_byte"
+ * @return  Physical address of the taken memory, or -1 if no region big enough
+ * @note    This is for allocating memory management structures themselves, before FrameAllocator is up
+ */
+ssize_t PhysicalMemoryMap::carve(size_t num_bytes, size_t below_byte) {
+    const size_t FRAME_SIZE = PageTables::get_page_size();
+    num_bytes = (num_bytes + FRAME_SIZE - 1) / FRAME_SIZE * FRAME_SIZE;
+
+    for (u32 i = 0; i < regions_count; i++) {
+        PhysicalMemoryRegion& r = regions[i];
+        if (r.last_byte - r.first_byte + 1 < num_bytes || r.first_byte + num_bytes > below_byte)
+            continue;
+
+        const size_t result = r.first_byte;
+        r.first_byte += num_bytes;
+
+        // region used up entirely; drop it
+        if (r.first_byte > r.last_byte) {
+            for (u32 k = i; k + 1 < regions_count; k++)
+                regions[k] = regions[k + 1];
+            regions_count--;
+        }
+
+        return result;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief   Drop all the memory past "last_byte"
+ */
+void PhysicalMemoryMap::truncate(size_t last_byte) {
+    while (regions_count > 0 && regions[regions_count - 1].first_byte > last_byte)
+        regions_count--;
+
+    if (regions_count > 0 && regions[regions_count - 1].last_byte > last_byte)
+        regions[regions_count - 1].last_byte = last_byte;
+}
+
+/**
+ * @brief   Check if any of "first_byte".."last_byte" is available memory
+ */
+bool PhysicalMemoryMap::overlaps(size_t first_byte, size_t last_byte) const {
+    for (u32 i = 0; i < regions_count; i++)
+        if (regions[i].first_byte <= last_byte && regions[i].last_byte >= first_byte)
+            return true;
+
+    return false;
+}
+
+/**
+ * @brief   Highest available physical byte, or 0 if the map is empty
+ */
+size_t PhysicalMemoryMap::get_last_byte() const {
+    return regions_count > 0 ? regions[regions_count - 1].last_byte : 0;
+}
+
+/**
+ * @brief   Sum of all the regions sizes
+ */
+size_t PhysicalMemoryMap::get_available_bytes() const {
+    size_t total = 0;
+    for (u32 i = 0; i < regions_count; i++)
+        total += regions[i].last_byte - regions[i].first_byte + 1;
+
+    return total;
+}
+
+u32 PhysicalMemoryMap::get_regions_count() const {
+    return regions_count;
+}
+
+const PhysicalMemoryRegion& PhysicalMemoryMap::get_region(u32 index) const {
+    return regions[index];
+}
+
+} /* namespace memory */
@@ -0,0 +1,48 @@
+/**
+ *   @file: PhysicalMemoryMap.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef SRC_MEMORY_PHYSICALMEMORYMAP_H_
+#define SRC_MEMORY_PHYSICALMEMORYMAP_H_
+
+#include "types.h"
+
+namespace memory {
+
+/**
+ * @brief   Range of physical memory available for use, frame aligned
+ */
+struct PhysicalMemoryRegion {
+    size_t  first_byte;
+    size_t  last_byte;
+};
+
+/**
+ * @brief   This class is a list of physical memory regions available for use, as reported by the boot loader.
+ *          Regions are kept sorted by address; holes between them are reserved memory or no memory at all.
+ * @note    No dynamic memory is used, as the map is built before the kernel heap exists
+ */
+class PhysicalMemoryMap {
+public:
+    static constexpr u32 MAX_REGIONS    {32};
+
+    void add_region(size_t first_byte, size_t last_byte);
+    ssize_t carve(size_t num_bytes, size_t below_byte);
+    void truncate(size_t last_byte);
+    bool overlaps(size_t first_byte, size_t last_byte) const;
+    size_t get_last_byte() const;
+    size_t get_available_bytes() const;
+    u32 get_regions_count() const;
+    const PhysicalMemoryRegion& get_region(u32 index) const;
+
+private:
+    PhysicalMemoryRegion    regions[MAX_REGIONS];
+    u32                     regions_count   {0};
+};
+
+} /* namespace memory */
+
+#endif /* SRC_MEMORY_PHYSICALMEMORYMAP_H_ */
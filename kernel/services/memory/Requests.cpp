@@ -0,0 +1,14 @@
+/**
+ *   @file: Requests.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "Requests.h"
+
+namespace memory {
+
+memory::Requests* requests {nullptr};
+
+}
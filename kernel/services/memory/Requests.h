@@ -0,0 +1,46 @@
+/**
+ *   @file: Requests.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MEMORY_REQUESTS_H_
+#define KERNEL_SERVICES_MEMORY_REQUESTS_H_
+
+#include "StringUtils.h"
+
+namespace memory {
+
+/**
+ * @brief	This interface allows the component to access the outer world services,
+ * 			without creating unnecessary dependencies to the outer world components.
+ * 			It is to be implemented in the project configuration unit
+ * 			that wires all components together ("main" or similar).
+ */
+class Requests {
+public: // Boilerplate
+	virtual ~Requests() = default;
+	template<typename ... Args>
+	void log(const char* fmt, const Args& ... args) {
+		char line[256];	// longer lines get cut off; formatting into the stack keeps logging allocation free
+		cstd::StringUtils::format_to(line, sizeof(line), fmt, args...);
+		log(line);
+	}
+	void log(const cstd::string& s) { log(s.c_str()); }
+
+public: // Actual methods to implement
+	virtual void log(const char* s) = 0;
+	virtual bool read_swap_page(size_t slot, void* page) = 0;
+	virtual bool write_swap_page(size_t slot, const void* page) = 0;
+};
+
+/**
+ * @brief	This requests interface is to be assigned with actual Requests implementation
+			in the project configuration unit that wires all components together ("main" or similar).
+ */
+extern Requests* requests;
+
+}
+
+#endif /* KERNEL_SERVICES_MEMORY_REQUESTS_H_ */
@@ -0,0 +1,131 @@
+/**
+ *   @file: SharedMemory.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "SharedMemory.h"
+#include "PageTables.h"
+#include "FrameAllocator.h"
+#include "ZeroedFramePool.h"
+#include "AddressSpaceManager.h"
+#include "KLockGuard.h"
+
+using namespace cstd;
+using namespace utils;
+using namespace middlespace;
+using namespace multitasking;
+
+namespace memory {
+
+HashMap<string, SharedSegment> SharedMemory::segments;
+
+/**
+ * @brief   Map "num_bytes" of segment "name" into "as" address space, creating the segment if it doesnt exist yet.
+ *          All the pages get mapped right away, so no page fault ever happens in the segment
+ * @param   num_bytes Size of the segment to create, 0 means entire segment when mapping existing one
+ * @return  First byte of the mapping on success
+ *          EC_INVAL if "num_bytes" exceeds existing segment size or new segment is to be of 0 size
+ *          EC_NOMEM if no memory left
+ */
+SyscallResult<u64> SharedMemory::map(AddressSpace& as, const string& name, u64 num_bytes) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+    KLockGuard lock;    // prevent reschedule
+
+    SharedSegment* segment = find(name);
+    if (!segment) {
+        if (auto result = create(name, num_bytes))
+            segment = result.value;
+        else
+            return {result.ec};
+    }
+
+    if (num_bytes > segment->num_bytes)
+        return {ErrorCode::EC_INVAL};
+
+    if (num_bytes == 0)
+        num_bytes = segment->num_bytes;
+
+    // reserve virtual memory
+    u64 first_byte;
+    if (auto result = map_area(as, num_bytes, true, {}, 0))
+        first_byte = result.value;
+    else
+        return {result.ec};
+
+    // map segment frames; each page holds a share of its frame, given back when the page is released
+    for (u64 offset = 0; offset < num_bytes; offset += PAGE_SIZE) {
+        const u64 frame_phys_addr = segment->frames[offset / PAGE_SIZE];
+        u64* pte = PageTables::get_or_alloc_page_table_entry(first_byte + offset, as.pml4_phys_addr);
+        if (!pte || !FrameAllocator::share_frames(frame_phys_addr)) {
+            unmap_area(as, first_byte, num_bytes);
+            return {ErrorCode::EC_NOMEM};
+        }
+
+        *pte = frame_phys_addr | PageAttr::PRESENT | PageAttr::WRITABLE | PageAttr::USER_ACCESSIBLE | PageAttr::SHARED_MEMORY;
+    }
+
+    return {first_byte};
+}
+
+/**
+ * @brief   Remove segment "name". Its memory stays available to the address spaces that have it mapped,
+ *          and is released when the last of them unmaps it
+ * @return  EC_NOENT if no such segment
+ */
+SyscallResult<void> SharedMemory::unlink(const string& name) {
+    KLockGuard lock;    // prevent reschedule
+
+    SharedSegment* segment = find(name);
+    if (!segment)
+        return {ErrorCode::EC_NOENT};
+
+    release_frames(*segment);
+    segments.erase(name);
+    return {ErrorCode::EC_OK};
+}
+
+SharedSegment* SharedMemory::find(const string& name) {
+    auto found = segments.find(name);
+    if (found == segments.end())
+        return nullptr;
+
+    return &found->second;
+}
+
+/**
+ * @brief   Create new segment of zeroed frames, able to hold "num_bytes"
+ */
+SyscallResult<SharedSegment*> SharedMemory::create(const string& name, u64 num_bytes) {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    if (num_bytes == 0 || name.empty())
+        return {ErrorCode::EC_INVAL};
+
+    SharedSegment segment {name, (num_bytes + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1), {}};
+    for (u64 offset = 0; offset < segment.num_bytes; offset += PAGE_SIZE) {
+        ssize_t frame_phys_addr = ZeroedFramePool::alloc_frame();
+        if (frame_phys_addr == -1) {
+            release_frames(segment);
+            return {ErrorCode::EC_NOMEM};
+        }
+        segment.frames.push_back(frame_phys_addr);
+    }
+
+    SharedSegment& result = segments[name];
+    result = std::move(segment);
+    return {&result};
+}
+
+/**
+ * @brief   Give back the segment share of its frames
+ */
+void SharedMemory::release_frames(SharedSegment& segment) {
+    for (u64 frame_phys_addr : segment.frames)
+        FrameAllocator::free_frame(frame_phys_addr);
+
+    segment.frames.clear();
+}
+
+} /* namespace memory */
@@ -0,0 +1,49 @@
+/**
+ *   @file: SharedMemory.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MEMORY_SHAREDMEMORY_H_
+#define KERNEL_SERVICES_MEMORY_SHAREDMEMORY_H_
+
+#include "String.h"
+#include "Vector.h"
+#include "HashMap.h"
+#include "AddressSpace.h"
+#include "SyscallResult.h"
+
+namespace memory {
+
+/**
+ * @brief   Named set of physical frames that can be mapped into many address spaces at once
+ */
+struct SharedSegment {
+    cstd::string        name;
+    u64                 num_bytes;  // multiply of frame size
+    cstd::vector<u64>   frames;     // physical address of each frame of the segment
+};
+
+/**
+ * @brief   This class keeps the shared memory segments. Segment frames are mapped directly into the task group address spaces,
+ *          so data written by one task group is immediately seen by the others, with no copying.
+ *          Each mapping and the segment itself own a share of every frame; the frames get released when the segment is unlinked
+ *          and the last address space unmaps them or gets released
+ */
+class SharedMemory {
+public:
+    static utils::SyscallResult<u64> map(AddressSpace& as, const cstd::string& name, u64 num_bytes);
+    static utils::SyscallResult<void> unlink(const cstd::string& name);
+
+private:
+    static SharedSegment* find(const cstd::string& name);
+    static utils::SyscallResult<SharedSegment*> create(const cstd::string& name, u64 num_bytes);
+    static void release_frames(SharedSegment& segment);
+
+    static cstd::HashMap<cstd::string, SharedSegment> segments;    // by segment name
+};
+
+} /* namespace memory */
+
+#endif /* KERNEL_SERVICES_MEMORY_SHAREDMEMORY_H_ */
@@ -0,0 +1,281 @@
+/**
+ *   @file: Swap.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "cstd.h"
+#include "Swap.h"
+#include "Requests.h"
+#include "PageTables.h"
+#include "HigherHalf.h"
+#include "FrameAllocator.h"
+
+namespace memory {
+
+u16*                Swap::slot_users {nullptr};
+size_t              Swap::slots_count {0};
+size_t              Swap::used_slots_count {0};
+size_t              Swap::next_slot_hint {0};
+size_t              Swap::swapped_out_count {0};
+size_t              Swap::swapped_in_count {0};
+cstd::vector<u64>   Swap::address_spaces;
+size_t              Swap::clock_address_space {0};
+u64                 Swap::clock_page {0};
+
+/**
+ * @brief   Make "num_slots" of 4KB swap space available for swapping pages out
+ * @return  False if swap is installed already or there is no memory for slot bookkeeping
+ */
+bool Swap::install(size_t num_slots) {
+    if (is_installed() || num_slots == 0)
+        return false;
+
+    slot_users = new u16[num_slots];
+    if (!slot_users)
+        return false;
+
+    memset(slot_users, 0, num_slots * sizeof(u16));
+    slots_count = num_slots;
+    return true;
+}
+
+bool Swap::is_installed() {
+    return slots_count > 0;
+}
+
+/**
+ * @brief   Let the clock hand sweep pages of new user address space
+ */
+void Swap::register_address_space(u64 pml4_phys_addr) {
+    address_spaces.push_back(pml4_phys_addr);
+}
+
+/**
+ * @brief   Stop sweeping pages of released user address space
+ */
+void Swap::unregister_address_space(u64 pml4_phys_addr) {
+    for (size_t i = 0; i < address_spaces.size(); i++) {
+        if (address_spaces[i] != pml4_phys_addr)
+            continue;
+
+        address_spaces[i] = address_spaces.back();
+        address_spaces.pop_back();
+        if (clock_address_space == i)
+            clock_page = 0;
+        return;
+    }
+}
+
+/**
+ * @brief   Find a page that was not accessed recently, write it to swap space and take its frame
+ * @return  Frame physical address, or -1 if no page can be swapped out or swap space is full.
+ *          The frame holds the swapped out data; it is up to the caller to clear it
+ */
+ssize_t Swap::swap_out_page() {
+    constexpr u64 PAGE_SIZE = PageTables::get_page_size();
+
+    if (!is_installed() || used_slots_count == slots_count)
+        return -1;
+
+    // two full sweeps at most, as the first one may only clear the ACCESSED bits
+    const u64 max_pages = 2 * address_spaces.size() * USER_PAGES_COUNT;
+    for (u64 swept_pages = 0; swept_pages < max_pages; ) {
+        if (clock_address_space >= address_spaces.size()) {
+            clock_address_space = 0;
+            clock_page = 0;
+        }
+
+        const u64 pml4_phys_addr = address_spaces[clock_address_space];
+        const u64 virtual_address = clock_page * PAGE_SIZE;
+        u64* pde = PageTables::get_pde_for_virt_address(virtual_address, pml4_phys_addr);
+
+        // no 4KB pages in this 2MB region, skip it entirely
+        if (!pde || (*pde & PageAttr::PRESENT) != PageAttr::PRESENT || (*pde & PageAttr::HUGE_PAGE)) {
+            const u64 num_pages = PAGES_PER_REGION - clock_page % PAGES_PER_REGION;
+            advance_clock_hand(num_pages);
+            swept_pages += num_pages;
+            continue;
+        }
+
+        u64* page = PageTables::get_page_for_virt_address(virtual_address, pml4_phys_addr);
+        advance_clock_hand(1);
+        swept_pages++;
+
+        if (!can_swap_out(*page))
+            continue;
+
+        // recently used page gets a second chance
+        if (*page & PageAttr::ACCESSED) {
+            *page &= ~(u64)PageAttr::ACCESSED;
+            continue;
+        }
+
+        return swap_out(page, virtual_address, pml4_phys_addr);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief   Read swapped out "page" back from swap space into a new frame
+ * @param   page Entry of the page in current address space
+ * @return  False if no frame could be found or reading failed
+ */
+bool Swap::swap_in_page(u64* page, u64 virtual_address) {
+    const size_t slot = get_slot(*page);
+
+    ssize_t frame_phys_addr = FrameAllocator::alloc_frame();
+    if (frame_phys_addr == -1)
+        frame_phys_addr = swap_out_page();
+
+    if (frame_phys_addr == -1)
+        return false;
+
+    if (!requests->read_swap_page(slot, (void*)HigherHalf::phys_to_virt(frame_phys_addr))) {
+        FrameAllocator::free_frame(frame_phys_addr);
+        return false;
+    }
+
+    *page = frame_phys_addr | (*page & ATTRIBUTES_MASK) | PageAttr::PRESENT;
+    asm volatile("invlpg (%0)" ::"r" (virtual_address) : "memory");
+    release_slot(slot);
+    swapped_in_count++;
+    return true;
+}
+
+bool Swap::is_swapped_out(u64 page) {
+    return !(page & PageAttr::PRESENT) && (page & PageAttr::SWAPPED_OUT);
+}
+
+/**
+ * @brief   Add a user to the slot of swapped out "page", as the page entry got copied to cloned address space
+ * @return  False if the slot has too many users already
+ */
+bool Swap::share_slot(u64 page) {
+    const size_t slot = get_slot(page);
+    if (slot >= slots_count || slot_users[slot] == MAX_SLOT_USERS)
+        return false;
+
+    slot_users[slot]++;
+    return true;
+}
+
+/**
+ * @brief   Drop a user of the slot of swapped out "page"; the slot is freed when it has no users left
+ */
+void Swap::free_slot(u64 page) {
+    release_slot(get_slot(page));
+}
+
+size_t Swap::get_total_slots_count() {
+    return slots_count;
+}
+
+size_t Swap::get_used_slots_count() {
+    return used_slots_count;
+}
+
+size_t Swap::get_swapped_out_count() {
+    return swapped_out_count;
+}
+
+size_t Swap::get_swapped_in_count() {
+    return swapped_in_count;
+}
+
+/**
+ * @brief   Check if present "page" can be swapped out: it must be a 4KB user page with a frame of its own
+ */
+bool Swap::can_swap_out(u64 page) {
+    if ((page & PageAttr::PRESENT) != PageAttr::PRESENT || !(page & PageAttr::USER_ACCESSIBLE))
+        return false;
+
+    if (page & (PageAttr::DEVICE_MEMORY | PageAttr::SHARED_MEMORY))
+        return false;
+
+    return !FrameAllocator::is_frame_shared(page & PageTables::FRAME_ADDRESS_MASK);
+}
+
+/**
+ * @brief   Write "page" frame to free slot and make the page entry hold the slot instead of the frame
+ * @note    The entry is switched to the slot and dropped from every cpu TLB before the frame is written,
+ *          so no cpu can still write the frame through a stale entry after its content went to the swap
+ * @return  The frame physical address, -1 if no free slot or writing failed
+ */
+ssize_t Swap::swap_out(u64* page, u64 virtual_address, u64 pml4_phys_addr) {
+    const ssize_t slot = alloc_slot();
+    if (slot == -1)
+        return -1;
+
+    const u64 original_page = *page;
+    const u64 frame_phys_addr = original_page & PageTables::FRAME_ADDRESS_MASK;
+    const u64 attributes = original_page & ATTRIBUTES_MASK & ~(u64)(PageAttr::PRESENT | PageAttr::ACCESSED | PageAttr::DIRTY);
+    *page = slot * PageTables::get_page_size() | attributes | PageAttr::SWAPPED_OUT;
+    PageTables::invalidate_page(virtual_address, pml4_phys_addr);
+
+    if (!requests->write_swap_page(slot, (const void*)HigherHalf::phys_to_virt(frame_phys_addr))) {
+        *page = original_page;  // frame stays in use; non-present entry was not cached so no invalidation needed
+        release_slot(slot);
+        return -1;
+    }
+
+    swapped_out_count++;
+    return frame_phys_addr;
+}
+
+/**
+ * @brief   Find free slot and give it its first user
+ * @return  Slot number, -1 if swap space is full
+ */
+ssize_t Swap::alloc_slot() {
+    for (size_t i = 0; i < slots_count; i++) {
+        const size_t slot = (next_slot_hint + i) % slots_count;
+        if (slot_users[slot] > 0)
+            continue;
+
+        slot_users[slot] = 1;
+        used_slots_count++;
+        next_slot_hint = slot + 1;
+        return slot;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief   Drop a user of the "slot"; the slot is freed when it has no users left
+ */
+void Swap::release_slot(size_t slot) {
+    if (slot >= slots_count || slot_users[slot] == 0)
+        return;
+
+    if (--slot_users[slot] > 0)
+        return;
+
+    used_slots_count--;
+    if (slot < next_slot_hint)
+        next_slot_hint = slot;
+}
+
+/**
+ * @brief   Get slot number held by swapped out "page" entry
+ */
+size_t Swap::get_slot(u64 page) {
+    return (page & PageTables::FRAME_ADDRESS_MASK) / PageTables::get_page_size();
+}
+
+/**
+ * @brief   Move the clock hand "num_pages" forward, wrapping to the next address space at the end of user memory
+ */
+void Swap::advance_clock_hand(u64 num_pages) {
+    clock_page += num_pages;
+    if (clock_page < USER_PAGES_COUNT)
+        return;
+
+    clock_page = 0;
+    clock_address_space++;
+}
+
+} /* namespace memory */
@@ -0,0 +1,69 @@
+/**
+ *   @file: Swap.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MEMORY_SWAP_H_
+#define KERNEL_SERVICES_MEMORY_SWAP_H_
+
+#include "types.h"
+#include "Vector.h"
+
+namespace memory {
+
+/**
+ * @brief   This class moves user 4KB pages out to swap space when no frame is left, and back in on page fault.
+ *          Pages to swap out are picked with the clock algorithm: the clock hand sweeps the pages of all user address spaces,
+ *          page that was accessed since the previous sweep gets its ACCESSED bit cleared and a second chance,
+ *          page that was not is written to a free swap slot and its frame is reused.
+ *          Swapped out page entry is "non present" and holds the slot number and the original page attributes.
+ * @note    Swap space is made of 4KB slots; the slots are read and written with "requests", eg. to a swap partition.
+ *          Slot can be used by many address spaces after fork; it is freed when the last one swaps it in or releases it
+ * @note    2MB pages, shared memory, device memory and frames shared copy-on-write are never swapped out
+ * @note    Execution context: Interrupt only (page fault, address space release)
+ */
+class Swap {
+public:
+    static bool install(size_t num_slots);
+    static bool is_installed();
+    static void register_address_space(u64 pml4_phys_addr);
+    static void unregister_address_space(u64 pml4_phys_addr);
+    static ssize_t swap_out_page();
+    static bool swap_in_page(u64* page, u64 virtual_address);
+    static bool is_swapped_out(u64 page);
+    static bool share_slot(u64 page);
+    static void free_slot(u64 page);
+    static size_t get_total_slots_count();
+    static size_t get_used_slots_count();
+    static size_t get_swapped_out_count();
+    static size_t get_swapped_in_count();
+
+private:
+    static constexpr u64    USER_PAGES_COUNT    {512 * 512};    // user address space spans 1GB
+    static constexpr u64    PAGES_PER_REGION    {512};          // pages mapped by one page table
+    static constexpr u16    MAX_SLOT_USERS      {0xFFFF};
+    static constexpr u64    ATTRIBUTES_MASK     {4095};         // page attributes that are kept in swapped out page entry
+
+    static bool can_swap_out(u64 page);
+    static ssize_t swap_out(u64* page, u64 virtual_address, u64 pml4_phys_addr);
+    static ssize_t alloc_slot();
+    static void release_slot(size_t slot);
+    static size_t get_slot(u64 page);
+    static void advance_clock_hand(u64 num_pages);
+
+    static u16*                 slot_users;             // number of page entries that hold the slot, 0 for free slot
+    static size_t               slots_count;
+    static size_t               used_slots_count;
+    static size_t               next_slot_hint;         // start searching for free slot here
+    static size_t               swapped_out_count;      // since boot
+    static size_t               swapped_in_count;       // since boot
+    static cstd::vector<u64>    address_spaces;         // page tables root physical addresses of user address spaces
+    static size_t               clock_address_space;    // clock hand: index into "address_spaces"...
+    static u64                  clock_page;             // ...and page number in that address space
+};
+
+} /* namespace memory */
+
+#endif /* KERNEL_SERVICES_MEMORY_SWAP_H_ */
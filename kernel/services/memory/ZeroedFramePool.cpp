@@ -0,0 +1,101 @@
+/**
+ *   @file: ZeroedFramePool.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "cstd.h"
+#include "HigherHalf.h"
+#include "KLockGuard.h"
+#include "ZeroedFramePool.h"
+
+using namespace multitasking;
+
+namespace memory {
+
+size_t  ZeroedFramePool::frames[CAPACITY];
+size_t  ZeroedFramePool::frames_count {0};
+
+/**
+ * @brief   Get a zeroed frame; take it from the stock or zero a fresh one if the stock is empty
+ * @return  -1 on failure, frame physical address on success
+ */
+ssize_t ZeroedFramePool::alloc_frame() {
+    KLockGuard lock;    // prevent reschedule
+
+    if (frames_count > 0)
+        return frames[--frames_count];
+
+    const ssize_t frame_phys_addr = FrameAllocator::alloc_frame();
+    if (frame_phys_addr == -1)
+        return -1;
+
+    // regular stores here; the frame is about to be used so its cache lines are welcome
+    memset((void*)HigherHalf::phys_to_virt(frame_phys_addr), 0, FrameAllocator::get_frame_size());
+    return frame_phys_addr;
+}
+
+/**
+ * @brief   Zero a single frame and put it in stock. Meant to be called when there is nothing else to do
+ * @return  False if the stock is full or there is no free frame left
+ * @note    Frame is zeroed with interrupts enabled; it belongs to nobody until put in stock
+ */
+bool ZeroedFramePool::refill_one_frame() {
+    ssize_t frame_phys_addr;
+    {
+        KLockGuard lock;
+        if (frames_count == CAPACITY)
+            return false;
+
+        frame_phys_addr = FrameAllocator::alloc_frame();
+        if (frame_phys_addr == -1)
+            return false;
+    }
+
+    zero_frames(frame_phys_addr, FrameAllocator::get_frame_size());
+
+    KLockGuard lock;
+    if (frames_count == CAPACITY) {             // idle task of other cpu filled the stock meanwhile
+        FrameAllocator::free_frame(frame_phys_addr);
+        return false;
+    }
+
+    frames[frames_count++] = frame_phys_addr;
+    return true;
+}
+
+/**
+ * @brief   Zero "num_bytes" of physical memory at "physical_address" with non-temporal stores, bypassing the cache
+ * @note    "physical_address" must be 64 bytes aligned and "num_bytes" a multiply of 64
+ */
+void ZeroedFramePool::zero_frames(size_t physical_address, size_t num_bytes) {
+    u8* dst = (u8*)HigherHalf::phys_to_virt(physical_address);
+    u8* end = dst + num_bytes;
+    const u64 zero = 0;
+
+    // one cache line per iteration
+    for (; dst < end; dst += 64)
+        asm volatile(
+            "movnti %1,   (%0)  \n"
+            "movnti %1,  8(%0)  \n"
+            "movnti %1, 16(%0)  \n"
+            "movnti %1, 24(%0)  \n"
+            "movnti %1, 32(%0)  \n"
+            "movnti %1, 40(%0)  \n"
+            "movnti %1, 48(%0)  \n"
+            "movnti %1, 56(%0)  \n"
+            : : "r"(dst), "r"(zero) : "memory");
+
+    // make the weakly ordered stores visible before the frame gets mapped
+    asm volatile("sfence" : : : "memory");
+}
+
+/**
+ * @brief   Number of zeroed frames ready to use
+ */
+size_t ZeroedFramePool::get_frames_count() {
+    return frames_count;
+}
+
+} /* namespace memory */
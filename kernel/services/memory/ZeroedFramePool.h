@@ -0,0 +1,38 @@
+/**
+ *   @file: ZeroedFramePool.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MEMORY_ZEROEDFRAMEPOOL_H_
+#define KERNEL_SERVICES_MEMORY_ZEROEDFRAMEPOOL_H_
+
+#include "types.h"
+#include "FrameAllocator.h"
+
+namespace memory {
+
+/**
+ * @brief   This class keeps a stock of already zeroed 4KB frames, so zeroing is done ahead of time and not on Page Fault.
+ *          The stock is refilled from the idle task, one frame at a time, with non-temporal stores
+ *          that dont evict the running tasks data from the cache.
+ * @note    When the stock runs out, frames are zeroed on the spot
+ */
+class ZeroedFramePool {
+public:
+    static ssize_t alloc_frame();
+    static bool refill_one_frame();
+    static void zero_frames(size_t physical_address, size_t num_bytes);
+    static size_t get_frames_count();
+
+private:
+    static constexpr size_t CAPACITY    {256};  // 1MB of zeroed memory ready to use
+
+    static size_t   frames[CAPACITY];   // physical addresses of zeroed frames
+    static size_t   frames_count;
+};
+
+} /* namespace memory */
+
+#endif /* KERNEL_SERVICES_MEMORY_ZEROEDFRAMEPOOL_H_ */
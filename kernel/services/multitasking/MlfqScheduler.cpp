@@ -0,0 +1,101 @@
+/**
+ *   @file: MlfqScheduler.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "MlfqScheduler.h"
+#include "Task.h"
+
+namespace multitasking {
+
+void MlfqScheduler::enqueue(Task* task) {
+    levels[task->cpu][task->priority].push_back(task);
+    non_empty_levels[task->cpu] |= 1u << task->priority;
+    runnable_count[task->cpu]++;
+}
+
+void MlfqScheduler::dequeue(Task* task) {
+    RunQueue& level = levels[task->cpu][task->priority];
+    level.remove(task);
+    if (level.empty())
+        non_empty_levels[task->cpu] &= ~(1u << task->priority);
+    runnable_count[task->cpu]--;
+}
+
+/**
+ * @brief   Take the task that waited longest on the highest non-empty level of "cpu"
+ */
+Task* MlfqScheduler::pick_next_runnable(u32 cpu) {
+    if (non_empty_levels[cpu] == 0)
+        return nullptr;
+
+    Task* task = levels[cpu][__builtin_ctz(non_empty_levels[cpu])].front();
+    dequeue(task);
+    return task;
+}
+
+u32 MlfqScheduler::count_runnable(u32 cpu) const {
+    return runnable_count[cpu];
+}
+
+/**
+ * @brief   Charge the tick to "task" time slice
+ * @return  True if "task" used up its time slice, or a higher priority task is waiting, or it is boost time
+ * @note    "task" is being run, so it is not queued and can change its priority in place
+ */
+bool MlfqScheduler::tick(Task* task, u64 now_us) {
+    if (now_us - last_boost_us >= BOOST_PERIOD_US) {
+        last_boost_us = now_us;
+        boost_all();
+        return true;
+    }
+
+    if (++task->ticks_used >= get_time_slice(task->priority)) {
+        if (task->priority < PRIORITY_LEVELS - 1)
+            task->priority++;
+        task->ticks_used = 0;
+        return true;
+    }
+
+    const u32 higher_levels_mask = (1u << task->priority) - 1;
+    return (non_empty_levels[task->cpu] & higher_levels_mask) != 0;
+}
+
+void MlfqScheduler::reset_priority(Task* task) {
+    task->priority = get_base_priority(task->nice);
+    task->ticks_used = 0;
+}
+
+/**
+ * @brief   Map nice value NICE_MIN..NICE_MAX onto levels 0..BASE_LEVELS-1
+ */
+u32 MlfqScheduler::get_base_priority(s32 nice) {
+    return (nice - Task::NICE_MIN) * BASE_LEVELS / (Task::NICE_MAX - Task::NICE_MIN + 1);
+}
+
+/**
+ * @brief   Get time slice in timer ticks for given "priority" level
+ */
+u32 MlfqScheduler::get_time_slice(u32 priority) {
+    return priority + 1;
+}
+
+/**
+ * @brief   Give all the tasks their base priority back
+ */
+void MlfqScheduler::boost_all() {
+    for (Task* task : tasks) {
+        const bool was_queued = is_queued(task);
+        if (was_queued)
+            dequeue(task);
+
+        reset_priority(task);
+
+        if (was_queued)
+            enqueue(task);
+    }
+}
+
+} /* namespace multitasking */
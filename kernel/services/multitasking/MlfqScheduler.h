@@ -0,0 +1,61 @@
+/**
+ *   @file: MlfqScheduler.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MULTITASKING_MLFQSCHEDULER_H_
+#define KERNEL_SERVICES_MULTITASKING_MLFQSCHEDULER_H_
+
+#include "Scheduler.h"
+#include "RunQueue.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class provides a multi-level feedback queue task scheduler.
+ *          There is a run queue per priority level; the highest priority runnable task runs first,
+ *          tasks of the same priority take turns. The lower the priority, the longer the time slice.
+ *          - task that runs through its whole time slice is cpu bound and drops one level down
+ *          - task that blocks before its slice is used up keeps its level, so interactive tasks stay on top
+ *          - task woken up by input (eg. FIFO read) goes back to its base priority at once
+ *          - every BOOST_PERIOD_US of uptime all tasks go back to their base priority, so cpu bound tasks dont starve;
+ *            the period is measured in time and not in ticks of any one cpu, as an idle cpu does not tick
+ *          Base priority of a task comes from its nice value and is one of the upper BASE_LEVELS levels,
+ *          so every task has a few lower levels to drop to.
+ *          Picking next task, blocking and unblocking are O(1): the highest non-empty level is found in a bitmap.
+ *          Every cpu has its own set of levels.
+ */
+class MlfqScheduler : public Scheduler {
+public:
+    MlfqScheduler(Task* boot_task) : Scheduler(boot_task) {}
+
+protected:
+    void enqueue(Task* task) override;
+    void dequeue(Task* task) override;
+    Task* pick_next_runnable(u32 cpu) override;
+    u32 count_runnable(u32 cpu) const override;
+    bool tick(Task* task, u64 now_us) override;
+    void reset_priority(Task* task) override;
+
+private:
+    static constexpr u32 PRIORITY_LEVELS    {8};
+    static constexpr u32 BASE_LEVELS        {PRIORITY_LEVELS / 2};
+    static constexpr u64 BOOST_PERIOD_US    {2000000};  // 2 seconds
+
+    static u32 get_base_priority(s32 nice);
+    static u32 get_time_slice(u32 priority);
+    void boost_all();
+
+    static constexpr u32 MAX_CPUS           {hardware::PerCpu::MAX_CPUS};
+
+    RunQueue    levels[MAX_CPUS][PRIORITY_LEVELS];  // queued tasks of every cpu, by priority; level 0 is the highest
+    u32         non_empty_levels[MAX_CPUS]  {};     // bit "i" set if "levels[cpu][i]" is non-empty
+    u32         runnable_count[MAX_CPUS]    {};
+    u64         last_boost_us               {0};    // uptime of the last boost, checked by the ticks of every cpu
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_SERVICES_MULTITASKING_MLFQSCHEDULER_H_ */
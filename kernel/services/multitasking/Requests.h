@@ -27,15 +27,24 @@ public:
 public: // Boilerplate
 	virtual ~Requests() = default;
 	template<typename ... Args>
-	void log(const cstd::string& fmt, Args ... args) { log(cstd::StringUtils::format(fmt, args...)); }
+	void log(const char* fmt, const Args& ... args) {
+		char line[256];	// longer lines get cut off; formatting into the stack keeps logging allocation free
+		cstd::StringUtils::format_to(line, sizeof(line), fmt, args...);
+		log(line);
+	}
+	void log(const cstd::string& s) { log(s.c_str()); }
 
 public: // Actual methods to implement
-	virtual void log(const cstd::string& s) = 0;
-	virtual void timer_emplace(u32 millis, const OnTimerExpire& on_expire) = 0;
+	virtual void log(const char* s) = 0;
+	virtual void timer_emplace(u64 micros, const OnTimerExpire& on_expire) = 0;
+	virtual void wake_cpu(u32 cpu) = 0;
+	virtual u64 get_uptime_us() = 0;
 	virtual void* alloc_stack_and_mark_guard_page(memory::AddressSpace& as, size_t num_bytes) = 0;
+	virtual void release_stack(memory::AddressSpace& as, void* stack_addr, size_t num_bytes) = 0;
 	virtual memory::AddressSpace get_kernel_address_space() = 0;
 	virtual void load_address_space(const memory::AddressSpace& as) = 0;
 	virtual void release_address_space(memory::AddressSpace& as) = 0;
+	virtual bool refill_zeroed_frame_pool() = 0;
 };
 
 /**
@@ -8,36 +8,32 @@
 #ifndef KERNEL_MULTITASKING_ROUNDROBINSCHEDULER_H_
 #define KERNEL_MULTITASKING_ROUNDROBINSCHEDULER_H_
 
-#include "TaskList.h"
+#include "Scheduler.h"
+#include "RunQueue.h"
 
 namespace multitasking {
 
 /**
  * @brief   This class provides a round-robin task scheduler.
+ *          Only runnable tasks sit on the run queue; blocked tasks are kept off it until unblocked,
+ *          so picking next task, blocking and unblocking are all O(1), no matter how many tasks sleep.
+ *          Every task gets the cpu for one timer tick in turn; priorities are ignored.
+ *          Every cpu has its own run queue
  */
-class RoundRobinScheduler {
-    static constexpr u32 MAX_TASKS  {32};   // 32 is arbitrarily chosen, can put here more
-
+class RoundRobinScheduler : public Scheduler {
 public:
-    RoundRobinScheduler(Task* boot_task) : current_task(boot_task) {}
-    void set_idle_task(Task* task);
-    bool add(Task* task);
-    void remove(Task* t);
-    bool is_valid_task(Task* task) const;
-    Task* get_by_tid(u32 task_id);
-    Task* get_current_task();
-    Task* pick_next_task();
-    const TaskList& get_task_list() const;
-    u32 count() const;
-
-private:
-    Task* find_next_runnable_task();
+    RoundRobinScheduler(Task* boot_task) : Scheduler(boot_task) {}
 
-    TaskList                    tasks;
-    Task*                       idle            {nullptr};      // idle is picked when there is no other runnable task available
-    Task*                       current_task;
-    cstd::ListIterator<Task*>   next_task_it    {tasks.end()};
+protected:
+    void enqueue(Task* task) override;
+    void dequeue(Task* task) override;
+    Task* pick_next_runnable(u32 cpu) override;
+    u32 count_runnable(u32 cpu) const override;
+    bool tick(Task* task, u64 now_us) override;
+    void reset_priority(Task* task) override;
 
+private:
+    RunQueue    run_queues[hardware::PerCpu::MAX_CPUS];     // queued tasks of every cpu; the running task goes to the back when it gives the cpu away
 };
 
 } /* namespace multitasking */
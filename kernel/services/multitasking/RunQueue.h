@@ -0,0 +1,84 @@
+/**
+ *   @file: RunQueue.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MULTITASKING_RUNQUEUE_H_
+#define KERNEL_SERVICES_MULTITASKING_RUNQUEUE_H_
+
+#include "Task.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class is a FIFO queue of tasks that are ready to run.
+ *          The queue is intrusive: the links live in the Task itself, so all the operations are O(1)
+ *          and no memory is allocated on enqueue.
+ * @note    Task can be on one run queue at a time
+ */
+class RunQueue {
+public:
+    void push_back(Task* task) {
+        task->run_queue_prev = tail;
+        task->run_queue_next = nullptr;
+        if (tail)
+            tail->run_queue_next = task;
+        else
+            head = task;
+        tail = task;
+        size++;
+    }
+
+    Task* front() const {
+        return head;
+    }
+
+    Task* pop_front() {
+        Task* task = head;
+        if (task)
+            remove(task);
+        return task;
+    }
+
+    void remove(Task* task) {
+        if (!contains(task))
+            return;
+
+        if (task->run_queue_prev)
+            task->run_queue_prev->run_queue_next = task->run_queue_next;
+        else
+            head = task->run_queue_next;
+
+        if (task->run_queue_next)
+            task->run_queue_next->run_queue_prev = task->run_queue_prev;
+        else
+            tail = task->run_queue_prev;
+
+        task->run_queue_prev = nullptr;
+        task->run_queue_next = nullptr;
+        size--;
+    }
+
+    bool contains(const Task* task) const {
+        return task->run_queue_prev || head == task;
+    }
+
+    bool empty() const {
+        return size == 0;
+    }
+
+    u32 count() const {
+        return size;
+    }
+
+private:
+    Task*   head    {nullptr};
+    Task*   tail    {nullptr};
+    u32     size    {0};
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_SERVICES_MULTITASKING_RUNQUEUE_H_ */
@@ -0,0 +1,302 @@
+/**
+ *   @file: Scheduler.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "Scheduler.h"
+#include "Assert.h"
+#include "Task.h"
+
+namespace multitasking {
+
+using hardware::PerCpu;
+
+Scheduler::Scheduler(Task* boot_task) : boot_task(boot_task) {
+    for (Task*& current_task : current_tasks)
+        current_task = boot_task;
+}
+
+/**
+ * @brief   Idle is the task that is picked when there is no other runnable task available for "cpu"
+ */
+void Scheduler::set_idle_task(u32 cpu, Task* task) {
+    idle_tasks[cpu] = task;
+}
+
+/**
+ * @brief   Add new task to the run queue of the least loaded cpu
+ * @return  True on success, False otherwise
+ */
+bool Scheduler::add(Task* t) {
+    if (tasks.count() == MAX_TASKS)
+        return false;
+
+    tasks.push_front(t);
+    tasks_by_tid[t->task_id] = t;   // replacement task takes over the tid of the current one
+    known_tasks[t] = true;
+    reset_priority(t);
+    t->cpu = get_least_loaded_cpu();
+    if (t->state == TaskState::RUNNING)
+        enqueue(t);
+    return true;
+}
+
+/**
+ * @brief   Remove task from scheduler
+ * @note    "t" must not be run by other cpu; such task is to be killed instead
+ */
+void Scheduler::remove(Task* t) {
+    auto known_it = known_tasks.find(t);
+    if (known_it == known_tasks.end())
+        return;
+
+    if (is_queued(t))
+        dequeue(t);
+    known_tasks.erase(known_it);
+    tasks.remove(tasks.find(t));
+
+    auto tid_it = tasks_by_tid.find(t->task_id);
+    if (tid_it != tasks_by_tid.end() && tid_it->second == t)
+        tasks_by_tid.erase(tid_it);
+
+    for (Task*& current_task : current_tasks)
+        if (current_task == t)
+            current_task = boot_task;   // so current task is never a dangling pointer
+}
+
+/**
+ * @brief   Take "task" off the runnable tasks until it is unblocked
+ */
+void Scheduler::block(Task* task) {
+    if (task->state != TaskState::RUNNING)
+        return;
+
+    if (is_queued(task))
+        dequeue(task);
+    task->state = TaskState::BLOCKED;
+}
+
+/**
+ * @brief   Make blocked "task" runnable again, on the current cpu as it is likely to have the data the task waited for
+ * @param   boost Give the task back its base priority, eg. because it waited for input and should respond quickly
+ * @note    "task" might have been deleted while blocked (exit_group); such task is ignored
+ * @note    "task" might have blocked and not yet given its cpu away; it just goes on running then
+ */
+void Scheduler::unblock(Task* task, bool boost) {
+    if (!is_valid_task(task) || task->state != TaskState::BLOCKED)
+        return;
+
+    task->state = TaskState::RUNNING;
+    if (boost)
+        reset_priority(task);
+    if (!task->is_on_cpu) {
+        task->cpu = PerCpu::current().index;
+        enqueue(task);
+    }
+}
+
+/**
+ * @brief   Mark "task" that is being run by other cpu to be removed by that cpu when it switches away from the task
+ */
+void Scheduler::kill(Task* task) {
+    if (is_queued(task))
+        dequeue(task);
+    task->state = TaskState::KILLED;
+}
+
+/**
+ * @brief   Set "task" nice value
+ * @return  False if "nice" is out of NICE_MIN..NICE_MAX range
+ */
+bool Scheduler::set_nice(Task* task, s32 nice) {
+    if (nice < Task::NICE_MIN || nice > Task::NICE_MAX)
+        return false;
+
+    const bool was_queued = is_queued(task);
+    if (was_queued)
+        dequeue(task);
+
+    task->nice = nice;
+    reset_priority(task);
+
+    if (was_queued)
+        enqueue(task);
+    return true;
+}
+
+/**
+ * @brief   Account another timer tick to the current task of the current cpu
+ * @param   now_us Uptime in microseconds, for the policies that act periodically regardless of which cpu ticks
+ * @return  True if the current task should give the cpu away, False if it can go on running
+ */
+bool Scheduler::on_tick(u64 now_us) {
+    Task* current_task = get_current_task();
+    if (!is_valid_task(current_task) || current_task->state != TaskState::RUNNING)
+        return true;
+
+    if (is_idle(PerCpu::current().index))
+        return true;    // idle gives the cpu away whenever asked, there may be a task to steal
+
+    return tick(current_task, now_us);
+}
+
+/**
+ * @brief   Check if "task" is a known task
+ */
+bool Scheduler::is_valid_task(Task* task) const {
+    return known_tasks.find(task) != known_tasks.cend();
+}
+
+/**
+ * @brief   Check if "task" sits on a run queue; the running tasks are off the queues
+ */
+bool Scheduler::is_queued(Task* task) const {
+    return is_valid_task(task) && task->state == TaskState::RUNNING && !task->is_on_cpu;
+}
+
+/**
+ * @brief   Find a task by its task_id
+ * @return  Task pointer on success, nullptr otherwise
+ */
+Task* Scheduler::get_by_tid(TaskId task_id) {
+    auto it = tasks_by_tid.find(task_id);
+    if (it == tasks_by_tid.end())
+        return nullptr;
+
+    return it->second;
+}
+
+/**
+ * @brief   Get pointer to the task that is currently being executed by the current cpu
+ */
+Task* Scheduler::get_current_task() {
+    return current_tasks[PerCpu::current().index];
+}
+
+/**
+ * @brief   Choose and return next task to be executed by the current cpu.
+ *          Can be the curr task if no other is eligible.
+ *          Can be a task stolen from other cpu if there is nothing to run on the current one.
+ *          Can be idle task if even curr is not eligible
+ */
+Task* Scheduler::pick_next_task() {
+    utils::phobos_assert(tasks.count() > 0, "Scheduler::pick_next_task: no tasks to pick from");
+
+    const u32 cpu = PerCpu::current().index;
+    Task* prev = current_tasks[cpu];    // never dangling, see remove()
+    prev->is_on_cpu = false;
+    if (is_valid_task(prev) && prev->state == TaskState::RUNNING)
+        enqueue(prev);  // prev->cpu is the current cpu
+
+    Task* next = pick_next_runnable(cpu);
+    if (!next)
+        next = steal_task(cpu);
+    if (!next)
+        next = idle_tasks[cpu]; // task eligible to run not found, do idle
+
+    next->cpu = cpu;
+    next->is_on_cpu = true;
+    return (current_tasks[cpu] = next);
+}
+
+/**
+ * @brief   Check if "cpu" has nothing to run; it then sleeps till an interrupt comes
+ */
+bool Scheduler::is_idle(u32 cpu) const {
+    return current_tasks[cpu] == idle_tasks[cpu] || current_tasks[cpu] == boot_task;
+}
+
+/**
+ * @brief   Find idle cpu to wake up for "task" that waits on a run queue; the cpu of the task's queue is preferred,
+ *          other idle cpu steals the task
+ * @return  True if there is a cpu to wake up, False if the task is not queued or all the cpus are busy
+ */
+bool Scheduler::find_cpu_to_wake(Task* task, u32& cpu) const {
+    if (!is_queued(task))
+        return false;
+
+    if (is_idle(task->cpu)) {
+        cpu = task->cpu;
+        return true;
+    }
+
+    for (u32 other = 0; other < PerCpu::count(); other++)
+        if (is_idle(other)) {
+            cpu = other;
+            return true;
+        }
+
+    return false;
+}
+
+/**
+ * @brief   Find idle cpu to wake up to steal a task that waits on the run queue of the current cpu
+ * @return  True if the current cpu has tasks waiting and there is an idle cpu, False otherwise
+ */
+bool Scheduler::find_cpu_to_steal(u32& cpu) const {
+    if (count_runnable(PerCpu::current().index) == 0)
+        return false;
+
+    for (u32 other = 0; other < PerCpu::count(); other++)
+        if (is_idle(other)) {
+            cpu = other;
+            return true;
+        }
+
+    return false;
+}
+
+/**
+ * @brief   Find the cpu with the fewest tasks to run, counting the task it runs now
+ */
+u32 Scheduler::get_least_loaded_cpu() const {
+    u32 least_loaded_cpu = 0;
+    u32 least_load = (u32)-1;
+    for (u32 cpu = 0; cpu < PerCpu::count(); cpu++) {
+        const u32 load = count_runnable(cpu) + (is_idle(cpu) ? 0 : 1);
+        if (load < least_load) {
+            least_load = load;
+            least_loaded_cpu = cpu;
+        }
+    }
+    return least_loaded_cpu;
+}
+
+/**
+ * @brief   Take a task off the run queue of the busiest other cpu and give it to "cpu"
+ * @return  The task, or nullptr if no other cpu has a task waiting
+ */
+Task* Scheduler::steal_task(u32 cpu) {
+    u32 busiest_cpu = cpu;
+    u32 busiest_load = 0;
+    for (u32 other = 0; other < PerCpu::count(); other++) {
+        const u32 load = count_runnable(other);
+        if (other != cpu && load > busiest_load) {
+            busiest_load = load;
+            busiest_cpu = other;
+        }
+    }
+
+    if (busiest_cpu == cpu)
+        return nullptr;
+
+    return pick_next_runnable(busiest_cpu);
+}
+
+/**
+ * @brief   Get unmodifiable list of scheduler tasks
+ */
+const TaskList& Scheduler::get_task_list() const {
+    return tasks;
+}
+
+/**
+ * @brief   Get scheduler task count
+ */
+u32 Scheduler::count() const {
+    return tasks.count();
+}
+
+} /* namespace multitasking */
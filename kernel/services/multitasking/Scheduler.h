@@ -0,0 +1,75 @@
+/**
+ *   @file: Scheduler.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_SERVICES_MULTITASKING_SCHEDULER_H_
+#define KERNEL_SERVICES_MULTITASKING_SCHEDULER_H_
+
+#include "TaskList.h"
+#include "TaskId.h"
+#include "HashMap.h"
+#include "PerCpu.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class is the base for task schedulers. It keeps track of all the tasks and of the current one of every cpu,
+ *          the actual scheduling policy - which runnable task goes next and when it gets preempted - is up to the subclass.
+ *          Every cpu has its own run queue; the task being run is off the queue until it gives the cpu away.
+ *          New task goes to the least loaded cpu, cpu that runs out of tasks steals one from the busiest cpu.
+ *          Task lookup by tid and by pointer is O(1).
+ * @note    All the methods are run under KernelLock
+ */
+class Scheduler {
+    static constexpr u32 MAX_TASKS  {512};  // 512 is arbitrarily chosen, can put here more
+    static constexpr u32 MAX_CPUS   {hardware::PerCpu::MAX_CPUS};
+
+public:
+    Scheduler(Task* boot_task);
+    virtual ~Scheduler() = default;
+    void set_idle_task(u32 cpu, Task* task);
+    bool add(Task* task);
+    void remove(Task* task);
+    void block(Task* task);
+    void unblock(Task* task, bool boost);
+    void kill(Task* task);
+    bool set_nice(Task* task, s32 nice);
+    bool on_tick(u64 now_us);
+    bool is_idle(u32 cpu) const;
+    bool find_cpu_to_wake(Task* task, u32& cpu) const;
+    bool find_cpu_to_steal(u32& cpu) const;
+    bool is_valid_task(Task* task) const;
+    Task* get_by_tid(TaskId task_id);
+    Task* get_current_task();
+    Task* pick_next_task();
+    const TaskList& get_task_list() const;
+    u32 count() const;
+
+protected: // Actual policy to implement; "task->cpu" tells the run queue to use
+    virtual void enqueue(Task* task) = 0;               // "task" becomes runnable
+    virtual void dequeue(Task* task) = 0;               // "task" stops being runnable
+    virtual Task* pick_next_runnable(u32 cpu) = 0;      // take the next task off "cpu" run queue; nullptr if it is empty
+    virtual u32 count_runnable(u32 cpu) const = 0;      // number of tasks on "cpu" run queue
+    virtual bool tick(Task* task, u64 now_us) = 0;      // "task" ran for another timer tick, "now_us" is uptime; true if it should give the cpu away
+    virtual void reset_priority(Task* task) = 0;        // "task" is new, got reniced or woken up with a boost; "task" is not queued
+    bool is_queued(Task* task) const;
+
+    TaskList                        tasks;              // all the tasks, for listing
+
+private:
+    u32 get_least_loaded_cpu() const;
+    Task* steal_task(u32 cpu);
+
+    cstd::HashMap<TaskId, Task*>    tasks_by_tid;
+    cstd::HashMap<Task*, bool>      known_tasks;        // tells if a Task pointer is still valid without dereferencing it
+    Task*                           boot_task;          // current task of the cpu that did not schedule yet
+    Task*                           idle_tasks[MAX_CPUS]    {};     // idle is picked when there is no other runnable task available
+    Task*                           current_tasks[MAX_CPUS];
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_SERVICES_MULTITASKING_SCHEDULER_H_ */
@@ -7,6 +7,7 @@
 
 #include "Task.h"
 #include "SysCallNumbers.h"
+#include "Requests.h"
 
 using namespace hardware;
 
@@ -19,6 +20,7 @@ namespace multitasking {
    0|FREE STACK|CpuState|TaskEpilogue|STACK_MAX
                         ^
                   here is rsp when first time jumping from interrupt to task function. So on return the function takes ret addr from TaskEpilogue.
+   User task keeps its CpuState in "user_cpu_state" instead, only TaskEpilogue goes to the user stack.
 
   @param    entrypoint      Task main function address
   @param    arg1, arg2      Task main function param 1 and 2
@@ -36,33 +38,38 @@ Task::Task(TaskEntryPoint2 entrypoint, const char name[], u64 arg1, u64 arg2, bo
         is_user_space(user_space),
         stack_addr(stack_addr), stack_size(stack_size),
         cpu_state((CpuState*)0xBAD), task_id(0), state(TaskState::RUNNING),
-        task_group_data(task_group_data) {
+        task_group_data(task_group_data), kernel_lock_depth(user_space ? 0 : 1) {
 }
 
 /**
  * @brief   Cleanup task dynamic data
  */
 Task::~Task() {
-    // delete kernelspace stack. userspace stack is removed together with task address space
+    // delete kernelspace stack. userspace stack goes back to the task address space, to be reused by next thread
     if (!is_user_space)
         delete[] (u8*)stack_addr;
+    else if (task_group_data)
+        requests->release_stack(task_group_data->address_space, (void*)stack_addr, stack_size);
 }
 /**
  * @brief   Setup cpu state and return address on the task stack before running the task
  * @param   exitpoint Address of a function that the task should return to upon exit
+ * @note    Task with no entrypoint is a forked task; its stack and cpu state are already in place, inherited from the parent
  */
 void Task::prepare(TaskId tid, TaskExitPoint exitpoint) {
+    task_id = tid;
+    if (!entrypoint)
+        return;
+
     const u64 STACK_END = (u64)stack_addr + stack_size;
 
     // prepare task epilogue ie. where to return from task function
     TaskEpilogue* task_epilogue = (TaskEpilogue*)(STACK_END - sizeof(TaskEpilogue));
     new (task_epilogue) TaskEpilogue {(u64)exitpoint};
 
-    // prepare task cpu state to setup cpu register with
-    cpu_state = (CpuState*)(STACK_END - sizeof(CpuState) - sizeof(TaskEpilogue));
+    // prepare task cpu state to setup cpu register with; user task keeps it in kernel memory, see user_cpu_state
+    cpu_state = is_user_space ? &user_cpu_state : (CpuState*)(STACK_END - sizeof(CpuState) - sizeof(TaskEpilogue));
     new (cpu_state) CpuState {(u64)entrypoint, (u64)task_epilogue, arg1, arg2, is_user_space, task_group_data->address_space.pml4_phys_addr};
-
-    task_id = tid;
 }
 
 bool Task::is_parent_of(const Task& t) const {
@@ -73,9 +80,13 @@ bool Task::is_in_group(const TaskGroupDataPtr& g) const {
     return task_group_data == g;
 }
 
+/**
+ * @brief   Use the spare cpu time to zero frames for future page faults; halt when there is nothing left to zero
+ */
 void Task::idle() {
     while (true)
-        asm volatile("hlt");
+        if (!requests->refill_zeroed_frame_pool())
+            asm volatile("hlt");
 }
 
 void Task::yield() {
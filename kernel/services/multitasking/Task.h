@@ -20,7 +20,7 @@ using TaskEntryPoint1 = void (*)(u64 arg1);
 using TaskEntryPoint2 = void (*)(u64 arg1, u64 arg2);
 using TaskExitPoint = void (*)();
 
-enum class TaskState { RUNNING, BLOCKED };
+enum class TaskState { RUNNING, BLOCKED, KILLED };  // KILLED task is running on other cpu, that deletes it when switching away
 
 struct TaskEpilogue {
     u64 rip;    // rip cpu register value for retq instruction on task function exit
@@ -69,9 +69,20 @@ struct Task {
     u64                 stack_addr;
     u64                 stack_size;
     hardware::CpuState* cpu_state;
+    hardware::CpuState  user_cpu_state;     // user task cpu state kept in kernel memory, so resuming the task does not read the user stack in ring 0
     TaskList            finish_wait_list;   // list of tasks waiting for this task to finish
     TaskGroupDataPtr    task_group_data;    // task group where this task belong
-
+    Task*               run_queue_prev  {nullptr};  // links on the scheduler run queue, see RunQueue
+    Task*               run_queue_next  {nullptr};
+    s32                 nice            {0};        // NICE_MIN..NICE_MAX, the lower the more cpu time the task wants
+    u32                 priority        {0};        // current priority level, 0 is the highest; managed by the scheduler
+    u32                 ticks_used      {0};        // timer ticks run at current priority level
+    u32                 cpu             {0};        // cpu whose run queue holds the task, or that runs it
+    bool                is_on_cpu       {false};    // task is being run by "cpu"
+    u32                 kernel_lock_depth;          // KernelLock depth to restore when switching back to the task; kernel tasks hold the lock while running
+
+    static constexpr s32    NICE_MIN                    {-20};
+    static constexpr s32    NICE_MAX                    {19};
     static constexpr u64    DEFAULT_KERNEL_STACK_SIZE   {2  * 4096};
     static constexpr u64    DEFAULT_USER_STACK_SIZE     {32 * 4096};    // after inserting stack guard page we see 16KB is not enough :)
 };
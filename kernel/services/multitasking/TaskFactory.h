@@ -77,6 +77,31 @@ public:
                     );
     }
 
+    /**
+     * @brief   Create a task that continues "src" task execution in "as" address space cloned from "src" task group.
+     *          To be used to fork a process; the new task group inherits working directory and open files.
+     * @param   cpu_state Where the task resumes from
+     */
+    static Task* make_forked_task(const Task& src, const memory::AddressSpace& as, const hardware::CpuState& cpu_state) {
+        TaskGroupDataPtr task_group_data = cstd::make_shared<TaskGroupData>(as, src.task_group_data->cwd, src.task_id);
+        task_group_data->files = src.task_group_data->files;
+
+        Task* task = new Task(
+                        (TaskEntryPoint2)0,     // no entrypoint; resume from "cpu_state"
+                        src.name.c_str(),       // task name same as source task
+                        0,                      // task func arg 1
+                        0,                      // task func arg 2
+                        src.is_user_space,      // execution space same as source task
+                        src.stack_addr,         // stack at the same virtual address as in source task
+                        src.stack_size,
+                        task_group_data         // group of its own
+                    );
+        task->user_cpu_state = cpu_state;
+        task->cpu_state = &task->user_cpu_state;
+        task->nice = src.nice;
+        return task;
+    }
+
     /**
      * @brief   Create fake task that represents kernel main until entering multitasking
      */
@@ -8,8 +8,9 @@
 #include "TaskManager.h"
 #include "Requests.h"
 #include "TaskFactory.h"
-#include "KLockGuard.h"
+#include "KernelLock.h"
 #include "ErrorCode.h"
+#include "PerCpu.h"
 
 using namespace hardware;
 namespace multitasking {
@@ -33,13 +34,17 @@ void TaskManager::on_task_finished() {
 /**
  * @brief   Prepare multitasking.
  *          CPU needs always to execute some task. Idle task is scheduled when there is no other tasks to run.
- * @note    Execution context: Boot, when there is no tasks yet.
+ *          Every cpu gets its own idle task, as all of them can go idle at the same time.
+ * @note    Execution context: Boot, when there is no tasks yet and the application cpus are booted
  * @note    Must be called before first "add_task"
  */
 void TaskManager::install_multitasking() {
-    Task* idle = TaskFactory::make_kernel_task(Task::idle, "idle");
-    idle->prepare(next_task_id++, TaskManager::on_task_finished);
-    scheduler.set_idle_task(idle);
+    for (u32 cpu = 0; cpu < PerCpu::count(); cpu++) {
+        Task* idle = TaskFactory::make_kernel_task(Task::idle, "idle");
+        idle->prepare(next_task_id++, TaskManager::on_task_finished);
+        idle->kernel_lock_depth = 0;    // idle halts, it must not keep other cpus out of the kernel
+        scheduler.set_idle_task(cpu, idle);
+    }
 }
 
 /**
@@ -49,7 +54,7 @@ void TaskManager::install_multitasking() {
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
 TaskId TaskManager::add_task(Task* task) {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     TaskId tid = next_task_id;
     task->prepare(tid, TaskManager::on_task_finished);
@@ -58,6 +63,7 @@ TaskId TaskManager::add_task(Task* task) {
         return 0;
     }
 
+    wake_cpu_for(task);
     next_task_id++;
     return tid;
 }
@@ -69,33 +75,43 @@ TaskId TaskManager::add_task(Task* task) {
  * @note    Execution context: Task only; be careful with possible reschedule during execution of this method
  */
 void TaskManager::replace_current_task(Task* task) {
-    KLockGuard lock;    // prevent reschedule, especially between "current_task->pml4_phys_addr = 0" and "Task::exit()"
+    {
+        LockGuard<IrqSpinLock> guard(lock);
+
+        Task* current_task = scheduler.get_current_task();
+        TaskId tid = current_task->task_id;
+        task->prepare(tid, TaskManager::on_task_finished);
+        if (!scheduler.add(task)) {
+            delete task;
+            return;
+        }
 
-    Task* current_task = scheduler.get_current_task();
-    TaskId tid = current_task->task_id;
-    task->prepare(tid, TaskManager::on_task_finished);
-    if (!scheduler.add(task)) {
-        delete task;
-        return;
+        // replacement task inherits waiting tasks from current
+        task->finish_wait_list = std::move(current_task->finish_wait_list);
     }
 
-    // replacement task inherits waiting tasks from current
-    task->finish_wait_list = std::move(current_task->finish_wait_list);
-
-    // current task dies
+    // current task dies; exit interrupt takes the lock itself
     Task::exit();
 }
 
 /**
  * @brief   Get reference to the task currently being executer
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
+ * @note    No lock taken: current task of a cpu is only changed by the cpu itself. This lets the page fault handler
+ *          ask for the current task while the faulting code holds the lock
  */
 Task& TaskManager::get_current_task() {
-    KLockGuard lock;    // prevent reschedule
-
     return *scheduler.get_current_task();
 }
 
+/**
+ * @brief   Check if current cpu runs its idle task, ie. has no task to give the time slices to
+ * @note    No lock taken, same as in get_current_task
+ */
+bool TaskManager::is_current_task_idle() {
+    return scheduler.is_idle(PerCpu::current().index);
+}
+
 /**
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
@@ -104,30 +120,56 @@ const TaskList& TaskManager::get_tasks() const {
 }
 
 /**
- * @brief   Sleep current task for at least "millis" milliseconds
+ * @brief   Sleep current task for at least "micros" microseconds
  * @note    Execution context: Interrupt only (in 80h)
  */
-CpuState* TaskManager::sleep_current_task(CpuState* cpu_state, u64 millis) {
-    if (millis > 0) {
+CpuState* TaskManager::sleep_current_task(CpuState* cpu_state, u64 micros) {
+    if (micros > 0) {
         TaskList* tl = new TaskList();
         Requests::OnTimerExpire on_expire = [tl] () { TaskManager::instance().unblock_tasks(*tl); delete tl; };
-        requests->timer_emplace(millis, on_expire);
-        block_current_task(*tl);
+        block_current_task(*tl);    // block first, so the timer cant expire before there is anyone to wake up
+        requests->timer_emplace(micros, on_expire);
     }
 
     return schedule(cpu_state);
 }
 
 /**
- * @brief   Task scheduling routine. Simple round robin is used for now
+ * @brief   Task scheduling routine; which task goes next is up to the scheduler policy
  * @param   cpu_state Current task cpu state.
  * @note    Execution context: Interrupt only (Programmable Interval Timer interrupt, int 80h interrupt)
  */
 CpuState* TaskManager::schedule(CpuState* cpu_state) {
+    LockGuard<IrqSpinLock> guard(lock);
+
     // nothing to schedule? Just return current task
     if (scheduler.count() == 0)
         return cpu_state;
 
+    return switch_task(cpu_state);
+}
+
+/**
+ * @brief   Account the timer tick to current task and reschedule if the scheduler says its time is up
+ * @note    Execution context: Interrupt only (Programmable Interval Timer interrupt)
+ */
+CpuState* TaskManager::on_timer_tick(CpuState* cpu_state) {
+    LockGuard<IrqSpinLock> guard(lock);
+
+    if (scheduler.count() == 0)
+        return cpu_state;
+
+    if (!scheduler.on_tick(requests->get_uptime_us()))
+        return cpu_state;
+
+    return switch_task(cpu_state);
+}
+
+/**
+ * @brief   Store "cpu_state" in current task and return the state of the next task to run
+ * @note    Execution context: Interrupt only, with the lock held
+ */
+CpuState* TaskManager::switch_task(CpuState* cpu_state) {
     // store cpu state in current task
     save_current_task_state(cpu_state);
 
@@ -138,15 +180,15 @@ CpuState* TaskManager::schedule(CpuState* cpu_state) {
 /**
  * @brief   Save cpu_state in current task
  * @note    cpu_state IS LOCATED ON THE KERNEL STACK AND NEEDS TO BE COPIED TO THE TASK-SPECIFIC LOCATION IF SWITCHING FROM RING 3 (USER SPACE)!!!
- *          It is stored to kernel stack by interrupt handler (interrupts.S)
- *          This can be improved by storing cpu_state directly in task-specific location or using per-task kernel stack. To be done later.
+ *          It is stored to kernel stack by interrupt handler (interrupts.S). It is copied to the task itself and not to the user stack,
+ *          as the user stack page may get swapped out while the task waits, and interrupts.S restores the state in ring 0
  * @note    Execution context: Interrupt only
  */
 void TaskManager::save_current_task_state(CpuState* cpu_state) {
     Task* current_task = scheduler.get_current_task();
     if (current_task->is_user_space) {
-        current_task->cpu_state = (CpuState*) ((cpu_state->rsp - sizeof(CpuState))); // allocate cpu state on the current task stack
-        *current_task->cpu_state = *cpu_state;   // copy cpu state from kernel stack to task stack
+        current_task->user_cpu_state = *cpu_state;   // copy cpu state from kernel stack to the task
+        current_task->cpu_state = &current_task->user_cpu_state;
     } else
         current_task->cpu_state = cpu_state;     // cpu state is already allocated and stored on kernel task stack, just remember the pointer
 }
@@ -156,6 +198,8 @@ void TaskManager::save_current_task_state(CpuState* cpu_state) {
  * @note    Execution context: Interrupt only (int 80h)
  */
 hardware::CpuState* TaskManager::kill_current_task() {
+    LockGuard<IrqSpinLock> guard(lock);
+
     Task* current_task = scheduler.get_current_task();
     remove_task(current_task);
 
@@ -164,13 +208,19 @@ hardware::CpuState* TaskManager::kill_current_task() {
 
 /**
  * @brief   Remove "task", wake up all awaiting tasks
+ * @note    Task being run by other cpu is only marked KILLED; that cpu removes it when it switches away from the task
  */
 void TaskManager::remove_task(Task* task) {
-    // enqueue back all waiting tasks and delete the task itself
-    wakeup_waitings_and_delete_task(task);
+    if (task->is_on_cpu && task->cpu != PerCpu::current().index) {
+        scheduler.kill(task);
+        return;
+    }
 
-    // remove the task from running queue
+    // remove the task from running queue; scheduler still needs the task alive for that
     scheduler.remove(task);
+
+    // enqueue back all waiting tasks and delete the task itself
+    wakeup_waitings_and_delete_task(task);
 }
 
 /**
@@ -187,6 +237,8 @@ hardware::CpuState* TaskManager::kill_current_task_group() {
  * @note    Execution context: Interrupt only (int 80h)
  */
 hardware::CpuState* TaskManager::kill_task_group(CpuState* cpu_state, TaskId task_id) {
+    LockGuard<IrqSpinLock> guard(lock);
+
     auto task = scheduler.get_by_tid(task_id);
     if (!task) {
         cpu_state->rax = -(s64)middlespace::ErrorCode::EC_SRCH; // return value
@@ -231,7 +283,7 @@ void TaskManager::collect_children_tasks_recursively(const Task* parent, TaskLis
  * @brief   Wake up tasks waiting for "task" to finish, then delete the "task" itself
  */
 void TaskManager::wakeup_waitings_and_delete_task(Task* task) {
-    unblock_tasks(task->finish_wait_list);
+    unblock_all(task->finish_wait_list, false);
     delete task;
 }
 
@@ -249,10 +301,10 @@ Task TaskManager::get_boot_task() const {
  * @note    To actually reschedule, one should call Task::yield() afterwards
  */
 bool TaskManager::wait(TaskId task_id) {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     if (Task* t = scheduler.get_by_tid(task_id)) {
-        block_current_task(t->finish_wait_list);
+        block_task(scheduler.get_current_task(), t->finish_wait_list);
         return true;
     }
     return false;
@@ -263,40 +315,100 @@ bool TaskManager::wait(TaskId task_id) {
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
 void TaskManager::block_current_task(TaskList& list) {
-    KLockGuard lock;   // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
-    Task* current_task = scheduler.get_current_task();
-    current_task->state = TaskState::BLOCKED;
-    list.push_front(current_task);
+    block_task(scheduler.get_current_task(), list);
+}
+
+/**
+ * @brief   Block "task" and put it on waiting "list"
+ * @note    Execution context: Task/Interrupt, with the lock held
+ */
+void TaskManager::block_task(Task* task, TaskList& list) {
+    scheduler.block(task);
+    list.push_front(task);
 }
 
 /**
  * @brief   Unblock the tasks from waiting "list"
+ * @param   boost Give the tasks their base priority back, eg. they waited for input and should respond quickly
  * @note    TASK MUST HAVE BEEN FIRST ADDED AND INITIALIZED WITH "add_task"
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
-void TaskManager::unblock_tasks(TaskList& list) {
-    KLockGuard lock;   // prevent reschedule
+void TaskManager::unblock_tasks(TaskList& list, bool boost) {
+    LockGuard<IrqSpinLock> guard(lock);
 
+    unblock_all(list, boost);
+}
+
+/**
+ * @brief   Unblock the tasks from waiting "list"
+ * @note    Execution context: Task/Interrupt, with the lock held
+ */
+void TaskManager::unblock_all(TaskList& list, bool boost) {
     while (Task* t = list.pop_front()) {
-        if (scheduler.is_valid_task(t)) // task might have been deleted while sleeping (exit_group)
-            t->state = TaskState::RUNNING;
+        scheduler.unblock(t, boost);    // task might have been deleted while sleeping (exit_group); scheduler skips such task
+        wake_cpu_for(t);
     }
 }
 
+/**
+ * @brief   Runnable "task" was queued; wake an idle cpu up to run it, as idle cpu has no timer ticks to notice the task
+ * @note    Execution context: Task/Interrupt, with the lock held
+ */
+void TaskManager::wake_cpu_for(Task* task) {
+    u32 cpu;
+    if (scheduler.find_cpu_to_wake(task, cpu))
+        requests->wake_cpu(cpu);
+}
+
+/**
+ * @brief   Set nice value of "task_id", or of current task if "task_id" is 0
+ * @return  EC_OK on success, EC_SRCH if no such task, EC_INVAL if "nice" is out of range
+ * @note    Execution context: Task/Interrupt/Syscall without the kernel lock, so only the scheduler data guarded by "lock" is touched
+ */
+middlespace::ErrorCode TaskManager::set_nice(TaskId task_id, s32 nice) {
+    LockGuard<IrqSpinLock> guard(lock);
+
+    Task* task = (task_id == 0) ? scheduler.get_current_task() : scheduler.get_by_tid(task_id);
+    if (!task)
+        return middlespace::ErrorCode::EC_SRCH;
+
+    if (!scheduler.set_nice(task, nice))
+        return middlespace::ErrorCode::EC_INVAL;
+
+    return middlespace::ErrorCode::EC_OK;
+}
+
 /**
  * @brief   Choose next task to run and load its page table level4 into cr3
  * @note    Execution context: Interrupt only (on kill_current_task, schedule)
  * @note    There always need to be at least the "idle" task on the queue
+ * @note    KernelLock depth is per task: kernel task holds the lock while it runs, user task and idle dont.
+ *          Interrupt handler took one level on entry and interrupts.S drops it on return, so it stays on top of next task depth
  */
 CpuState* TaskManager::pick_next_task_and_load_address_space() {
+    // current task might have been killed by other cpu while being run here
+    if (scheduler.get_current_task()->state == TaskState::KILLED)
+        remove_task(scheduler.get_current_task());
+
     Task* curr_task {scheduler.get_current_task()};
     Task* next_task {scheduler.pick_next_task()};
 
-    // reload address space only if task_group changes (each group has its own address space)
-    if (curr_task->task_group_data != next_task->task_group_data) 
+    // tasks left waiting here can run on an idle cpu, that has no timer ticks to come and steal them by itself
+    u32 idle_cpu;
+    if (scheduler.find_cpu_to_steal(idle_cpu))
+        requests->wake_cpu(idle_cpu);
+
+    // reload address space only if task_group changes (each group has its own address space);
+    // boot task stands in for removed task, whose address space is gone
+    if (curr_task == &boot_task || curr_task->task_group_data != next_task->task_group_data)
         requests->load_address_space(next_task->task_group_data->address_space);
 
+    if (curr_task != &boot_task)
+        curr_task->kernel_lock_depth = KernelLock::get_depth() - 1;
+    KernelLock::set_depth(next_task->kernel_lock_depth + 1);
+
     return next_task->cpu_state;
 }
 } // namespace multitasking {
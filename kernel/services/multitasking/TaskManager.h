@@ -9,7 +9,9 @@
 #define SRC_TASKMANAGER_H_
 
 #include "Task.h"
-#include "RoundRobinScheduler.h"
+#include "ErrorCode.h"
+#include "MlfqScheduler.h"
+#include "SpinLock.h"
 
 namespace multitasking {
 
@@ -23,20 +25,27 @@ public:
     TaskId add_task(Task* task);
     void replace_current_task(Task* task);
     Task& get_current_task();
+    bool is_current_task_idle();
     const TaskList& get_tasks() const;
-    hardware::CpuState* sleep_current_task(hardware::CpuState* cpu_state, u64 millis);
+    hardware::CpuState* sleep_current_task(hardware::CpuState* cpu_state, u64 micros);
     hardware::CpuState* schedule(hardware::CpuState* cpu_state);
+    hardware::CpuState* on_timer_tick(hardware::CpuState* cpu_state);
     hardware::CpuState* kill_current_task();
     hardware::CpuState* kill_current_task_group();
     hardware::CpuState* kill_task_group(hardware::CpuState* cpu_state, TaskId task_id);
     bool wait(TaskId task_id);
     void block_current_task(TaskList& list);
-    void unblock_tasks(TaskList& list);
+    void unblock_tasks(TaskList& list, bool boost = false);
+    middlespace::ErrorCode set_nice(TaskId task_id, s32 nice);
 
 private:
     static void on_task_finished();
     TaskManager() : boot_task(get_boot_task()), scheduler(&boot_task) {}
+    hardware::CpuState* switch_task(hardware::CpuState* cpu_state);
     void save_current_task_state(hardware::CpuState* cpu_state);
+    void block_task(Task* task, TaskList& list);
+    void unblock_all(TaskList& list, bool boost);
+    void wake_cpu_for(Task* task);
     hardware::CpuState* pick_next_task_and_load_address_space();
     void wakeup_waitings_and_delete_task(Task* task);
     Task get_boot_task() const;
@@ -46,8 +55,9 @@ private:
     static TaskManager _instance;
 
     Task                    boot_task;              // represents "kmain" boot task
-    RoundRobinScheduler     scheduler;
+    MlfqScheduler           scheduler;              // any Scheduler implementation fits here, eg. RoundRobinScheduler
     TaskId                  next_task_id    = 0;    // id to assign to the next task while adding
+    IrqSpinLock             lock            {"tasks"};  // guards the scheduler; public methods take it, private ones expect it held
 };
 
 }
@@ -6,7 +6,6 @@
  */
 
 #include "TimeManager.h"
-#include "KLockGuard.h"
 
 using namespace multitasking;
 
@@ -18,36 +17,55 @@ TimeManager& TimeManager::instance() {
     return _instance;
 }
 
+/**
+ * @brief   Convert "ticks" of a clock running at "hz" to microseconds; split, so the multiplication does not overflow
+ */
+static u64 ticks_to_us(u64 ticks, u64 hz) {
+    constexpr u64 US_PER_SECOND {1000 * 1000};
+    return ticks / hz * US_PER_SECOND + ticks % hz * US_PER_SECOND / hz;
+}
+
 /**
  * @brief   Clock tick function; makes the time pass
  * @note    Execution context: Interrupt only (Programmable Interval Timer)
  */
-// TODO: improve so no need to update all timers every tick
 void TimeManager::tick() {
-    total_tick_count++;
-
-    // return if there is no timers to process
-    if (timers.count() == 0)
-        return;
-
-    // time passes
-    for (Timer* t : timers)
-        t->remaining_ticks--;
-
-    // does the soonest timer expire?
-    if (timers.front()->remaining_ticks > 0)
-        return;
-
-    // soonest timer expires
-    Timer* t = timers.pop_front();
-
-    // run expire and reload/remove timer
-    t->on_expire();
-    if (t->reload_ticks) {
-        t->remaining_ticks = t->reload_ticks;
-        timers.push_sorted_ascending_by_expire_time(t);
-    } else
-        delete t;
+    __atomic_add_fetch(&total_tick_count, 1, __ATOMIC_RELAXED);
+    expire_timers();
+}
+
+/**
+ * @brief   Run and reload/remove the timers whose time has come
+ * @note    Execution context: Interrupt only (timer interrupt)
+ * @note    Expired timer handler is run without the lock held, so it can emplace timers and wake tasks up
+ */
+void TimeManager::expire_timers() {
+    const u64 now = get_uptime_us();
+
+    while (true) {
+        Timer* expired;
+        {
+            LockGuard<IrqSpinLock> guard(lock);
+
+            // does the soonest timer expire?
+            if (timers.count() == 0 || timers.front()->expire_at_us > now)
+                return;
+
+            // soonest timer expires
+            expired = timers.pop_front();
+        }
+
+        // run expire and reload/remove timer
+        expired->on_expire();
+        if (expired->reload_us) {
+            LockGuard<IrqSpinLock> guard(lock);
+            expired->expire_at_us += expired->reload_us;
+            if (expired->expire_at_us <= now)   // periods missed; dont catch up with them all at once
+                expired->expire_at_us = now + expired->reload_us;
+            timers.push_sorted_ascending_by_expire_time(expired);
+        } else
+            delete expired;
+    }
 }
 
 u64 TimeManager::get_ticks() const {
@@ -62,6 +80,40 @@ u64 TimeManager::get_hz() const {
     return tick_frequency;
 }
 
+/**
+ * @brief   Switch from counting ticks to reading "read_clock" that runs at "clock_hz"; uptime goes on from where it is.
+ *          Periodic ticks are not needed from now on
+ * @note    Tick interrupt must be off, so the uptime does not change underneath, and no other cpu may be reading the time yet
+ */
+void TimeManager::set_clock(const ReadClock& read_clock, u64 clock_hz) {
+    LockGuard<IrqSpinLock> guard(lock);
+
+    clock_start_us = get_uptime_us();
+    clock_start = read_clock();
+    clock_frequency = clock_hz;
+    this->read_clock = read_clock;
+}
+
+/**
+ * @brief   Get microseconds since the boot; resolution is of the tick until a clock is set
+ * @note    Execution context: Task/Interrupt
+ */
+u64 TimeManager::get_uptime_us() const {
+    if (!read_clock)
+        return ticks_to_us(__atomic_load_n(&total_tick_count, __ATOMIC_RELAXED), tick_frequency);
+
+    return clock_start_us + ticks_to_us(read_clock() - clock_start, clock_frequency);
+}
+
+/**
+ * @brief   Get uptime at which the soonest timer expires, NO_EXPIRE if there are no timers
+ */
+u64 TimeManager::get_next_expire_us() {
+    LockGuard<IrqSpinLock> guard(lock);
+
+    return timers.count() == 0 ? NO_EXPIRE : timers.front()->expire_at_us;
+}
+
 /**
  * @brief   Emplace a new one-shoot timer
  * @param   expire_millis After how many milliseconds to expire
@@ -82,11 +134,21 @@ TimerId TimeManager::emplace(u32 expire_millis, const OnTimerExpire& on_expire)
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
 TimerId TimeManager::emplace(u32 expire_millis, u32 reload_millis, const OnTimerExpire& on_expire) {
-    KLockGuard lock;    // prevent reschedule
+    return emplace_us(expire_millis * 1000ull, reload_millis * 1000ull, on_expire);
+}
+
+/**
+ * @brief   Emplace a new timer of microsecond resolution; it is as precise as the timer interrupt is
+ * @param   expire_micros After how many microseconds to expire
+ * @param   reload_micros Value to reset the timer to after it expires, 0 means no reload
+ * @param   on_expire What to do on expire
+ * @return  Newly added timer id
+ * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
+ */
+TimerId TimeManager::emplace_us(u64 expire_micros, u64 reload_micros, const OnTimerExpire& on_expire) {
+    Timer* t = new Timer(get_uptime_us() + expire_micros, reload_micros, on_expire);
 
-    u32 remaining_ticks = get_hz() * expire_millis / 1000;
-    u32 reload_ticks = get_hz() * reload_millis / 1000;
-    Timer* t = new Timer(remaining_ticks, reload_ticks, on_expire);
+    LockGuard<IrqSpinLock> guard(lock);
     t->timer_id = next_timer_id;
     timers.push_sorted_ascending_by_expire_time(t);
     next_timer_id++;
@@ -98,7 +160,7 @@ TimerId TimeManager::emplace(u32 expire_millis, u32 reload_millis, const OnTimer
  * @note    Execution context: Task/Interrupt; be careful with possible reschedule during execution of this method
  */
 void TimeManager::cancel(TimerId timer_id) {
-    KLockGuard lock;    // prevent reschedule
+    LockGuard<IrqSpinLock> guard(lock);
 
     if (Timer* t = timers.get_by_tid(timer_id))
         timers.remove(timers.find(t));
@@ -8,24 +8,37 @@
 #ifndef KERNEL_TIME_TIMEMANAGER_H_
 #define KERNEL_TIME_TIMEMANAGER_H_
 
+#include <functional>
 #include "types.h"
 #include "Timer.h"
 #include "TimerList.h"
+#include "SpinLock.h"
 
 namespace ktime {
 
+using ReadClock = std::function<u64()>;
+
 /**
- * @brief   This class provides time related functionality, like current tick, scheduling events(timers)
+ * @brief   This class provides time related functionality, like current tick, scheduling events(timers).
+ *          Time is counted in periodic ticks until a free running clock is set; timers expire at microsecond deadlines,
+ *          so with a one-shot timer interrupt programmed for get_next_expire_us() there is no need for periodic ticks
  */
 class TimeManager {
 public:
+    static constexpr u64 NO_EXPIRE {0xFFFFFFFFFFFFFFFF};
+
     static TimeManager& instance();
     void tick();
+    void expire_timers();
     u64 get_ticks() const;
     void set_hz(u64 tick_frequency_in_hz);
     u64 get_hz() const;
+    void set_clock(const ReadClock& read_clock, u64 clock_hz);
+    u64 get_uptime_us() const;
+    u64 get_next_expire_us();
     TimerId emplace(u32 millis, const OnTimerExpire& on_expire);
     TimerId emplace(u32 expire_millis, u32 reload_millis, const OnTimerExpire& on_expire);
+    TimerId emplace_us(u64 expire_micros, u64 reload_micros, const OnTimerExpire& on_expire);
     void cancel(TimerId timer_id);
 
 private:
@@ -34,8 +47,13 @@ private:
     static TimeManager _instance;
     u64         total_tick_count    {0};
     u64         tick_frequency      {1};
+    ReadClock   read_clock;                 // free running clock; ticks are counted until it is set
+    u64         clock_frequency     {1};
+    u64         clock_start         {0};    // read_clock() when the clock was set
+    u64         clock_start_us      {0};    // uptime when the clock was set
     TimerId     next_timer_id       {1};
     TimerList   timers;
+    multitasking::IrqSpinLock   lock    {"time"};   // guards the timers; timer interrupt handlers change them
 };
 
 } /* namespace time */
@@ -17,12 +17,12 @@ using OnTimerExpire = std::function<void()>;
 
 class Timer {
 public:
-    Timer(s64 remaining_ticks, const OnTimerExpire& on_expire) : remaining_ticks(remaining_ticks), reload_ticks(0), on_expire(on_expire) {}
-    Timer(s64 remaining_ticks, u32 reload_ticks, const OnTimerExpire& on_expire) : remaining_ticks(remaining_ticks), reload_ticks(reload_ticks), on_expire(on_expire) {}
+    Timer(u64 expire_at_us, const OnTimerExpire& on_expire) : on_expire(on_expire), expire_at_us(expire_at_us), reload_us(0) {}
+    Timer(u64 expire_at_us, u64 reload_us, const OnTimerExpire& on_expire) : on_expire(on_expire), expire_at_us(expire_at_us), reload_us(reload_us) {}
 
     OnTimerExpire   on_expire;
-    s64             remaining_ticks;        // how many clock ticks left to expire
-    u32             reload_ticks;           // value to reset the remaining_ticks to after timer expires
+    u64             expire_at_us;           // system uptime in microseconds at which the timer expires
+    u64             reload_us;              // period to move the expire_at_us by after timer expires, 0 means no reload
     TimerId         timer_id        {0};    // set by TimeManager when adding timer
 };
 
@@ -17,7 +17,8 @@ void TimerList::push_sorted_ascending_by_expire_time(Timer* t) {
     ListItem* new_item = new ListItem(t);
 
     // case 1. adding head item
-    if (!m_head) {
+    if (!m_head || m_head->data->expire_at_us > t->expire_at_us) {
+        new_item->next = m_head;
         m_head = new_item;
         m_count++;
         return;
@@ -28,7 +29,7 @@ void TimerList::push_sorted_ascending_by_expire_time(Timer* t) {
     ListItem* curr = m_head->next;
 
     while (curr) {
-        if (curr->data->remaining_ticks > t->remaining_ticks) { // current expires after "t"
+        if (curr->data->expire_at_us > t->expire_at_us) { // current expires after "t"
             prev->next = new_item;
             new_item->next = curr;
             m_count++;
@@ -12,15 +12,15 @@ using namespace cstd;
 
 namespace filesystem {
 
-UnixPath::UnixPath(const UnixPath& o) : path(o.path) {
+UnixPath::UnixPath(const UnixPath& o) : path(o.path), hash(o.hash) {
 }
 
 UnixPath::UnixPath(const char path[]) :
-    path(normalize(path)) {
+    path(normalize(path)), hash(Hash<string>()(this->path)) {
 }
 
 UnixPath::UnixPath(const string& path) :
-    path(normalize(path)) {
+    path(normalize(path)), hash(Hash<string>()(this->path)) {
 }
 
 bool UnixPath::is_valid_path() const {
@@ -46,7 +46,7 @@ UnixPath::operator string() const {
 }
 
 bool UnixPath::operator==(const UnixPath& other) const {
-    return path == other.path;
+    return hash == other.hash && path == other.path;
 }
 
 /**
@@ -9,6 +9,7 @@
 #define SRC_FILESYSTEM_UNIXPATH_H_
 
 #include "String.h"
+#include "Hash.h"
 
 namespace filesystem {
 
@@ -26,15 +27,28 @@ public:
     bool is_root_path() const;
     operator cstd::string() const;
     bool operator==(const UnixPath& other) const;
+    size_t get_hash() const { return hash; }
     cstd::string extract_directory() const;
     cstd::string extract_file_name() const;
 
 private:
     cstd::string normalize(const cstd::string& path) const;
     cstd::string path;
+    size_t       hash;  // computed once, as paths are mostly created to be looked up
 
 };
 
 } /* namespace filesystem */
 
+namespace cstd {
+
+template <>
+struct Hash<filesystem::UnixPath> {
+    size_t operator()(const filesystem::UnixPath& key) const {
+        return key.get_hash();
+    }
+};
+
+} /* namespace cstd */
+
 #endif /* SRC_FILESYSTEM_UNIXPATH_H_ */
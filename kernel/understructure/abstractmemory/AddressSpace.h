@@ -2,13 +2,40 @@
 #define ADDRESS_SPACE
 
 #include "types.h"
+#include "MemoryArea.h"
 
 namespace memory {
 
+/**
+ * @brief   Thread stack no longer in use; its guard page stays in place, so it can be handed to a new thread as is
+ */
+struct FreeStack {
+    u64 stack_bottom;
+    u64 num_bytes;
+};
+
+using FreeStacks = cstd::vector<FreeStack>;
+
+/**
+ * @brief   Counters of address space events; resident and swapped out pages are counted by walking the page tables instead,
+ *          as any task can take a frame away from any address space by swapping it out
+ */
+struct AddressSpaceStats {
+    u64 stacks_count;       // thread stacks in use, not counting the stacks waiting for reuse
+    u64 page_faults;        // missing user pages allocated or brought back from swap space
+    u64 swap_in_faults;     // page faults that brought a page back from swap space
+};
+
 struct AddressSpace {
-    u64     heap_low_limit;     // last address allocated for the heap, current program break
-    u64     heap_high_limit;    // last address allocable for the heap
-    u64     pml4_phys_addr;     // page table root physical address
+    u64             heap_low_limit;     // last address allocated for the heap, current program break
+    u64             heap_high_limit;    // last address allocable for the heap
+    u64             pml4_phys_addr;     // page table root physical address
+    u64             heap_start;         // program break the address space was created with; the program image lies below
+    u16             pcid;               // process-context identifier tagging TLB entries; 0 means untagged
+    MemoryAreas     memory_areas;       // file-backed and anonymous memory ranges, populated on page fault
+    VirtualRanges   unmapped_ranges;    // memory areas released with "munmap", to be reused by "mmap"
+    FreeStacks      free_stacks;        // stacks of finished threads, to be reused by new threads
+    AddressSpaceStats stats;            // memory usage counters, to find memory hogs
 };
 
 } /* namespace memory */
@@ -0,0 +1,44 @@
+/**
+ *   @file: MemoryArea.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef MEMORY_AREA
+#define MEMORY_AREA
+
+#include "types.h"
+#include "Vector.h"
+#include "OpenEntry.h"
+
+namespace memory {
+
+/**
+ * @brief   Range of virtual memory that is populated page by page on first access, either from a file or with zeros.
+ *          Bytes past "file_size" are zero (eg. .bss part of ELF segment); anonymous area has no file and "file_size" of 0
+ */
+struct MemoryArea {
+    u64                         first_byte;     // first virtual byte of the area
+    u64                         last_byte;      // last virtual byte of the area
+    u64                         file_offset;    // file offset that "first_byte" maps to
+    u64                         file_size;      // number of bytes that come from the file
+    filesystem::OpenEntryPtr    file;           // nullptr for anonymous area
+    bool                        writable;       // pages get mapped read-only otherwise
+};
+
+using MemoryAreas = cstd::vector<MemoryArea>;
+
+/**
+ * @brief   Range of virtual memory released with "munmap", to be reused by next "mmap"
+ */
+struct VirtualRange {
+    u64 first_byte;
+    u64 last_byte;
+};
+
+using VirtualRanges = cstd::vector<VirtualRange>;
+
+} /* namespace memory */
+
+#endif
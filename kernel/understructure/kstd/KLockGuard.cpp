@@ -6,15 +6,17 @@
  */
 
 #include "KLockGuard.h"
+#include "KernelLock.h"
 
 namespace multitasking {
 
 KLockGuard::KLockGuard() {
     asm volatile("pushfq; pop %0; cli;" : "=g" (rflags));
-
+    KernelLock::lock();
 }
 
 KLockGuard::~KLockGuard() {
+    KernelLock::unlock();
     asm volatile("push %0; popfq; " :: "g" (rflags));
 }
 
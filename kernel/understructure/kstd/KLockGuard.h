@@ -13,7 +13,7 @@
 namespace multitasking {
 
 /**
- * @class   This class is a guard lock that disables interrupts for its lifetime; for protecting kernel structures access
+ * @class   This class is a guard lock that disables interrupts and holds the KernelLock for its lifetime; for protecting kernel structures access
  */
 class KLockGuard {
 public:
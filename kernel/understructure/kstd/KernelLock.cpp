@@ -0,0 +1,73 @@
+/**
+ *   @file: KernelLock.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "KernelLock.h"
+#include "PerCpu.h"
+#include "LockStats.h"
+
+using namespace hardware;
+
+// globals, so interrupts.S can release the lock
+extern "C" volatile u32 kernel_lock_owner;  // PerCpu::index + 1 of the owning cpu, 0 if free
+extern "C" u32          kernel_lock_depth;  // times the owner has taken the lock
+
+volatile u32 kernel_lock_owner {0};
+u32          kernel_lock_depth {0};
+
+namespace multitasking {
+
+static LockStats stats {"kernel"};  // contention only; the lock is released in interrupts.S and on task switch, so the hold time is not counted
+
+/**
+ * @brief   Take the lock, spinning until other cpu releases it. While spinning, the TLB shootdowns are served,
+ *          as the cpu that holds the lock may be waiting for them
+ */
+void KernelLock::lock() {
+    const u32 me = PerCpu::current().index + 1;
+    if (kernel_lock_owner == me) {
+        kernel_lock_depth++;
+        return;
+    }
+
+    const u64 spin_start = LockStats::get_cycles();
+    bool was_contended = false;
+    u32 expected = 0;
+    while (!__atomic_compare_exchange_n(&kernel_lock_owner, &expected, me, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        was_contended = true;
+        PerCpu::flush_tlb_if_requested();
+        asm volatile("pause");
+        expected = 0;
+    }
+    kernel_lock_depth = 1;
+    stats.on_acquired(was_contended, spin_start);
+}
+
+void KernelLock::unlock() {
+    if (--kernel_lock_depth == 0)
+        __atomic_store_n(&kernel_lock_owner, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Get times the current cpu has taken the lock
+ */
+u32 KernelLock::get_depth() {
+    if (kernel_lock_owner != PerCpu::current().index + 1)
+        return 0;
+
+    return kernel_lock_depth;
+}
+
+/**
+ * @brief   Set times the current cpu, that holds the lock, has taken it; used when switching tasks. Depth 0 releases the lock
+ */
+void KernelLock::set_depth(u32 depth) {
+    kernel_lock_depth = depth;
+    if (depth == 0)
+        __atomic_store_n(&kernel_lock_owner, 0, __ATOMIC_RELEASE);
+}
+
+} /* namespace multitasking */
@@ -0,0 +1,32 @@
+/**
+ *   @file: KernelLock.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_UNDERSTRUCTURE_KSTD_KERNELLOCK_H_
+#define KERNEL_UNDERSTRUCTURE_KSTD_KERNELLOCK_H_
+
+#include "types.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class is the big kernel lock: a recursive spin lock that lets only one cpu at a time run the kernel code.
+ *          It is taken on every interrupt entry, on syscall entry but for the syscalls that only need the subsystem locks, and by KLockGuard. Kernel tasks hold it for as long as they run,
+ *          as the kernel code was written for a single cpu. Taking the lock is only allowed with interrupts disabled.
+ * @note    Lock depth belongs to the task that took it, see Task::kernel_lock_depth.
+ *          The level taken by InterruptManager::on_interrupt is dropped in interrupts.S
+ */
+class KernelLock {
+public:
+    static void lock();
+    static void unlock();
+    static u32 get_depth();
+    static void set_depth(u32 depth);
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_UNDERSTRUCTURE_KSTD_KERNELLOCK_H_ */
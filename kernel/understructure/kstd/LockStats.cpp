@@ -0,0 +1,69 @@
+/**
+ *   @file: LockStats.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "LockStats.h"
+
+namespace multitasking {
+
+static LockStats* first_stats {nullptr};    // named locks list; locks are created on boot, so the list needs no lock of its own
+
+/**
+ * @brief   Constructor. Named stats are put on the list, unnamed ones count nothing
+ */
+LockStats::LockStats(const char* name) : name(name) {
+    if (!name)
+        return;
+
+    next = first_stats;
+    first_stats = this;
+}
+
+LockStats::~LockStats() {
+    for (LockStats** s = &first_stats; *s; s = &(*s)->next)
+        if (*s == this) {
+            *s = next;
+            return;
+        }
+}
+
+/**
+ * @brief   Count the lock being taken
+ * @param   spin_start Cycles when the waiting started; only used if the lock was contended
+ */
+void LockStats::on_acquired(bool was_contended, u64 spin_start) {
+    acquisitions++;
+    if (was_contended) {
+        contentions++;
+        spin_cycles += get_cycles() - spin_start;
+    }
+}
+
+/**
+ * @brief   Count the time the lock was held for
+ * @param   hold_start Cycles when the lock was taken
+ */
+void LockStats::on_released(u64 hold_start) {
+    const u64 hold = get_cycles() - hold_start;
+    hold_cycles += hold;
+    if (hold > max_hold_cycles)
+        max_hold_cycles = hold;
+}
+
+LockStats* LockStats::get_first() {
+    return first_stats;
+}
+
+/**
+ * @brief   Read the cpu timestamp counter
+ */
+u64 LockStats::get_cycles() {
+    u32 lo, hi;
+    asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64)hi << 32) | lo;
+}
+
+} /* namespace multitasking */
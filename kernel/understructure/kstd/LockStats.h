@@ -0,0 +1,45 @@
+/**
+ *   @file: LockStats.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_UNDERSTRUCTURE_KSTD_LOCKSTATS_H_
+#define KERNEL_UNDERSTRUCTURE_KSTD_LOCKSTATS_H_
+
+#include "types.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class holds the usage counters of a lock. Only the named locks are counted; every named lock's stats
+ *          get listed by LockStats::get_first(), so they can be shown in /proc/locks.
+ *          Times are in cpu timestamp counter cycles
+ */
+class LockStats {
+public:
+    LockStats(const char* name);
+    ~LockStats();
+    LockStats(const LockStats&) = delete;
+    LockStats& operator=(const LockStats&) = delete;
+
+    void on_acquired(bool was_contended, u64 spin_start);
+    void on_released(u64 hold_start);
+    bool is_enabled() const { return name != nullptr; }
+
+    static LockStats* get_first();
+    static u64 get_cycles();
+
+    const char* const   name;
+    LockStats*          next                {nullptr};
+    u64                 acquisitions        {0};
+    u64                 contentions         {0};    // times the lock was taken by other cpu and had to be waited for
+    u64                 spin_cycles         {0};    // total time spent waiting for the lock
+    u64                 hold_cycles         {0};    // total time the lock was held; readers of reader-writer lock are not timed
+    u64                 max_hold_cycles     {0};
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_UNDERSTRUCTURE_KSTD_LOCKSTATS_H_ */
@@ -0,0 +1,79 @@
+/**
+ *   @file: PerCpu.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "PerCpu.h"
+
+namespace hardware {
+
+static PerCpu   per_cpu[PerCpu::MAX_CPUS];
+static u32      cpu_count {1};  // bootstrap cpu is always there
+
+/**
+ * @brief   Fill PerCpu of cpu "index" and make it the current cpu PerCpu by setting GS base
+ * @note    Must be run on the cpu itself, before any kernel entry can happen. User GS base starts at 0
+ */
+void PerCpu::install(u32 index, u64 kernel_stack_top) {
+    constexpr u32 IA32_GS_BASE          = 0xC0000101;
+    constexpr u32 IA32_KERNEL_GS_BASE   = 0xC0000102;   // swapped with GS base by swapgs
+
+    PerCpu& cpu = per_cpu[index];
+    cpu.self = &cpu;
+    cpu.index = index;
+    cpu.kernel_stack_top = kernel_stack_top;
+
+    const u64 base = (u64)&cpu;
+    asm volatile("wrmsr" : : "c"(IA32_GS_BASE), "a"((u32)base), "d"((u32)(base >> 32)));
+    asm volatile("wrmsr" : : "c"(IA32_KERNEL_GS_BASE), "a"(0), "d"(0));
+}
+
+/**
+ * @brief   Get PerCpu of the cpu this code runs on
+ */
+PerCpu& PerCpu::current() {
+    PerCpu* cpu;
+    asm volatile("mov %%gs:0, %0" : "=r"(cpu));
+    return *cpu;
+}
+
+PerCpu& PerCpu::get(u32 index) {
+    return per_cpu[index];
+}
+
+/**
+ * @brief   Get number of cpus that got booted
+ */
+u32 PerCpu::count() {
+    return cpu_count;
+}
+
+void PerCpu::set_count(u32 count) {
+    cpu_count = count;
+}
+
+/**
+ * @brief   Drop all TLB entries of the current cpu, including global ones and the ones of other PCIDs,
+ *          if other cpu asked for it. Toggling CR4.PGE is the only single operation that does it.
+ *          The request is taken before flushing, so the one that comes during the flush is not lost
+ * @see     https://www.intel.com/content/dam/www/public/us/en/documents/manuals/64-ia-32-architectures-software-developer-vol-3a-part-1-manual.pdf, 4.10.4.1 Operations that Invalidate TLBs and Paging-Structure Caches
+ */
+void PerCpu::flush_tlb_if_requested() {
+    if (!__atomic_exchange_n(&current().tlb_flush_requested, false, __ATOMIC_ACQ_REL))
+        return;
+
+    asm volatile (
+            "mov %%cr4, %%rax       ;"
+            "xor $0x80, %%rax       ;"
+            "mov %%rax, %%cr4       ;"
+            "xor $0x80, %%rax       ;"
+            "mov %%rax, %%cr4       ;"
+            :
+            :
+            : "rax", "memory"
+    );
+}
+
+} /* namespace hardware */
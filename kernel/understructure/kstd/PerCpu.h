@@ -0,0 +1,48 @@
+/**
+ *   @file: PerCpu.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_UNDERSTRUCTURE_KSTD_PERCPU_H_
+#define KERNEL_UNDERSTRUCTURE_KSTD_PERCPU_H_
+
+#include "types.h"
+
+namespace hardware {
+
+/**
+ * @brief   This struct holds the data that every cpu needs a copy of. Kernel GS base of a cpu points to its own PerCpu,
+ *          so PerCpu::current() is a single instruction. User space runs with its own GS; kernel entries in interrupts.S
+ *          and syscalls.S swapgs to get the kernel one.
+ * @note    Fields up to "interrupt_number" are accessed from assembly by their offsets; keep them in place
+ */
+struct PerCpu {
+    static constexpr u32 MAX_CPUS   {8};
+
+    PerCpu*         self;               // offset 0; lets current() read the address through GS
+    u64             user_rsp;           // offset 8; user stack pointer saved on syscall entry
+    u64             kernel_stack_top;   // offset 16; stack the syscalls run on, also TSS rsp0 of the cpu
+    u8              interrupt_number;   // offset 24; number of the interrupt being handled, set by interrupt entry stub
+    u32             index;              // 0 for bootstrap cpu, then application cpus in order they got booted
+    u32             apic_id;            // local APIC id; filled by bootstrap cpu
+    volatile bool   is_online;          // cpu runs tasks and takes part in TLB shootdowns
+    volatile bool   tlb_flush_requested;// other cpu changed page tables this cpu may have cached, see Smp::shootdown_tlb
+    u32             spin_locks_held;    // IrqSpinLocks and RwSpinLock guards the cpu holds now, see IrqSpinLock::save_and_disable_interrupts
+
+    static void install(u32 index, u64 kernel_stack_top);
+    static PerCpu& current();
+    static PerCpu& get(u32 index);
+    static u32 count();
+    static void set_count(u32 count);
+    static void flush_tlb_if_requested();
+};
+
+static_assert(__builtin_offsetof(PerCpu, user_rsp) == 8, "PerCpu::user_rsp offset is used by syscalls.S");
+static_assert(__builtin_offsetof(PerCpu, kernel_stack_top) == 16, "PerCpu::kernel_stack_top offset is used by syscalls.S");
+static_assert(__builtin_offsetof(PerCpu, interrupt_number) == 24, "PerCpu::interrupt_number offset is used by interrupts.S");
+
+} /* namespace hardware */
+
+#endif /* KERNEL_UNDERSTRUCTURE_KSTD_PERCPU_H_ */
@@ -0,0 +1,87 @@
+/**
+ *   @file: RwSpinLock.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "RwSpinLock.h"
+#include "SpinLock.h"
+#include "PerCpu.h"
+
+using namespace hardware;
+
+namespace multitasking {
+
+/**
+ * @brief   Join the readers once there is no writer
+ */
+void RwSpinLock::lock_read() {
+    const u64 spin_start = stats.is_enabled() ? LockStats::get_cycles() : 0;
+
+    bool was_contended = false;
+    while (true) {
+        s32 readers = __atomic_load_n(&state, __ATOMIC_RELAXED);
+        if (readers != WRITER && __atomic_compare_exchange_n(&state, &readers, readers + 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            break;
+
+        was_contended = true;
+        PerCpu::flush_tlb_if_requested();
+        asm volatile("pause");
+    }
+
+    if (stats.is_enabled())
+        stats.on_acquired(was_contended, spin_start);   // readers overlap, their hold time is not counted
+}
+
+void RwSpinLock::unlock_read() {
+    __atomic_fetch_sub(&state, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Take the lock once there are no readers and no writer
+ */
+void RwSpinLock::lock_write() {
+    const u64 spin_start = stats.is_enabled() ? LockStats::get_cycles() : 0;
+
+    bool was_contended = false;
+    s32 expected = 0;
+    while (!__atomic_compare_exchange_n(&state, &expected, WRITER, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        was_contended = true;
+        PerCpu::flush_tlb_if_requested();
+        asm volatile("pause");
+        expected = 0;
+    }
+
+    if (stats.is_enabled()) {
+        stats.on_acquired(was_contended, spin_start);
+        locked_at = LockStats::get_cycles();
+    }
+}
+
+void RwSpinLock::unlock_write() {
+    if (stats.is_enabled())
+        stats.on_released(locked_at);
+
+    __atomic_store_n(&state, 0, __ATOMIC_RELEASE);
+}
+
+ReadLockGuard::ReadLockGuard(RwSpinLock& lock) : lock(lock), rflags(IrqSpinLock::save_and_disable_interrupts()) {
+    lock.lock_read();
+}
+
+ReadLockGuard::~ReadLockGuard() {
+    lock.unlock_read();
+    IrqSpinLock::restore_interrupts(rflags);
+}
+
+WriteLockGuard::WriteLockGuard(RwSpinLock& lock) : lock(lock), rflags(IrqSpinLock::save_and_disable_interrupts()) {
+    lock.lock_write();
+}
+
+WriteLockGuard::~WriteLockGuard() {
+    lock.unlock_write();
+    IrqSpinLock::restore_interrupts(rflags);
+}
+
+} /* namespace multitasking */
@@ -0,0 +1,68 @@
+/**
+ *   @file: RwSpinLock.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_UNDERSTRUCTURE_KSTD_RWSPINLOCK_H_
+#define KERNEL_UNDERSTRUCTURE_KSTD_RWSPINLOCK_H_
+
+#include "LockStats.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class is a reader-writer spin lock: many readers or a single writer at a time.
+ *          Readers go first, so a reader can take the lock again while holding it; a writer waits till there are no readers.
+ *          Use it through ReadLockGuard and WriteLockGuard, that disable interrupts while the lock is held
+ */
+class RwSpinLock {
+public:
+    RwSpinLock(const char* name = nullptr) : stats(name) {}
+    void lock_read();
+    void unlock_read();
+    void lock_write();
+    void unlock_write();
+
+private:
+    static constexpr s32 WRITER {-1};
+
+    volatile s32    state       {0};    // number of readers, or WRITER
+    u64             locked_at   {0};    // cycles the writer took the lock at; only counted for named lock
+    LockStats       stats;
+};
+
+/**
+ * @brief   This class holds RwSpinLock for reading for its lifetime, with interrupts disabled
+ */
+class ReadLockGuard {
+public:
+    ReadLockGuard(RwSpinLock& lock);
+    ~ReadLockGuard();
+    ReadLockGuard(const ReadLockGuard&) = delete;
+    ReadLockGuard& operator=(const ReadLockGuard&) = delete;
+
+private:
+    RwSpinLock& lock;
+    u64         rflags;
+};
+
+/**
+ * @brief   This class holds RwSpinLock for writing for its lifetime, with interrupts disabled
+ */
+class WriteLockGuard {
+public:
+    WriteLockGuard(RwSpinLock& lock);
+    ~WriteLockGuard();
+    WriteLockGuard(const WriteLockGuard&) = delete;
+    WriteLockGuard& operator=(const WriteLockGuard&) = delete;
+
+private:
+    RwSpinLock& lock;
+    u64         rflags;
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_UNDERSTRUCTURE_KSTD_RWSPINLOCK_H_ */
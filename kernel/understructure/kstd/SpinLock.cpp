@@ -0,0 +1,90 @@
+/**
+ *   @file: SpinLock.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "SpinLock.h"
+#include "PerCpu.h"
+
+using namespace hardware;
+
+namespace multitasking {
+
+/**
+ * @brief   Take a ticket and wait for it to be served. While waiting, the TLB shootdowns are served,
+ *          as the cpu that holds the lock may be waiting for them
+ */
+void SpinLock::lock() {
+    const u64 spin_start = stats.is_enabled() ? LockStats::get_cycles() : 0;
+    const u32 ticket = __atomic_fetch_add(&next_ticket, 1, __ATOMIC_RELAXED);
+
+    bool was_contended = false;
+    while (__atomic_load_n(&now_serving, __ATOMIC_ACQUIRE) != ticket) {
+        was_contended = true;
+        PerCpu::flush_tlb_if_requested();
+        asm volatile("pause");
+    }
+
+    if (stats.is_enabled()) {
+        stats.on_acquired(was_contended, spin_start);
+        locked_at = LockStats::get_cycles();
+    }
+}
+
+void SpinLock::unlock() {
+    if (stats.is_enabled())
+        stats.on_released(locked_at);
+
+    __atomic_store_n(&now_serving, now_serving + 1, __ATOMIC_RELEASE);
+}
+
+void IrqSpinLock::lock() {
+    const u64 flags = save_and_disable_interrupts();
+    spin_lock.lock();
+    rflags = flags;
+}
+
+void IrqSpinLock::unlock() {
+    const u64 flags = rflags;
+    spin_lock.unlock();
+    restore_interrupts(flags);
+}
+
+/**
+ * @brief   Disable interrupts on the current cpu and count one more spin lock it holds.
+ *          Page fault handler checks the count: the task that holds a spin lock cant be killed, as the lock would stay taken
+ * @return  RFLAGS from before, for restore_interrupts
+ * @note    Interrupts are only there in the kernel; hosted build (unit tests) runs in user mode, where "cli" is not allowed
+ */
+u64 IrqSpinLock::save_and_disable_interrupts() {
+#if __STDC_HOSTED__
+    return 0;
+#else
+    u64 flags;
+    asm volatile("pushfq; pop %0; cli;" : "=g"(flags) : : "memory");
+    PerCpu::current().spin_locks_held++;
+    return flags;
+#endif
+}
+
+void IrqSpinLock::restore_interrupts(u64 flags) {
+#if !__STDC_HOSTED__
+    PerCpu::current().spin_locks_held--;
+    asm volatile("push %0; popfq;" : : "g"(flags) : "memory", "cc");
+#endif
+}
+
+/**
+ * @brief   Check if the current cpu holds any spin lock
+ */
+bool IrqSpinLock::is_any_held() {
+#if __STDC_HOSTED__
+    return false;
+#else
+    return PerCpu::current().spin_locks_held > 0;
+#endif
+}
+
+} /* namespace multitasking */
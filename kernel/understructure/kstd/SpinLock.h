@@ -0,0 +1,69 @@
+/**
+ *   @file: SpinLock.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef KERNEL_UNDERSTRUCTURE_KSTD_SPINLOCK_H_
+#define KERNEL_UNDERSTRUCTURE_KSTD_SPINLOCK_H_
+
+#include "LockStats.h"
+
+namespace multitasking {
+
+/**
+ * @brief   This class is a ticket spin lock: cpus get the lock in the order they asked for it, so none of them starves.
+ *          Not recursive. Must not be held across a task switch, see IrqSpinLock
+ */
+class SpinLock {
+public:
+    SpinLock(const char* name = nullptr) : stats(name) {}
+    void lock();
+    void unlock();
+
+private:
+    volatile u32    next_ticket     {0};
+    volatile u32    now_serving     {0};
+    u64             locked_at       {0};    // cycles; only counted for named lock
+    LockStats       stats;
+};
+
+/**
+ * @brief   This class is a SpinLock that disables interrupts on the current cpu while held,
+ *          so it can be shared with interrupt handlers and the holder cant get rescheduled.
+ *          Interrupt flag is restored on unlock
+ */
+class IrqSpinLock {
+public:
+    IrqSpinLock(const char* name = nullptr) : spin_lock(name) {}
+    void lock();
+    void unlock();
+
+    static u64 save_and_disable_interrupts();
+    static void restore_interrupts(u64 rflags);
+    static bool is_any_held();
+
+private:
+    SpinLock    spin_lock;
+    u64         rflags      {0};    // of the holder, from before the lock was taken
+};
+
+/**
+ * @brief   This class holds "Lock" for its lifetime
+ */
+template <class Lock>
+class LockGuard {
+public:
+    LockGuard(Lock& lock) : lock(lock) { lock.lock(); }
+    ~LockGuard() { lock.unlock(); }
+    LockGuard(const LockGuard&) = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+
+private:
+    Lock& lock;
+};
+
+} /* namespace multitasking */
+
+#endif /* KERNEL_UNDERSTRUCTURE_KSTD_SPINLOCK_H_ */
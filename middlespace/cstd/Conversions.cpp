@@ -11,72 +11,72 @@ namespace cstd {
 namespace conversions {
 
 /**
- * @brief   Convert integer "num" to string using numeric system "base"
+ * @brief   Reverse "count" chars at "str"
  */
-string int_to_string(s64 num, u8 base) {
-    char str[12];
-
-    u8 i = 0;
-    bool isNegative = false;
-
-    /* Handle 0 explicitely, otherwise empty string is printed for 0 */
-    if (num == 0)
-        return "0";
-
-    // In standard itoa(), negative numbers are handled only with
-    // base 10. Otherwise numbers are considered unsigned.
-    if (num < 0 && base == 10)
-    {
-        isNegative = true;
-        num = -num;
+static void reverse_chars(char* str, size_t count) {
+    for (size_t start = 0, end = count - 1; start < end; start++, end--) {
+        char tmp = str[start];
+        str[start] = str[end];
+        str[end] = tmp;
     }
+}
 
-    // Process individual digits
-    while (num != 0)
-    {
+/**
+ * @brief   Write unsigned integer "num" in numeric system "base" to "str", followed by string terminator
+ * @param   str Room for at least INT_CHARS_MAX chars
+ * @return  Number of chars written, not counting the terminator
+ */
+size_t uint_to_chars(char* str, u64 num, u8 base) {
+    size_t i = 0;
+
+    // Process individual digits; do-while so 0 gives "0" rather than empty string
+    do {
         int rem = num % base;
         str[i++] = (rem > 9)? (rem-10) + 'A' : rem + '0';
         num = num/base;
-    }
-
-    // If number is negative, append '-'
-    if (isNegative)
-        str[i++] = '-';
+    } while (num != 0);
 
     str[i] = '\0'; // Append string terminator
+    reverse_chars(str, i);
+    return i;
+}
 
-    // Reverse the string
-    u8 start = 0;
-    u8 end = i -1;
-    while (start < end) {
-
-        auto tmp = *(str+start);
-        *(str+start) = *(str+end);
-        *(str+end) = tmp;
-        start++;
-        end--;
+/**
+ * @brief   Write integer "num" in numeric system "base" to "str", followed by string terminator
+ * @param   str Room for at least INT_CHARS_MAX chars
+ * @return  Number of chars written, not counting the terminator
+ * @note    As in standard itoa(), negative numbers are handled only with base 10. Otherwise numbers are considered unsigned.
+ */
+size_t int_to_chars(char* str, s64 num, u8 base) {
+    if (num < 0 && base == 10) {
+        str[0] = '-';
+        return 1 + uint_to_chars(str + 1, -(u64)num, base);
     }
 
-    return str;
+    return uint_to_chars(str, num, base);
 }
 
 /**
- * @brief   Convert integer "num" to string using numeric system "base"
+ * @brief   Write double "num" to "str" with "max_frac_digits" fraction digits, followed by string terminator
+ * @param   str Room for at least DOUBLE_CHARS_MAX chars
+ * @return  Number of chars written, not counting the terminator
  * @note    Ugly and fixed-fract digits count implementation
  */
-string double_to_string(double num, u8 max_frac_digits) {
+size_t double_to_chars(char* str, double num, u8 max_frac_digits) {
     const auto FRAC_DIGITS_LIMIT = 10;
-    char str[30];
     const int base = 10;
-    u8 i = 0;
+    size_t i = 0;
     bool isNegative = false;
 
     if (max_frac_digits > FRAC_DIGITS_LIMIT)
         max_frac_digits = FRAC_DIGITS_LIMIT;
 
     /* Handle 0 explicitly, otherwise empty string is printed for 0 */
-    if (num == 0.0)
-        return "0";
+    if (num == 0.0) {
+        str[0] = '0';
+        str[1] = '\0';
+        return 1;
+    }
 
     if (num < 0.0)
     {
@@ -112,19 +112,25 @@ string double_to_string(double num, u8 max_frac_digits) {
         str[i++] = '-';
 
     str[i] = '\0'; // Append string terminator
+    reverse_chars(str, i);
+    return i;
+}
 
-    // Reverse the string
-    u8 start = 0;
-    u8 end = i -1;
-    while (start < end) {
-
-        auto tmp = *(str+start);
-        *(str+start) = *(str+end);
-        *(str+end) = tmp;
-        start++;
-        end--;
-    }
+/**
+ * @brief   Convert integer "num" to string using numeric system "base"
+ */
+string int_to_string(s64 num, u8 base) {
+    char str[INT_CHARS_MAX];
+    int_to_chars(str, num, base);
+    return str;
+}
 
+/**
+ * @brief   Convert double "num" to string with "max_frac_digits" fraction digits
+ */
+string double_to_string(double num, u8 max_frac_digits) {
+    char str[DOUBLE_CHARS_MAX];
+    double_to_chars(str, num, max_frac_digits);
     return str;
 }
 
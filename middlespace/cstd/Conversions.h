@@ -14,6 +14,12 @@
 namespace cstd {
 namespace conversions {
 
+constexpr size_t INT_CHARS_MAX       {66};   // 64 binary digits, sign and string terminator
+constexpr size_t DOUBLE_CHARS_MAX    {32};   // 19 integer digits, point, 10 fraction digits, sign and string terminator
+
+size_t uint_to_chars(char* str, u64 num, u8 base = 10);
+size_t int_to_chars(char* str, s64 num, u8 base = 10);
+size_t double_to_chars(char* str, double num, u8 max_frac_digits = 10);
 string int_to_string(s64 num, u8 base = 10);
 string double_to_string(double num, u8 max_frac_digits = 10);
 s64 string_to_int(const string& str);
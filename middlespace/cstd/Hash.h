@@ -0,0 +1,56 @@
+/**
+ *   @file: Hash.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef MIDDLESPACE_CSTD_HASH_H_
+#define MIDDLESPACE_CSTD_HASH_H_
+
+#include "types.h"
+#include "String.h"
+
+namespace cstd {
+
+/**
+ * @brief   FNV-1a hash of "num_bytes" bytes at "data"
+ * @see     http://www.isthe.com/chongo/tech/comp/fnv/
+ */
+inline size_t hash_bytes(const void* data, size_t num_bytes) {
+    const u8* bytes = (const u8*)data;
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < num_bytes; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief   Hash functor for integral and pointer keys; bits are mixed so the low ones are good for indexing a table
+ * @see     MurmurHash3 fmix64
+ */
+template <class T>
+struct Hash {
+    size_t operator()(const T& key) const {
+        u64 k = (u64)key;
+        k ^= k >> 33;
+        k *= 0xFF51AFD7ED558CCDULL;
+        k ^= k >> 33;
+        k *= 0xC4CEB9FE1A85EC53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+};
+
+template <>
+struct Hash<string> {
+    size_t operator()(const string& key) const {
+        return hash_bytes(key.data(), key.length());
+    }
+};
+
+} /* namespace cstd */
+
+#endif /* MIDDLESPACE_CSTD_HASH_H_ */
@@ -0,0 +1,217 @@
+/**
+ *   @file: HashMap.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef MIDDLESPACE_CSTD_HASHMAP_H_
+#define MIDDLESPACE_CSTD_HASHMAP_H_
+
+#include <utility>
+#include "Hash.h"
+#include "Vector.h"
+
+namespace cstd {
+
+/**
+ * @brief   Open addressing hash map with Robin Hood linear probing; average O(1) access time.
+ *          Key hashes are kept in an array of their own, next to each other, so probing touches few cache lines
+ *          and keys are only compared when their hashes match.
+ *          Robin Hood: on insert, an element that got further from its home slot takes the place of an element
+ *          that is closer to its own; this keeps probe sequences short and lets lookup of a missing key stop early.
+ *          Erase shifts the following elements back instead of leaving tombstones.
+ * @note    Insert and erase invalidate iterators and references. Keys must not be modified through iterators
+ */
+template <class K, class V, class H = Hash<K>>
+class HashMap {
+    using KeyValue = std::pair<K, V>;
+
+    /**
+     * @brief   Iterator over occupied slots, in slot order
+     */
+    template <class MapT, class KeyValueT>
+    class BasicIterator {
+    public:
+        BasicIterator(MapT* map, size_t index) : map(map), index(index) { skip_empty(); }
+        KeyValueT& operator*() const                    { return map->key_values[index]; }
+        KeyValueT* operator->() const                   { return &map->key_values[index]; }
+        BasicIterator& operator++()                     { index++; skip_empty(); return *this; }
+        bool operator==(const BasicIterator& o) const   { return index == o.index; }
+        bool operator!=(const BasicIterator& o) const   { return index != o.index; }
+
+    private:
+        friend class HashMap;
+        void skip_empty() { while (index < map->hashes.size() && map->hashes[index] == EMPTY) index++; }
+        MapT*   map;
+        size_t  index;
+    };
+
+public:
+    using Iterator = BasicIterator<HashMap, KeyValue>;
+    using ConstIterator = BasicIterator<const HashMap, const KeyValue>;
+
+    V& operator[](const K& key) {
+        const u32 hash = hash_key(key);
+        size_t index = find_index(key, hash);
+        if (index == NOT_FOUND)
+            index = insert(KeyValue(key, V{}), hash);
+
+        return key_values[index].second;
+    }
+
+    Iterator find(const K& key) {
+        const size_t index = find_index(key, hash_key(key));
+        return (index == NOT_FOUND) ? end() : Iterator(this, index);
+    }
+
+    ConstIterator find(const K& key) const {
+        const size_t index = find_index(key, hash_key(key));
+        return (index == NOT_FOUND) ? cend() : ConstIterator(this, index);
+    }
+
+    /**
+     * @brief   Find element by value; O(n)
+     */
+    Iterator find_by_val(const V& val) {
+        for (auto it = begin(); it != end(); ++it)
+            if (it->second == val)
+                return it;
+
+        return end();
+    }
+
+    void erase(Iterator it) {
+        erase_at(it.index);
+    }
+
+    bool erase(const K& key) {
+        const size_t index = find_index(key, hash_key(key));
+        if (index == NOT_FOUND)
+            return false;
+
+        erase_at(index);
+        return true;
+    }
+
+    void clear() {
+        hashes.clear();
+        key_values.clear();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, hashes.size()); }
+    ConstIterator cbegin() const { return ConstIterator(this, 0); }
+    ConstIterator cend() const { return ConstIterator(this, hashes.size()); }
+
+private:
+    static constexpr u32    EMPTY           {0};
+    static constexpr u32    OCCUPIED        {0x80000000};   // set in every stored hash, so it never equals EMPTY
+    static constexpr size_t NOT_FOUND       {(size_t)-1};
+    static constexpr size_t MIN_CAPACITY    {16};
+
+    static u32 hash_key(const K& key) {
+        const size_t hash = H()(key);
+        return (u32)(hash ^ (hash >> 32)) | OCCUPIED;
+    }
+
+    size_t get_mask() const {
+        return hashes.size() - 1;   // capacity is a power of 2
+    }
+
+    /**
+     * @brief   How far the element with "hash" stored at "index" is from its home slot
+     */
+    size_t get_distance(size_t index, u32 hash) const {
+        return (index - (hash & get_mask())) & get_mask();
+    }
+
+    size_t find_index(const K& key, u32 hash) const {
+        if (count == 0)
+            return NOT_FOUND;
+
+        for (size_t index = hash & get_mask(), distance = 0; ; index = (index + 1) & get_mask(), distance++) {
+            const u32 slot_hash = hashes[index];
+            if (slot_hash == EMPTY)
+                return NOT_FOUND;
+
+            // the key would have taken this slot on insert if it was in the map
+            if (get_distance(index, slot_hash) < distance)
+                return NOT_FOUND;
+
+            if (slot_hash == hash && key_values[index].first == key)
+                return index;
+        }
+    }
+
+    /**
+     * @brief   Insert "kv" whose key is not in the map yet
+     * @return  Index of the slot that "kv" ended up in
+     */
+    size_t insert(KeyValue&& kv, u32 hash) {
+        // keep load factor below 3/4
+        if ((count + 1) * 4 > hashes.size() * 3)
+            rehash(hashes.size() == 0 ? MIN_CAPACITY : hashes.size() * 2);
+
+        size_t result = NOT_FOUND;
+        for (size_t index = hash & get_mask(), distance = 0; ; index = (index + 1) & get_mask(), distance++) {
+            if (hashes[index] == EMPTY) {
+                hashes[index] = hash;
+                key_values[index] = std::move(kv);
+                count++;
+                return (result == NOT_FOUND) ? index : result;
+            }
+
+            // take the slot from an element closer to its home and carry on inserting that element
+            const size_t slot_distance = get_distance(index, hashes[index]);
+            if (slot_distance < distance) {
+                std::swap(hash, hashes[index]);
+                std::swap(kv, key_values[index]);
+                if (result == NOT_FOUND)
+                    result = index;
+                distance = slot_distance;
+            }
+        }
+    }
+
+    /**
+     * @brief   Remove element at "index" and shift the following elements one slot back, towards their home slots
+     */
+    void erase_at(size_t index) {
+        for (size_t next = (index + 1) & get_mask(); hashes[next] != EMPTY && get_distance(next, hashes[next]) > 0; next = (next + 1) & get_mask()) {
+            hashes[index] = hashes[next];
+            key_values[index] = std::move(key_values[next]);
+            index = next;
+        }
+
+        hashes[index] = EMPTY;
+        key_values[index] = KeyValue();   // release the key and value resources now
+        count--;
+    }
+
+    void rehash(size_t new_capacity) {
+        vector<u32> old_hashes;
+        vector<KeyValue> old_key_values;
+        old_hashes.swap(hashes);
+        old_key_values.swap(key_values);
+        hashes.resize(new_capacity);        // zeroed, so all EMPTY
+        key_values.resize(new_capacity);
+
+        count = 0;
+        for (size_t i = 0; i < old_hashes.size(); i++)
+            if (old_hashes[i] != EMPTY)
+                insert(std::move(old_key_values[i]), old_hashes[i]);
+    }
+
+    vector<u32>         hashes;         // hash of the key in each slot, EMPTY for free slot
+    vector<KeyValue>    key_values;     // key and value in each slot
+    size_t              count       {0};
+};
+
+} /* namespace cstd */
+
+#endif /* MIDDLESPACE_CSTD_HASHMAP_H_ */
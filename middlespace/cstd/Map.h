@@ -14,7 +14,7 @@
 namespace cstd {
 
 /**
- * @brief   Primitive and minimal Map with O(n) access time, to be replaced later
+ * @brief   Primitive and minimal Map with O(n) access time; HashMap is the one to use for lookup tables
  */
 template <class K, class V>
 class Map {
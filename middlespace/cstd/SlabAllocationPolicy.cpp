@@ -0,0 +1,271 @@
+/**
+ *   @file: SlabAllocationPolicy.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "SlabAllocationPolicy.h"
+
+namespace cstd {
+
+/**
+ * @brief   Object sizes served by slabs. Must be multiplies of MIN_ALIGNMENT, ascending, last one == MAX_SLAB_OBJECT
+ */
+static constexpr size_t SIZE_CLASSES[SlabAllocationPolicy::SIZE_CLASSES_COUNT] {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048
+};
+
+/**
+ * @brief   Slab region takes the first quarter of the memory range, aligned to SLAB_SIZE
+ */
+static size_t get_slab_region_start(size_t first_byte) {
+    return (first_byte + SlabAllocationPolicy::SLAB_SIZE - 1) & ~(SlabAllocationPolicy::SLAB_SIZE - 1);
+}
+
+static size_t get_slab_region_end(size_t first_byte, size_t last_byte) {
+    const size_t start = get_slab_region_start(first_byte);
+    const size_t size = ((last_byte - first_byte) / 4) & ~(SlabAllocationPolicy::SLAB_SIZE - 1);
+    return start + size;
+}
+
+/**
+ * Constructor.
+ * @param   first_byte  The first byte of memory available for allocation
+ * @param   last_byte   The last byte of memory available for allocation
+ */
+SlabAllocationPolicy::SlabAllocationPolicy(size_t first_byte, size_t last_byte) :
+        AllocationPolicy(first_byte, last_byte),
+        slab_region_start(get_slab_region_start(first_byte)),
+        slab_region_end(get_slab_region_end(first_byte, last_byte)),
+        slab_region_bump(slab_region_start),
+        large_objects(slab_region_end, last_byte) {
+
+    u32 cache_index = 0;
+    for (u32 i = 0; i < SIZE_CLASSES_COUNT; i++)
+        caches[i].object_size = SIZE_CLASSES[i];
+
+    for (u32 i = 0; i < LOOKUP_SIZE; i++) {
+        while (caches[cache_index].object_size < i * MIN_ALIGNMENT)
+            cache_index++;
+        size_to_cache[i] = cache_index;
+    }
+}
+
+/**
+ * @brief   Extend available memory pool by "num_bytes"; it goes to the large objects
+ */
+void SlabAllocationPolicy::extend_memory_pool(size_t num_bytes) {
+    available_memory_last_byte += num_bytes;
+    large_objects.extend_memory_pool(num_bytes);
+}
+
+/**
+ * @brief   Alloc "size" bytes from size class cache, or from the large objects if too big for a slab
+ */
+void* SlabAllocationPolicy::alloc_bytes(size_t size) {
+    if (size > MAX_SLAB_OBJECT)
+        return alloc_large(size);
+
+    SlabCache& cache = caches[size_to_cache[(size + MIN_ALIGNMENT - 1) / MIN_ALIGNMENT]];
+    if (void* result = alloc_small(cache))
+        return result;
+
+    // slab region exhausted
+    return alloc_large(size);
+}
+
+/**
+ * @brief   Release memory block, either to its slab or to the large objects
+ */
+void SlabAllocationPolicy::free_bytes(void* address) {
+    if (is_in_slab_region(address))
+        free_small((Slab*)((size_t)address & ~(SLAB_SIZE - 1)), address);
+    else
+        free_large(address);
+}
+
+/**
+ * @brief   Memory not handed out to objects, calculated in constant time
+ */
+size_t SlabAllocationPolicy::free_memory_in_bytes() {
+    return total_memory_in_bytes() - bytes_in_use;
+}
+
+/**
+ * @brief   Get total memory available for allocation
+ */
+size_t SlabAllocationPolicy::total_memory_in_bytes() {
+    return available_memory_last_byte - available_memory_first_byte;
+}
+
+/**
+ * @brief   Take an object from the first partial slab of the cache, make new slab if no partial slab
+ * @return  nullptr if no slab available
+ */
+void* SlabAllocationPolicy::alloc_small(SlabCache& cache) {
+    Slab* slab = cache.partial;
+    if (!slab)
+        slab = make_slab(&cache - caches);
+
+    if (!slab)
+        return nullptr;
+
+    void* result;
+    if (slab->free_list) {
+        result = slab->free_list;
+        slab->free_list = *(void**)result;
+        ((size_t*)result)[1] = 0;   // no longer released, see FREED_OBJECT_MAGIC
+    } else {
+        result = (void*)slab->next_unused;
+        slab->next_unused += cache.object_size;
+    }
+
+    slab->used_count++;
+    if (slab->used_count == slab->capacity)
+        unlink_partial(cache, slab);
+
+    cache.objects_in_use++;
+    cache.alloc_count++;
+    bytes_in_use += cache.object_size;
+    return result;
+}
+
+/**
+ * @brief   Put the object back on its slab free list, give the slab away if it becomes empty
+ * @note    Address that is not an object handed out by the slab, and object already released, are ignored
+ */
+void SlabAllocationPolicy::free_small(Slab* slab, void* address) {
+    SlabCache& cache = caches[slab->cache_index];
+
+    const size_t first_object = (size_t)slab + HEADER_SIZE;
+    if ((size_t)address < first_object || (size_t)address >= slab->next_unused || ((size_t)address - first_object) % cache.object_size != 0)
+        return; // not an object of this slab
+
+    if (slab->used_count == 0 || is_released(slab, address))
+        return; // already freed
+
+    *(void**)address = slab->free_list;
+    ((size_t*)address)[1] = FREED_OBJECT_MAGIC;
+    slab->free_list = address;
+
+    if (slab->used_count == slab->capacity)
+        link_partial(cache, slab);  // was full, now has room
+
+    slab->used_count--;
+    cache.objects_in_use--;
+    bytes_in_use -= cache.object_size;
+
+    // keep one empty slab per cache so alloc/free at slab boundary doesnt thrash
+    bool is_only_partial = (cache.partial == slab) && (slab->next == nullptr);
+    if (slab->used_count == 0 && !is_only_partial) {
+        unlink_partial(cache, slab);
+        release_slab(slab);
+    }
+}
+
+/**
+ * @brief   Check if "address" object of "slab" sits on the slab free list.
+ *          The list is only walked for the object marked with FREED_OBJECT_MAGIC, so regular free stays constant time
+ */
+bool SlabAllocationPolicy::is_released(const Slab* slab, void* address) const {
+    if (((size_t*)address)[1] != FREED_OBJECT_MAGIC)
+        return false;
+
+    for (void* object = slab->free_list; object; object = *(void**)object)
+        if (object == address)
+            return true;
+
+    return false;
+}
+
+/**
+ * @brief   Alloc large object with a header that remembers its size
+ */
+void* SlabAllocationPolicy::alloc_large(size_t size) {
+    const size_t total_size = size + sizeof(LargeObjectHeader);
+    LargeObjectHeader* hdr = (LargeObjectHeader*)large_objects.alloc_bytes(total_size);
+    if (!hdr)
+        return nullptr;
+
+    hdr->size = total_size;
+    large_objects_in_use++;
+    bytes_in_use += total_size;
+    return hdr + 1;
+}
+
+/**
+ * @brief   Release large object. Double free is noticed by TLSF free flag, as the released object header
+ *          gets overwritten with TLSF free list links
+ */
+void SlabAllocationPolicy::free_large(void* address) {
+    LargeObjectHeader* hdr = (LargeObjectHeader*)address - 1;
+    if (large_objects.is_released(hdr))
+        return; // already freed
+
+    large_objects_in_use--;
+    bytes_in_use -= hdr->size;
+    large_objects.free_bytes(hdr);
+}
+
+/**
+ * @brief   Get a slab for "cache_index" size class, either a recycled one or a never used one
+ * @return  nullptr if slab region exhausted
+ */
+Slab* SlabAllocationPolicy::make_slab(u32 cache_index) {
+    size_t slab_addr;
+    if (free_slabs) {
+        slab_addr = (size_t)free_slabs;
+        free_slabs = free_slabs->next;
+    } else if (slab_region_bump + SLAB_SIZE <= slab_region_end) {
+        slab_addr = slab_region_bump;
+        slab_region_bump += SLAB_SIZE;
+    } else
+        return nullptr;
+
+    SlabCache& cache = caches[cache_index];
+    Slab* slab = new ((Slab*)slab_addr) Slab;
+    slab->next_unused = slab_addr + HEADER_SIZE;
+    slab->capacity = (SLAB_SIZE - HEADER_SIZE) / cache.object_size;
+    slab->cache_index = cache_index;
+
+    link_partial(cache, slab);
+    cache.slabs_in_use++;
+    return slab;
+}
+
+/**
+ * @brief   Put empty slab on the free slabs list so any size class can reuse it
+ */
+void SlabAllocationPolicy::release_slab(Slab* slab) {
+    caches[slab->cache_index].slabs_in_use--;
+    slab->next = free_slabs;
+    free_slabs = slab;
+}
+
+void SlabAllocationPolicy::link_partial(SlabCache& cache, Slab* slab) {
+    slab->prev = nullptr;
+    slab->next = cache.partial;
+    if (cache.partial)
+        cache.partial->prev = slab;
+    cache.partial = slab;
+}
+
+void SlabAllocationPolicy::unlink_partial(SlabCache& cache, Slab* slab) {
+    if (slab->prev)
+        slab->prev->next = slab->next;
+    else
+        cache.partial = slab->next;
+
+    if (slab->next)
+        slab->next->prev = slab->prev;
+
+    slab->prev = nullptr;
+    slab->next = nullptr;
+}
+
+bool SlabAllocationPolicy::is_in_slab_region(void* address) const {
+    return ((size_t)address >= slab_region_start) && ((size_t)address < slab_region_end);
+}
+
+} /* namespace cstd */
@@ -0,0 +1,113 @@
+/**
+ *   @file: SlabAllocationPolicy.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef MIDDLESPACE_CSTD_SLABALLOCATIONPOLICY_H_
+#define MIDDLESPACE_CSTD_SLABALLOCATIONPOLICY_H_
+
+#include <new>
+#include "AllocationPolicy.h"
+#include "TlsfAllocationPolicy.h"
+
+namespace cstd {
+
+/**
+ * @brief   This class represents a slab; a SLAB_SIZE aligned block of memory cut into equally sized objects.
+ * @note    Slab is organized as this:
+ *          +-------------------------------------------+
+ *          |HDR|OBJ|OBJ|OBJ|...|OBJ|  never used yet   |
+ *          +-------------------------------------------+
+ *                                  ^next_unused
+ *          Released objects form a singly-linked free list, objects past "next_unused" are handed out lazily,
+ *          so creating a slab does not require walking all its objects. Second word of a released object holds
+ *          FREED_OBJECT_MAGIC, so freeing it again is noticed
+ */
+struct Slab {
+    Slab*   prev            = nullptr;  // neighbours on the size class "partial" list
+    Slab*   next            = nullptr;
+    void*   free_list       = nullptr;  // objects released back to this slab
+    size_t  next_unused     = 0;        // first never used object
+    u32     used_count      = 0;        // objects currently handed out
+    u32     capacity        = 0;        // objects that fit in the slab
+    u32     cache_index     = 0;        // size class this slab belongs to
+};
+
+/**
+ * @brief   Size class cache; keeps slabs that have at least one free object, along with live statistics
+ */
+struct SlabCache {
+    size_t  object_size     = 0;
+    Slab*   partial         = nullptr;  // slabs with free objects; full slabs are not tracked until an object is released
+    size_t  objects_in_use  = 0;
+    size_t  slabs_in_use    = 0;
+    size_t  alloc_count     = 0;        // total allocations served, for profiling
+};
+
+/**
+ * @brief   This class is a slab allocation policy. Small allocations are served from per-size-class slab caches
+ *          in constant time, no matter how fragmented the heap is. Size classes are picked to fit the hot kernel objects
+ *          (Task, TaskList nodes, Timer, VfsCachedEntry, cstd::string buffers, std::function storage).
+ *          Allocations bigger than the biggest size class go to the large object path (TlsfAllocationPolicy),
+ *          so both paths run in bounded time and are safe to use from interrupt handlers.
+ * @note    Memory range is split in two: first quarter is the slab region, the rest is for large objects.
+ *          If slab region is exhausted, small allocations fall back to the large object path.
+ */
+class SlabAllocationPolicy: public AllocationPolicy {
+public:
+    static constexpr size_t SLAB_SIZE           {16 * 1024};
+    static constexpr size_t MIN_ALIGNMENT       {16};
+    static constexpr size_t MAX_SLAB_OBJECT     {2048};
+    static constexpr u32    SIZE_CLASSES_COUNT  {14};
+
+    SlabAllocationPolicy(size_t first_byte, size_t last_byte);
+
+    void extend_memory_pool(size_t num_bytes) override;
+    void* alloc_bytes(size_t size) override;
+    void free_bytes(void* address) override;
+    size_t free_memory_in_bytes() override;
+    size_t total_memory_in_bytes() override;
+
+    const SlabCache& get_size_class(u32 index) const    { return caches[index]; }
+    size_t get_large_objects_in_use() const             { return large_objects_in_use; }
+
+private:
+    /**
+     * @brief   Header put in front of large objects so their size is known on free
+     */
+    struct LargeObjectHeader {
+        size_t  size;
+        size_t  padding;    // keep the data MIN_ALIGNMENT aligned
+    };
+
+    void* alloc_small(SlabCache& cache);
+    void free_small(Slab* slab, void* address);
+    bool is_released(const Slab* slab, void* address) const;
+    void* alloc_large(size_t size);
+    void free_large(void* address);
+    Slab* make_slab(u32 cache_index);
+    void release_slab(Slab* slab);
+    void link_partial(SlabCache& cache, Slab* slab);
+    void unlink_partial(SlabCache& cache, Slab* slab);
+    bool is_in_slab_region(void* address) const;
+
+    static constexpr size_t HEADER_SIZE         {(sizeof(Slab) + MIN_ALIGNMENT - 1) & ~(MIN_ALIGNMENT - 1)};
+    static constexpr u32    LOOKUP_SIZE         {MAX_SLAB_OBJECT / MIN_ALIGNMENT + 1};
+    static constexpr size_t FREED_OBJECT_MAGIC  {0xF4EE0B1EC7F4EE0BULL};  // objects are at least MIN_ALIGNMENT bytes, so 2 words fit
+
+    SlabCache               caches[SIZE_CLASSES_COUNT];
+    u8                      size_to_cache[LOOKUP_SIZE]; // (size + MIN_ALIGNMENT-1) / MIN_ALIGNMENT -> size class index
+    size_t                  slab_region_start;
+    size_t                  slab_region_end;
+    size_t                  slab_region_bump;           // slabs never used so far start here
+    Slab*                   free_slabs          {nullptr};  // completely free slabs, to be reused by any size class
+    TlsfAllocationPolicy    large_objects;
+    size_t                  large_objects_in_use {0};
+    size_t                  bytes_in_use        {0};
+};
+
+} /* namespace cstd */
+
+#endif /* MIDDLESPACE_CSTD_SLABALLOCATIONPOLICY_H_ */
@@ -15,119 +15,197 @@
 #include "Conversions.h"
 
 namespace cstd {
-namespace details {
 
+/**
+ * @brief   Formatting target that is a caller supplied, fixed size char buffer. Output that doesnt fit is cut off;
+ *          the buffer always ends up with string terminator
+ */
+class BufferSink {
+public:
+    BufferSink(char* buff, size_t size) : buff(buff), size(size) {}
+
+    void put(char c) {
+        if (length + 1 < size)
+            buff[length++] = c;
+    }
+
+    void put(const char* str, size_t count) {
+        if (length + 1 >= size)
+            return;
+
+        count = (count < size - length - 1) ? count : size - length - 1;
+        __builtin_memcpy(buff + length, str, count);    // builtin, so this header doesnt depend on which memcpy declaration is in scope
+        length += count;
+    }
+
+    size_t finish() {
+        if (size > 0)
+            buff[length] = '\0';
+        return length;
+    }
+
+private:
+    char*   buff;
+    size_t  size;
+    size_t  length  {0};
+};
+
+/**
+ * @brief   Formatting target that is a string
+ */
+class StringSink {
+public:
+    StringSink(string& str) : str(str) {}
+    void put(char c)                            { str += c; }
+    void put(const char* s, size_t count)       { str.append(s, count); }
 
-// format helper - choose proper conversion to string depending on argument type
+private:
+    string& str;
+};
+
+namespace details {
+
+// format helper - choose proper conversion depending on argument type, and write the result straight into the sink
 template <class T>
 struct FormatHelper {
-    static string format(T what) {
-        return {what};
+    template <class Sink>
+    static void write(Sink& sink, const T& what) {
+        const string str {what};
+        sink.put(str.data(), str.length());
     }
 };
 
 template <>
 struct FormatHelper<u8> {
-    static string format(u8 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, u8 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::uint_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<s8> {
-    static string format(s8 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, s8 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::int_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<u16> {
-    static string format(u16 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, u16 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::uint_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<s16> {
-    static string format(s16 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, s16 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::int_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<u32> {
-    static string format(u32 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, u32 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::uint_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<s32> {
-    static string format(s32 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, s32 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::int_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<u64> {
-    static string format(u64 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, u64 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::uint_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<s64> {
-    static string format(s64 what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, s64 what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::int_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<long unsigned int> {
-    static string format(long unsigned int what) {
-        return conversions::int_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, long unsigned int what) {
+        char str[conversions::INT_CHARS_MAX];
+        sink.put(str, conversions::uint_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<bool> {
-    static string format(bool what) {
-        return (what) ? "true" : "false";
+    template <class Sink>
+    static void write(Sink& sink, bool what) {
+        if (what)
+            sink.put("true", 4);
+        else
+            sink.put("false", 5);
     }
 };
 
 template <>
 struct FormatHelper<float> {
-    static string format(float what) {
-        return conversions::double_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, float what) {
+        char str[conversions::DOUBLE_CHARS_MAX];
+        sink.put(str, conversions::double_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<double> {
-    static string format(double what) {
-        return conversions::double_to_string(what);
+    template <class Sink>
+    static void write(Sink& sink, double what) {
+        char str[conversions::DOUBLE_CHARS_MAX];
+        sink.put(str, conversions::double_to_chars(str, what));
     }
 };
 
 template <>
 struct FormatHelper<string> {
-    static string format(const string& what) {
-        return what;
+    template <class Sink>
+    static void write(Sink& sink, const string& what) {
+        sink.put(what.data(), what.length());
     }
 };
 
 template <>
 struct FormatHelper<const char*> {
-    static string format(const char* what) {
-        return {what};
+    template <class Sink>
+    static void write(Sink& sink, const char* what) {
+        sink.put(what, __builtin_strlen(what));
     }
 };
 
 template <>
 struct FormatHelper<char*> {
-    static string format(char* what) {
-        return {what};
+    template <class Sink>
+    static void write(Sink& sink, const char* what) {
+        sink.put(what, __builtin_strlen(what));
     }
 };
 } // namespace details
@@ -163,29 +241,55 @@ public:
 
 
 
-    static string format(char const *fmt) {
-        return {fmt};
+    /**
+     * @brief   Write "fmt" into "sink", with each '%' replaced by the next argument; no memory is allocated on the way.
+     *          The format is walked once: literal text goes to the sink in runs, arguments are converted in place.
+     *          Placeholders with no argument left are written as they are, arguments with no placeholder left are skipped
+     * @param   sink Anything with put(char) and put(const char*, size_t), eg. BufferSink
+     */
+    template <class Sink>
+    static void format_into(Sink& sink, const char* fmt) {
+        sink.put(fmt, __builtin_strlen(fmt));
     }
 
-    template<typename Head, typename ... Tail>
-    static string format(char const *fmt, Head head, Tail ... tail) {
-        using NakedHead = typename std::remove_cv<Head>::type;
+    template <class Sink, typename Head, typename ... Tail>
+    static void format_into(Sink& sink, const char* fmt, const Head& head, const Tail& ... tail) {
+        using NakedHead = typename std::remove_cv<typename std::decay<Head>::type>::type;
 
-        string result;
-        while (*fmt) {
-            if (*fmt == '%') {
-                result += details::FormatHelper<NakedHead>::format(head);
-                result += format(++fmt, tail...);
-                break;
-            } else
-                result += (*fmt++);
-        }
+        const char* placeholder = fmt;
+        while (*placeholder && *placeholder != '%')
+            placeholder++;
+
+        sink.put(fmt, placeholder - fmt);
+        if (*placeholder == '\0')
+            return;
 
+        details::FormatHelper<NakedHead>::write(sink, head);
+        format_into(sink, placeholder + 1, tail...);
+    }
+
+    /**
+     * @brief   Format into caller supplied "buff" of "size" chars; the result is cut off if it doesnt fit
+     * @return  Length of the result, not counting the string terminator
+     * @example char line[64]; format_to(line, sizeof(line), "CPU: %", cpu_vendor_cstr);
+     */
+    template<typename ... Args>
+    static size_t format_to(char* buff, size_t size, const char* fmt, const Args& ... args) {
+        BufferSink sink(buff, size);
+        format_into(sink, fmt, args...);
+        return sink.finish();
+    }
+
+    template<typename ... Args>
+    static string format(const char* fmt, const Args& ... args) {
+        string result;
+        StringSink sink(result);
+        format_into(sink, fmt, args...);
         return result;
     }
 
     template<typename ... Args>
-    static string format(const string& fmt, Args ... args) {
+    static string format(const string& fmt, const Args& ... args) {
         return format(fmt.c_str(), args...);
     }
 
@@ -0,0 +1,281 @@
+/**
+ *   @file: TlsfAllocationPolicy.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "TlsfAllocationPolicy.h"
+
+namespace cstd {
+
+/**
+ * @brief   Index of the most significant bit set; "size" must be non-zero
+ */
+static u32 fls(size_t size) {
+    return 63 - __builtin_clzll(size);
+}
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static size_t align_down(size_t value, size_t alignment) {
+    return value & ~(alignment - 1);
+}
+
+/**
+ * Constructor.
+ * @param   first_byte  The first byte of memory available for allocation
+ * @param   last_byte   The last byte of memory available for allocation
+ */
+TlsfAllocationPolicy::TlsfAllocationPolicy(size_t first_byte, size_t last_byte) :
+        AllocationPolicy(first_byte, last_byte) {
+
+    // make entire available memory a big free block followed by the sentinel
+    const size_t start = align_up(first_byte, ALIGN_SIZE);
+    const size_t end = align_down(last_byte + 1, ALIGN_SIZE);
+    if (end < start + 2 * HEADER_SIZE + MIN_BLOCK_SIZE)
+        return; // too little memory to hold even a single block
+
+    TlsfBlock* block = (TlsfBlock*)start;
+    block->prev_physical = nullptr;
+    block->size_and_flags = (end - start - 2 * HEADER_SIZE) | TlsfBlock::FREE_BIT;
+    make_sentinel(end - HEADER_SIZE, block);
+    insert_free_block(block);
+}
+
+/**
+ * @brief   Extend available memory pool by "num_bytes"; current sentinel becomes header of a new free block
+ * @note    New memory must directly follow the current pool
+ */
+void TlsfAllocationPolicy::extend_memory_pool(size_t num_bytes) {
+    available_memory_last_byte += num_bytes;
+    if (!sentinel)
+        return;
+
+    const size_t end = align_down(available_memory_last_byte + 1, ALIGN_SIZE);
+    const size_t block_start = (size_t)sentinel;
+    if (end < block_start + 2 * HEADER_SIZE + MIN_BLOCK_SIZE)
+        return;
+
+    TlsfBlock* block = sentinel;
+    block->set_size(end - block_start - 2 * HEADER_SIZE);
+    block->set_free(true);
+    make_sentinel(end - HEADER_SIZE, block);
+    insert_free_block(merge_with_neighbours(block));
+}
+
+/**
+ * @brief   Find free block that can accommodate "size" bytes in constant time
+ * @return  nullptr if no suitable block available
+ */
+void* TlsfAllocationPolicy::alloc_bytes(size_t size) {
+    if (size > MAX_BLOCK_SIZE)
+        return nullptr;
+
+    size = align_up(size, ALIGN_SIZE);
+    if (size < MIN_BLOCK_SIZE)
+        size = MIN_BLOCK_SIZE;
+
+    u32 fl, sl;
+    mapping_search(size, fl, sl);
+    TlsfBlock* block = find_suitable_block(fl, sl);
+    if (!block)
+        return nullptr;
+
+    remove_free_block(block);
+    split_if_worthwhile(block, size);
+
+    block->set_free(false);
+    get_next_physical(block)->set_prev_free(false);
+    return to_data(block);
+}
+
+/**
+ * @brief   Release memory block and merge it with free physical neighbours, in constant time
+ */
+void TlsfAllocationPolicy::free_bytes(void* address) {
+    if (!address)
+        return;
+
+    TlsfBlock* block = from_data(address);
+    if (block->is_free() || block == sentinel)
+        return; // already released
+
+    block->set_free(true);
+    get_next_physical(block)->set_prev_free(true);
+    insert_free_block(merge_with_neighbours(block));
+}
+
+/**
+ * @brief   Check if the block that "address" got from alloc_bytes was released since.
+ *          Released block keeps its free flag even once merged into its physical predecessor,
+ *          so the answer holds until the memory is handed out again
+ */
+bool TlsfAllocationPolicy::is_released(void* address) const {
+    return from_data(address)->is_free();
+}
+
+/**
+ * @brief   Memory held by free blocks, calculated in constant time
+ */
+size_t TlsfAllocationPolicy::free_memory_in_bytes() {
+    return free_bytes_count;
+}
+
+/**
+ * @brief   Get total memory available for allocation
+ */
+size_t TlsfAllocationPolicy::total_memory_in_bytes() {
+    return available_memory_last_byte - available_memory_first_byte;
+}
+
+/**
+ * @brief   Find the list that "size" block belongs to
+ */
+void TlsfAllocationPolicy::mapping_insert(size_t size, u32& fl, u32& sl) {
+    if (size < SMALL_BLOCK_SIZE) {
+        fl = 0;
+        sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    } else {
+        const u32 msb = fls(size);
+        sl = (size >> (msb - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        fl = msb - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+/**
+ * @brief   Find the list where every block is big enough for "size"; round "size" up to the next list boundary first
+ */
+void TlsfAllocationPolicy::mapping_search(size_t size, u32& fl, u32& sl) {
+    if (size >= SMALL_BLOCK_SIZE)
+        size += (1ULL << (fls(size) - SL_INDEX_COUNT_LOG2)) - 1;
+
+    mapping_insert(size, fl, sl);
+}
+
+TlsfBlock* TlsfAllocationPolicy::get_next_physical(TlsfBlock* block) {
+    return (TlsfBlock*)((size_t)block + HEADER_SIZE + block->get_size());
+}
+
+TlsfBlock* TlsfAllocationPolicy::from_data(void* address) {
+    return (TlsfBlock*)((size_t)address - HEADER_SIZE);
+}
+
+void* TlsfAllocationPolicy::to_data(TlsfBlock* block) {
+    return (void*)((size_t)block + HEADER_SIZE);
+}
+
+/**
+ * @brief   Get first block from the first non-empty list at "fl","sl" or above
+ * @return  nullptr if no such block; "fl" and "sl" updated to the list the block was found on
+ */
+TlsfBlock* TlsfAllocationPolicy::find_suitable_block(u32& fl, u32& sl) {
+    if (fl >= FL_INDEX_COUNT)
+        return nullptr;
+
+    // first try the lists of same first level
+    u32 sl_map = sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        // then go to bigger first level
+        const u64 fl_map = fl_bitmap & (~0ULL << (fl + 1));
+        if (!fl_map)
+            return nullptr;
+
+        fl = __builtin_ctzll(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+
+    sl = __builtin_ctz(sl_map);
+    return blocks[fl][sl];
+}
+
+void TlsfAllocationPolicy::insert_free_block(TlsfBlock* block) {
+    u32 fl, sl;
+    mapping_insert(block->get_size(), fl, sl);
+
+    block->prev_free = nullptr;
+    block->next_free = blocks[fl][sl];
+    if (block->next_free)
+        block->next_free->prev_free = block;
+    blocks[fl][sl] = block;
+
+    fl_bitmap |= 1ULL << fl;
+    sl_bitmap[fl] |= 1U << sl;
+    free_bytes_count += block->get_size();
+}
+
+void TlsfAllocationPolicy::remove_free_block(TlsfBlock* block) {
+    u32 fl, sl;
+    mapping_insert(block->get_size(), fl, sl);
+
+    if (block->prev_free)
+        block->prev_free->next_free = block->next_free;
+    else
+        blocks[fl][sl] = block->next_free;
+
+    if (block->next_free)
+        block->next_free->prev_free = block->prev_free;
+
+    if (!blocks[fl][sl]) {
+        sl_bitmap[fl] &= ~(1U << sl);
+        if (!sl_bitmap[fl])
+            fl_bitmap &= ~(1ULL << fl);
+    }
+
+    free_bytes_count -= block->get_size();
+}
+
+/**
+ * @brief   Cut the block down to "size" if the remainder can make a block of its own; remainder goes to free lists
+ */
+void TlsfAllocationPolicy::split_if_worthwhile(TlsfBlock* block, size_t size) {
+    const size_t block_size = block->get_size();
+    if (block_size < size + HEADER_SIZE + MIN_BLOCK_SIZE)
+        return;
+
+    block->set_size(size);
+    TlsfBlock* remainder = get_next_physical(block);
+    remainder->prev_physical = block;
+    remainder->size_and_flags = (block_size - size - HEADER_SIZE) | TlsfBlock::FREE_BIT;
+
+    TlsfBlock* next = get_next_physical(remainder);
+    next->prev_physical = remainder;
+    next->set_prev_free(true);
+
+    insert_free_block(remainder);
+}
+
+/**
+ * @brief   Merge free "block" with its free physical neighbours; the neighbours get removed from free lists
+ * @return  The merged block
+ */
+TlsfBlock* TlsfAllocationPolicy::merge_with_neighbours(TlsfBlock* block) {
+    if (block->is_prev_free()) {
+        TlsfBlock* prev = block->prev_physical;
+        remove_free_block(prev);
+        prev->set_size(prev->get_size() + HEADER_SIZE + block->get_size());
+        block = prev;
+    }
+
+    TlsfBlock* next = get_next_physical(block);
+    if (next->is_free()) {
+        remove_free_block(next);
+        block->set_size(block->get_size() + HEADER_SIZE + next->get_size());
+    }
+
+    get_next_physical(block)->prev_physical = block;
+    return block;
+}
+
+/**
+ * @brief   Put zero-size used block at "address"; it ends the memory pool
+ */
+void TlsfAllocationPolicy::make_sentinel(size_t address, TlsfBlock* prev_physical) {
+    sentinel = (TlsfBlock*)address;
+    sentinel->prev_physical = prev_physical;
+    sentinel->size_and_flags = prev_physical->is_free() ? TlsfBlock::PREV_FREE_BIT : 0;
+}
+
+} /* namespace cstd */
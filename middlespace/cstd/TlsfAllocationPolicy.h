@@ -0,0 +1,98 @@
+/**
+ *   @file: TlsfAllocationPolicy.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef MIDDLESPACE_CSTD_TLSFALLOCATIONPOLICY_H_
+#define MIDDLESPACE_CSTD_TLSFALLOCATIONPOLICY_H_
+
+#include "AllocationPolicy.h"
+
+namespace cstd {
+
+/**
+ * @brief   This class represents a memory block managed by TLSF
+ * @note    Memory block is organized as this:
+ *          +-----------------------------------+
+ *          |PREV|SIZE|        DATA             |
+ *          +-----------------------------------+
+ *          "prev_physical" and "size" make the boundary tag; it lets the block find both its physical neighbours in O(1).
+ *          Free blocks keep their free list links in the DATA part, so a used block costs only the 16 bytes header
+ */
+struct TlsfBlock {
+    static constexpr size_t FREE_BIT        = 1;    // this block is free
+    static constexpr size_t PREV_FREE_BIT   = 2;    // physically previous block is free
+    static constexpr size_t FLAGS_MASK      = FREE_BIT | PREV_FREE_BIT;
+
+    TlsfBlock*  prev_physical;  // physically previous block, nullptr for the first one
+    size_t      size_and_flags; // DATA size; always a multiply of 16, so the lower bits hold the flags
+    TlsfBlock*  next_free;      // free blocks only
+    TlsfBlock*  prev_free;      // free blocks only
+
+    size_t get_size() const             { return size_and_flags & ~FLAGS_MASK; }
+    void set_size(size_t size)          { size_and_flags = size | (size_and_flags & FLAGS_MASK); }
+    bool is_free() const                { return size_and_flags & FREE_BIT; }
+    void set_free(bool free)            { size_and_flags = free ? (size_and_flags | FREE_BIT) : (size_and_flags & ~FREE_BIT); }
+    bool is_prev_free() const           { return size_and_flags & PREV_FREE_BIT; }
+    void set_prev_free(bool free)       { size_and_flags = free ? (size_and_flags | PREV_FREE_BIT) : (size_and_flags & ~PREV_FREE_BIT); }
+};
+
+/**
+ * @brief   This class is a Two-Level Segregated Fit allocation policy.
+ *          Free blocks are kept in lists segregated by size: first level splits sizes by powers of two,
+ *          second level splits each power of two range linearly into SL_INDEX_COUNT lists.
+ *          Two levels of bitmaps tell which lists are non-empty, so a suitable free block is found with a couple of
+ *          "find first set bit" instructions; free merges the block with its physical neighbours using boundary tags.
+ *          Both alloc and free run in constant time, no matter how fragmented the memory is,
+ *          which makes the policy fit for allocations done in interrupt context.
+ * @see     http://www.gii.upv.es/tlsf/files/ecrts04_tlsf.pdf
+ */
+class TlsfAllocationPolicy: public AllocationPolicy {
+public:
+    TlsfAllocationPolicy(size_t first_byte, size_t last_byte);
+
+    void extend_memory_pool(size_t num_bytes) override;
+    void* alloc_bytes(size_t size) override;
+    void free_bytes(void* address) override;
+    size_t free_memory_in_bytes() override;
+    size_t total_memory_in_bytes() override;
+    bool is_released(void* address) const;
+
+private:
+    static constexpr size_t ALIGN_SIZE_LOG2     {4};
+    static constexpr size_t ALIGN_SIZE          {1 << ALIGN_SIZE_LOG2};
+    static constexpr u32    SL_INDEX_COUNT_LOG2 {4};
+    static constexpr u32    SL_INDEX_COUNT      {1 << SL_INDEX_COUNT_LOG2};
+    static constexpr u32    FL_INDEX_SHIFT      {SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2};
+    static constexpr size_t SMALL_BLOCK_SIZE    {1 << FL_INDEX_SHIFT};  // below this size, second level only splits linearly
+    static constexpr u32    FL_INDEX_MAX        {40};                   // blocks up to 1TB
+    static constexpr u32    FL_INDEX_COUNT      {FL_INDEX_MAX - FL_INDEX_SHIFT + 1};
+    static constexpr size_t HEADER_SIZE         {2 * sizeof(size_t)};   // "prev_physical" and "size_and_flags"
+    static constexpr size_t MIN_BLOCK_SIZE      {2 * sizeof(size_t)};   // room for the free list links
+    static constexpr size_t MAX_BLOCK_SIZE      {1ULL << FL_INDEX_MAX};
+
+    static void mapping_insert(size_t size, u32& fl, u32& sl);
+    static void mapping_search(size_t size, u32& fl, u32& sl);
+    static TlsfBlock* get_next_physical(TlsfBlock* block);
+    static TlsfBlock* from_data(void* address);
+    static void* to_data(TlsfBlock* block);
+
+    TlsfBlock* find_suitable_block(u32& fl, u32& sl);
+    void insert_free_block(TlsfBlock* block);
+    void remove_free_block(TlsfBlock* block);
+    void split_if_worthwhile(TlsfBlock* block, size_t size);
+    TlsfBlock* merge_with_neighbours(TlsfBlock* block);
+    void make_sentinel(size_t address, TlsfBlock* prev_physical);
+
+    u64         fl_bitmap                   {0};    // bit "fl" set if any of "sl_bitmap[fl]" bits is set
+    u32         sl_bitmap[FL_INDEX_COUNT]   {};     // bit "sl" set if "blocks[fl][sl]" is non-empty
+    TlsfBlock*  blocks[FL_INDEX_COUNT][SL_INDEX_COUNT] {};
+    TlsfBlock*  sentinel                    {nullptr};  // zero-size used block at the end of memory pool; stops merging
+    size_t      free_bytes_count            {0};        // DATA bytes in free blocks
+};
+
+} /* namespace cstd */
+
+#endif /* MIDDLESPACE_CSTD_TLSFALLOCATIONPOLICY_H_ */
@@ -8,36 +8,167 @@
 #include "cstd.h"
 
 /**
- * @brief   Standard memory operations
+ * @brief   Standard memory operations.
+ *          Big blocks go with a single "rep movsb/stosb" when the cpu reports Enhanced REP MOVSB/STOSB (ERMS),
+ *          otherwise 64 bytes at a time with SSE2, then 8 bytes at a time, then the remaining bytes one by one
+ * @note    The loops below must not be turned back into memcpy/memset calls by the compiler, see CMakeLists.txt
  */
+typedef u64 __attribute__((__may_alias__, aligned(1))) unaligned_u64;
+
+static constexpr size_t REP_STRING_MIN_BYTES {512};    // below this, "rep movsb/stosb" startup cost outweighs its speed
+
+/**
+ * @brief   Check cpuid for ERMS. Done here rather than with CpuInfo, as cstd is shared by the kernel and the user space
+ */
+static bool has_enhanced_rep_movsb() {
+    enum ErmsState : u8 { UNKNOWN, PRESENT, ABSENT };
+    static ErmsState erms_state {UNKNOWN};
+
+    if (erms_state == UNKNOWN) {
+        u32 eax = 0, ebx, ecx = 0, edx;
+        asm volatile("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));    // eax = max basic leaf
+        bool erms = false;
+        if (eax >= 7) {
+            eax = 7;
+            ecx = 0;
+            asm volatile("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+            erms = ebx & (1 << 9);
+        }
+        erms_state = erms ? PRESENT : ABSENT;
+    }
+
+    return erms_state == PRESENT;
+}
+
+/**
+ * @brief   Copy from the first byte to the last one; safe when "dst" lies below overlapping "src"
+ */
+static void copy_forward(u8* dst, const u8* src, size_t num) {
+    if (num >= REP_STRING_MIN_BYTES && has_enhanced_rep_movsb()) {
+        asm volatile("rep movsb" : "+D"(dst), "+S"(src), "+c"(num) : : "memory");
+        return;
+    }
+
+    for (; num >= 64; num -= 64, dst += 64, src += 64)
+        asm volatile(
+            "movdqu   (%1), %%xmm0 ;"
+            "movdqu 16(%1), %%xmm1 ;"
+            "movdqu 32(%1), %%xmm2 ;"
+            "movdqu 48(%1), %%xmm3 ;"
+            "movdqu %%xmm0,   (%0) ;"
+            "movdqu %%xmm1, 16(%0) ;"
+            "movdqu %%xmm2, 32(%0) ;"
+            "movdqu %%xmm3, 48(%0) ;"
+            :
+            : "r"(dst), "r"(src)
+            : "xmm0", "xmm1", "xmm2", "xmm3", "memory"
+        );
+
+    for (; num >= 8; num -= 8, dst += 8, src += 8)
+        *(unaligned_u64*)dst = *(const unaligned_u64*)src;
+
+    for (; num > 0; num--)
+        *dst++ = *src++;
+}
+
+/**
+ * @brief   Copy from the last byte to the first one; safe when "dst" lies above overlapping "src"
+ * @note    No "rep movsb" here, as copying backwards with direction flag set is slow on most cpus
+ */
+static void copy_backward(u8* dst, const u8* src, size_t num) {
+    dst += num;
+    src += num;
+
+    for (; num >= 64; num -= 64) {
+        dst -= 64;
+        src -= 64;
+        asm volatile(
+            "movdqu   (%1), %%xmm0 ;"
+            "movdqu 16(%1), %%xmm1 ;"
+            "movdqu 32(%1), %%xmm2 ;"
+            "movdqu 48(%1), %%xmm3 ;"
+            "movdqu %%xmm0,   (%0) ;"
+            "movdqu %%xmm1, 16(%0) ;"
+            "movdqu %%xmm2, 32(%0) ;"
+            "movdqu %%xmm3, 48(%0) ;"
+            :
+            : "r"(dst), "r"(src)
+            : "xmm0", "xmm1", "xmm2", "xmm3", "memory"
+        );
+    }
+
+    for (; num >= 8; num -= 8) {
+        dst -= 8;
+        src -= 8;
+        *(unaligned_u64*)dst = *(const unaligned_u64*)src;
+    }
+
+    for (; num > 0; num--)
+        *--dst = *--src;
+}
+
 extern "C" void * memcpy( void * destination, const void * source, size_t num ) {
-    char *dst = (char*)destination;
-    const char *src = (const char*)source;
-    for (size_t i = 0; i < num; i++)
-        dst[i] = src[i];
-    return dst;
+    copy_forward((u8*)destination, (const u8*)source, num);
+    return destination;
 }
 
 extern "C" void * memmove( void * destination, const void * source, size_t num ) {
-    return memcpy(destination, source, num);
+    const u8* src = (const u8*)source;
+    u8* dst = (u8*)destination;
+
+    // forward copy is fine unless "dst" starts within "src"
+    if (dst <= src || dst >= src + num)
+        copy_forward(dst, src, num);
+    else
+        copy_backward(dst, src, num);
+
+    return destination;
 }
 
 extern "C" int memcmp ( const void * ptr1, const void * ptr2, size_t num ) {
-    const char *p1 = (const char*)ptr1;
-    const char *p2 = (const char*)ptr2;
-    for (size_t i = 0; i < num; i++)
-        if (p1[i] < p2[i])
+    const u8 *p1 = (const u8*)ptr1;
+    const u8 *p2 = (const u8*)ptr2;
+
+    // skip the equal words, then find the differing byte
+    for (; num >= 8; num -= 8, p1 += 8, p2 += 8)
+        if (*(const unaligned_u64*)p1 != *(const unaligned_u64*)p2)
+            break;
+
+    for (; num > 0; num--, p1++, p2++)
+        if (*p1 < *p2)
             return -1;
-        else if (p1[i] > p2[i])
+        else if (*p1 > *p2)
             return 1;
 
     return 0;
 }
 
 extern "C" void* memset( void* dest, int ch, size_t count ) {
-    char* dst = (char*)dest;
-    for (size_t i = 0; i < count; i++)
-        dst[i] = (char)ch;
+    u8* dst = (u8*)dest;
+    if (count >= REP_STRING_MIN_BYTES && has_enhanced_rep_movsb()) {
+        asm volatile("rep stosb" : "+D"(dst), "+c"(count) : "a"(ch) : "memory");
+        return dest;
+    }
+
+    const u64 pattern = 0x0101010101010101ULL * (u8)ch;
+    for (; count >= 64; count -= 64, dst += 64)
+        asm volatile(
+            "movq %1, %%xmm0            ;"
+            "punpcklqdq %%xmm0, %%xmm0  ;"
+            "movdqu %%xmm0,   (%0)      ;"
+            "movdqu %%xmm0, 16(%0)      ;"
+            "movdqu %%xmm0, 32(%0)      ;"
+            "movdqu %%xmm0, 48(%0)      ;"
+            :
+            : "r"(dst), "r"(pattern)
+            : "xmm0", "memory"
+        );
+
+    for (; count >= 8; count -= 8, dst += 8)
+        *(unaligned_u64*)dst = pattern;
+
+    for (; count > 0; count--)
+        *dst++ = (u8)ch;
 
     return dest;
 }
@@ -22,7 +22,10 @@ enum class SysCallNumbers {
     FILE_CLOSE              = 3,
     FILE_STAT               = 4,
     FILE_SEEK               = 8,
+    MMAP                    = 9,
+    MUNMAP                  = 11,
     BRK                     = 12,
+    FORK                    = 57,
 //    NANOSLEEP               = 35, // nanosleeps requires rescheduling capability and is implemented by means of int 80h, see: Int80hDriver
     FILE_TRUNCATE           = 76,
     FILE_RENAME             = 82,
@@ -31,6 +34,7 @@ enum class SysCallNumbers {
     FILE_CREAT              = 85,
     FILE_UNLINK             = 87,
     FILE_MKNOD              = 133,
+    SET_PRIORITY            = 141,
 
 //    FILE_GETDENTS           = 0xdc, //220
     EXIT                    = 60,
@@ -52,11 +56,15 @@ enum class SysCallNumbers {
     VGA_SET_PIXEL_AT        = 507,
     VGA_GET_CHAR_AT         = 508,
     VGA_FLUSH_VIDEO_BUFFER  = 509,
+    VGA_MAP_VIDEO_BUFFER    = 510,
 
     FILE_ENUMERATE          = 600,
     ELF_RUN                 = 700,
     TASK_LIGHTWEIGHT_RUN    = 701,
     TASK_WAIT               = 800,
+
+    SHM_MAP                 = 900,
+    SHM_UNLINK              = 901,
 };
 
 /**
@@ -0,0 +1,150 @@
+/**
+ *   @file: main.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+#include "cstd.h"
+
+/**
+ * @brief   Host side benchmark of cstd memory operations, the same ones that kernel and user space use.
+ *          Every operation is timed against a plain byte loop and its result is checked against that loop.
+ *          Build with -DCMAKE_BUILD_TYPE=RELEASE for meaningful numbers
+ */
+
+constexpr size_t    BUFFER_SIZE     {1024 * 1024 + 64};
+constexpr size_t    BYTES_PER_RUN   {256 * 1024 * 1024};    // so every block size takes similar time
+constexpr size_t    SIZES[]         {16, 64, 256, 1024, 4096, 64 * 1024, 1024 * 1024};
+
+static u8 buffer_a[BUFFER_SIZE];
+static u8 buffer_b[BUFFER_SIZE];
+static u8 buffer_c[BUFFER_SIZE];
+
+/**
+ * @brief   Reference operations; "volatile" keeps the compiler from turning them into memcpy & co.
+ */
+static void byte_copy(void* dst, const void* src, size_t num) {
+    volatile u8* d = (volatile u8*)dst;
+    const u8* s = (const u8*)src;
+    if (d <= s)
+        for (size_t i = 0; i < num; i++)
+            d[i] = s[i];
+    else
+        for (size_t i = num; i > 0; i--)
+            d[i - 1] = s[i - 1];
+}
+
+static void byte_set(void* dst, int ch, size_t num) {
+    volatile u8* d = (volatile u8*)dst;
+    for (size_t i = 0; i < num; i++)
+        d[i] = (u8)ch;
+}
+
+static int byte_compare(const void* ptr1, const void* ptr2, size_t num) {
+    const volatile u8* p1 = (const volatile u8*)ptr1;
+    const volatile u8* p2 = (const volatile u8*)ptr2;
+    for (size_t i = 0; i < num; i++)
+        if (p1[i] != p2[i])
+            return p1[i] < p2[i] ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief   Run "op" on "size" byte blocks until BYTES_PER_RUN bytes are processed
+ * @return  Throughput in MB/s
+ */
+template <class Operation>
+static double measure(size_t size, Operation op) {
+    const size_t runs = BYTES_PER_RUN / size;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < runs; i++) {
+        op(size);
+        asm volatile("" ::: "memory");  // keep the runs from being merged or dropped
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    return (double)runs * size / (1024 * 1024) / seconds.count();
+}
+
+static void fill_pattern(u8* buffer, size_t num, u8 seed) {
+    for (size_t i = 0; i < num; i++)
+        buffer[i] = (u8)(i * 31 + seed);
+}
+
+static bool equal(const u8* p1, const u8* p2, size_t num) {
+    return byte_compare(p1, p2, num) == 0;
+}
+
+/**
+ * @brief   Check cstd results against the reference ones for every size, including unaligned and overlapping blocks
+ */
+static bool check_results() {
+    for (size_t size : SIZES)
+        for (size_t offset : {0, 1, 7}) {
+            // memcpy
+            fill_pattern(buffer_a, size + offset, 1);
+            byte_set(buffer_b, 0, size + offset);
+            memcpy(buffer_b + offset, buffer_a, size);
+            if (!equal(buffer_b + offset, buffer_a, size))
+                return printf("memcpy mismatch; size %zu, offset %zu\n", size, offset), false;
+
+            // memmove, forward and backward overlap
+            for (bool forward : {true, false}) {
+                fill_pattern(buffer_b, size + offset + 1, 2);
+                fill_pattern(buffer_c, size + offset + 1, 2);
+                u8* src = forward ? buffer_b + offset + 1 : buffer_b;
+                u8* dst = forward ? buffer_b : buffer_b + offset + 1;
+                memmove(dst, src, size);
+                byte_copy(forward ? buffer_c : buffer_c + offset + 1, forward ? buffer_c + offset + 1 : buffer_c, size);
+                if (!equal(buffer_b, buffer_c, size + offset + 1))
+                    return printf("memmove mismatch; size %zu, offset %zu, %s\n", size, offset, forward ? "forward" : "backward"), false;
+            }
+
+            // memset
+            fill_pattern(buffer_b, size + offset + 1, 3);
+            fill_pattern(buffer_c, size + offset + 1, 3);
+            memset(buffer_b + offset, 0xA5, size);
+            byte_set(buffer_c + offset, 0xA5, size);
+            if (!equal(buffer_b, buffer_c, size + offset + 1))
+                return printf("memset mismatch; size %zu, offset %zu\n", size, offset), false;
+
+            // memcmp; difference in the last byte, with high bit set so signedness matters
+            fill_pattern(buffer_a, size + offset, 4);
+            byte_copy(buffer_b, buffer_a, size + offset);
+            buffer_b[offset + size - 1] = buffer_a[offset + size - 1] ^ 0x80;
+            if (memcmp(buffer_a + offset, buffer_b + offset, size) != byte_compare(buffer_a + offset, buffer_b + offset, size))
+                return printf("memcmp mismatch; size %zu, offset %zu\n", size, offset), false;
+            if (memcmp(buffer_a + offset, buffer_a + offset, size) != 0)
+                return printf("memcmp mismatch on equal blocks; size %zu, offset %zu\n", size, offset), false;
+        }
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (!check_results())
+        return 1;
+
+    fill_pattern(buffer_a, BUFFER_SIZE, 5);
+    printf("%10s %12s %12s %12s %12s %12s\n", "size", "memcpy", "memmove", "memset", "memcmp", "[MB/s]");
+    for (size_t size : SIZES) {
+        double copy = measure(size, [](size_t n) { memcpy(buffer_c, buffer_a, n); });
+        double move = measure(size, [](size_t n) { memmove(buffer_a + 1, buffer_a, n); });
+        double set = measure(size, [](size_t n) { memset(buffer_c, (int)n, n); });
+        byte_copy(buffer_b, buffer_a, size);    // memcmp goes through the whole blocks
+        double compare = measure(size, [](size_t n) { asm volatile("" :: "r"(memcmp(buffer_a, buffer_b, n))); });
+        printf("%10zu %12.0f %12.0f %12.0f %12.0f\n", size, copy, move, set, compare);
+
+        double byte_copy_mbs = measure(size, [](size_t n) { byte_copy(buffer_c, buffer_a, n); });
+        double byte_move_mbs = measure(size, [](size_t n) { byte_copy(buffer_a + 1, buffer_a, n); });
+        double byte_set_mbs = measure(size, [](size_t n) { byte_set(buffer_c, (int)n, n); });
+        byte_copy(buffer_b, buffer_a, size);
+        double byte_compare_mbs = measure(size, [](size_t n) { asm volatile("" :: "r"(byte_compare(buffer_a, buffer_b, n))); });
+        printf("%10s %12.0f %12.0f %12.0f %12.0f\n", "bytewise", byte_copy_mbs, byte_move_mbs, byte_set_mbs, byte_compare_mbs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ *   @file: HashMap_test.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "HashMap.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+
+/**
+ * @brief   Hash that keeps the key as is, so the test decides which keys share a home slot
+ */
+struct IdentityHash {
+    size_t operator()(u32 key) const { return key; }
+};
+
+TEST(HashMapTest, test_insert_and_find) {
+    HashMap<u32, u32> map;
+    for (u32 i = 0; i < 1000; i++)
+        map[i] = i * 10;
+
+    ASSERT_EQ(1000u, map.size());
+    for (u32 i = 0; i < 1000; i++) {
+        auto it = map.find(i);
+        ASSERT_NE(map.end(), it);
+        ASSERT_EQ(i, it->first);
+        ASSERT_EQ(i * 10, it->second);
+    }
+}
+
+TEST(HashMapTest, test_insert_existing_key_overwrites) {
+    HashMap<string, u32> map;
+    map["/HOME"] = 1;
+    map["/HOME"] = 2;
+
+    ASSERT_EQ(1u, map.size());
+    ASSERT_EQ(2u, map.find("/HOME")->second);
+}
+
+TEST(HashMapTest, test_find_missing_key) {
+    HashMap<string, u32> map;
+    ASSERT_EQ(map.end(), map.find("/HOME"));   // empty map
+
+    map["/HOME"] = 1;
+    map["/HOME/images"] = 2;
+    ASSERT_EQ(map.end(), map.find("/HOME/music"));
+    ASSERT_EQ(map.end(), map.find(""));
+    ASSERT_FALSE(map.erase("/HOME/music"));
+    ASSERT_EQ(2u, map.size());
+}
+
+TEST(HashMapTest, test_erase_shifts_following_elements_back) {
+    HashMap<u32, u32, IdentityHash> map;
+    map[1] = 1;     // home slot 1, stored in slot 1
+    map[17] = 17;   // home slot 1, stored in slot 2
+    map[33] = 33;   // home slot 1, stored in slot 3
+    map[2] = 2;     // home slot 2, stored in slot 4
+
+    ASSERT_TRUE(map.erase(1));
+
+    // 17, 33 and 2 move one slot back, so slots 1..3 are taken and slot 4 is free again
+    std::vector<u32> keys_in_slot_order;
+    for (auto& kv : map)
+        keys_in_slot_order.push_back(kv.first);
+    ASSERT_EQ((std::vector<u32> {17, 33, 2}), keys_in_slot_order);
+
+    // and all of them are still found
+    ASSERT_EQ(3u, map.size());
+    for (u32 key : {17, 33, 2})
+        ASSERT_EQ(key, map.find(key)->second);
+    ASSERT_EQ(map.end(), map.find(1));
+}
+
+TEST(HashMapTest, test_erase_all_then_insert) {
+    HashMap<u32, u32> map;
+    for (u32 i = 0; i < 100; i++)
+        map[i] = i;
+
+    for (u32 i = 0; i < 100; i++)
+        ASSERT_TRUE(map.erase(i));
+
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+    for (u32 i = 0; i < 100; i++)
+        ASSERT_EQ(map.end(), map.find(i));
+
+    map[7] = 70;
+    ASSERT_EQ(1u, map.size());
+    ASSERT_EQ(70u, map.find(7)->second);
+}
+
+TEST(HashMapTest, test_rehash_keeps_elements) {
+    HashMap<string, u32> map;
+    std::vector<string> keys;
+    for (u32 i = 0; i < 500; i++) {
+        keys.push_back(StringUtils::format("/dir_%/file_%", i / 16, i));
+        map[keys.back()] = i;
+
+        // capacity doubles many times on the way; every element inserted so far must survive each rehash
+        for (u32 j = 0; j <= i; j += 37)
+            ASSERT_EQ(j, map.find(keys[j])->second) << "after inserting " << i + 1 << " elements";
+    }
+
+    ASSERT_EQ(500u, map.size());
+    for (u32 i = 0; i < 500; i++)
+        ASSERT_EQ(i, map.find(keys[i])->second);
+}
@@ -0,0 +1,88 @@
+/**
+ *   @file: StringUtils_test.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include <gtest/gtest.h>
+#include "StringUtils.h"
+
+using namespace cstd;
+
+class BufferSinkTest : public ::testing::Test {
+protected:
+    static constexpr char   UNTOUCHED   {'x'};
+    static constexpr size_t MEM_SIZE    {32};
+    char mem[MEM_SIZE];     // formatting gets a prefix of it, the rest tells if anything was written past the given size
+
+    void SetUp() override {
+        for (char& c : mem)
+            c = UNTOUCHED;
+    }
+
+    bool is_untouched_from(size_t index) const {
+        for (size_t i = index; i < MEM_SIZE; i++)
+            if (mem[i] != UNTOUCHED)
+                return false;
+        return true;
+    }
+};
+
+TEST_F(BufferSinkTest, test_format_to_fits) {
+    ASSERT_EQ(11u, StringUtils::format_to(mem, 16, "Heap: % KB", 42));
+    ASSERT_STREQ("Heap: 42 KB", mem);
+    ASSERT_TRUE(is_untouched_from(12));
+}
+
+TEST_F(BufferSinkTest, test_format_to_truncates) {
+    ASSERT_EQ(7u, StringUtils::format_to(mem, 8, "%-%", "abcdef", 12345));
+    ASSERT_STREQ("abcdef-", mem);
+    ASSERT_TRUE(is_untouched_from(8));
+}
+
+TEST_F(BufferSinkTest, test_format_to_truncates_inside_argument) {
+    ASSERT_EQ(9u, StringUtils::format_to(mem, 10, "tid %, prio %", 123, 4));
+    ASSERT_STREQ("tid 123, ", mem);
+    ASSERT_TRUE(is_untouched_from(10));
+}
+
+TEST_F(BufferSinkTest, test_format_to_exact_fit) {
+    ASSERT_EQ(7u, StringUtils::format_to(mem, 8, "1234567"));
+    ASSERT_STREQ("1234567", mem);
+    ASSERT_TRUE(is_untouched_from(8));
+
+    SetUp();
+    ASSERT_EQ(7u, StringUtils::format_to(mem, 8, "12345678"));
+    ASSERT_STREQ("1234567", mem);
+    ASSERT_TRUE(is_untouched_from(8));
+}
+
+TEST_F(BufferSinkTest, test_format_to_size_one_gives_empty_string) {
+    ASSERT_EQ(0u, StringUtils::format_to(mem, 1, "cpu %", 3));
+    ASSERT_EQ('\0', mem[0]);
+    ASSERT_TRUE(is_untouched_from(1));
+}
+
+TEST_F(BufferSinkTest, test_format_to_size_zero_writes_nothing) {
+    ASSERT_EQ(0u, StringUtils::format_to(mem, 0, "cpu %", 3));
+    ASSERT_TRUE(is_untouched_from(0));
+}
+
+TEST_F(BufferSinkTest, test_format_into_appends_and_truncates) {
+    BufferSink sink(mem, 12);
+    StringUtils::format_into(sink, "Resident: % KB\n", 1024);
+    StringUtils::format_into(sink, "Heap: % KB\n", 8);
+    sink.put('!');
+
+    ASSERT_EQ(11u, sink.finish());
+    ASSERT_STREQ("Resident: 1", mem);
+    ASSERT_TRUE(is_untouched_from(12));
+}
+
+TEST_F(BufferSinkTest, test_finish_terminates_empty_result) {
+    BufferSink sink(mem, 4);
+    ASSERT_EQ(0u, sink.finish());
+    ASSERT_EQ('\0', mem[0]);
+    ASSERT_TRUE(is_untouched_from(1));
+}
@@ -0,0 +1,70 @@
+/**
+ *   @file: cstd_test.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "types.h"
+
+// memmove links from cstd rather than the C library, as cstd comes first on the link line; see CMakeLists.txt
+
+class MemmoveTest : public ::testing::Test {
+protected:
+    static constexpr size_t BUFF_SIZE   {2048};
+    const std::vector<size_t> counts    {0, 1, 7, 8, 9, 63, 64, 65, 130, 511, 512, 513, 1000};  // every copy loop and its tail
+    const std::vector<size_t> distances {1, 3, 8, 17, 64, 100};
+
+    std::vector<u8> buff;
+
+    void SetUp() override {
+        buff.resize(BUFF_SIZE);
+        for (size_t i = 0; i < BUFF_SIZE; i++)
+            buff[i] = (u8)(i * 7 + 1);
+    }
+
+    /**
+     * @brief   Move "count" bytes from "src" to "dst" offset in "buff" and check the result against a move done through a copy
+     */
+    void check_move(size_t dst, size_t src, size_t count) {
+        std::vector<u8> expected = buff;
+        const std::vector<u8> source(buff.begin() + src, buff.begin() + src + count);
+        std::copy(source.begin(), source.end(), expected.begin() + dst);
+
+        void* result = memmove(buff.data() + dst, buff.data() + src, count);
+        ASSERT_EQ(buff.data() + dst, result);
+        ASSERT_EQ(expected, buff) << "dst " << dst << ", src " << src << ", count " << count;
+    }
+};
+
+TEST_F(MemmoveTest, test_overlap_dst_above_src) {
+    for (size_t count : counts)
+        for (size_t distance : distances) {
+            SetUp();
+            check_move(10 + distance, 10, count);
+        }
+}
+
+TEST_F(MemmoveTest, test_overlap_dst_below_src) {
+    for (size_t count : counts)
+        for (size_t distance : distances) {
+            SetUp();
+            check_move(10, 10 + distance, count);
+        }
+}
+
+TEST_F(MemmoveTest, test_same_address) {
+    check_move(100, 100, 1000);
+}
+
+TEST_F(MemmoveTest, test_no_overlap) {
+    for (size_t count : counts) {
+        SetUp();
+        check_move(BUFF_SIZE - count, 0, count);
+        SetUp();
+        check_move(0, BUFF_SIZE - count, count);
+    }
+}
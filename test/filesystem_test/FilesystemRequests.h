@@ -2,5 +2,5 @@
 
 class FilesystemRequests : public filesystem::Requests {
 public:
-    void log(const cstd::string& s) override {} // do nothing
+    void log(const char* s) override {} // do nothing
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ *   @file: main.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "Map.h"
+#include "HashMap.h"
+#include "UnixPath.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+using namespace filesystem;
+
+/**
+ * @brief   Host side benchmark of HashMap against the linear Map, keyed with paths like the VFS entry cache is.
+ *          Both maps are checked to give the same answers.
+ *          Build with -DCMAKE_BUILD_TYPE=RELEASE for meaningful numbers
+ */
+
+constexpr size_t    SIZES[]         {8, 64, 512, 4096};
+constexpr size_t    LOOKUPS_PER_RUN {200000};
+
+/**
+ * @brief   Make "count" distinct paths, as found in a filesystem tree
+ */
+static vector<UnixPath> make_paths(size_t count, const char* prefix) {
+    vector<UnixPath> result;
+    for (size_t i = 0; i < count; i++)
+        result.push_back(StringUtils::format("/%/dir_%/file_%.txt", prefix, i / 16, i));
+    return result;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    return seconds.count();
+}
+
+/**
+ * @brief   Fill "map" with "paths", look up present and missing paths, then erase all the paths;
+ *          print the time of each step in ns per operation
+ * @return  Number of paths found, so the maps can be checked against each other
+ */
+template <class MapT>
+static size_t run_benchmark(const char* name, const vector<UnixPath>& paths, const vector<UnixPath>& missing_paths) {
+    MapT map;
+    size_t found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < paths.size(); i++)
+        map[paths[i]] = i;
+    const double insert_ns = seconds_since(start) * 1e9 / paths.size();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUPS_PER_RUN; i++) {
+        const UnixPath& path = paths[i % paths.size()];
+        auto it = map.find(path);
+        if (it != map.end() && it->second == i % paths.size())
+            found++;
+    }
+    const double hit_ns = seconds_since(start) * 1e9 / LOOKUPS_PER_RUN;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUPS_PER_RUN; i++)
+        if (map.find(missing_paths[i % missing_paths.size()]) != map.end())
+            found++;
+    const double miss_ns = seconds_since(start) * 1e9 / LOOKUPS_PER_RUN;
+
+    start = std::chrono::steady_clock::now();
+    for (const UnixPath& path : paths)
+        map.erase(map.find(path));
+    const double erase_ns = seconds_since(start) * 1e9 / paths.size();
+
+    if (map.begin() != map.end())
+        found = 0;  // erase failed
+
+    printf("%10zu %10s %12.1f %12.1f %12.1f %12.1f\n", paths.size(), name, insert_ns, hit_ns, miss_ns, erase_ns);
+    return found;
+}
+
+int main(int argc, char* argv[]) {
+    printf("%10s %10s %12s %12s %12s %12s\n", "entries", "map", "insert", "lookup hit", "lookup miss", "erase [ns]");
+    for (size_t size : SIZES) {
+        const vector<UnixPath> paths = make_paths(size, "home");
+        const vector<UnixPath> missing_paths = make_paths(size, "mnt");
+
+        const size_t map_found = run_benchmark<Map<UnixPath, size_t>>("Map", paths, missing_paths);
+        const size_t hashmap_found = run_benchmark<HashMap<UnixPath, size_t>>("HashMap", paths, missing_paths);
+        if (map_found != LOOKUPS_PER_RUN || hashmap_found != LOOKUPS_PER_RUN) {
+            printf("results mismatch; Map found %zu, HashMap found %zu, expected %zu\n", map_found, hashmap_found, LOOKUPS_PER_RUN);
+            return 1;
+        }
+    }
+
+    return 0;
+}
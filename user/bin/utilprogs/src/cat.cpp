@@ -34,11 +34,25 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // map regular file into memory; its pages get loaded as they are printed
+    struct stat s;
+    void* data = MAP_FAILED;
+    if (syscalls::stat(path, &s) == 0 && s.st_size > 0)
+        data = syscalls::mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, fd);
+
     ssize_t total = 0;
-    ssize_t count;
-    while ((count = syscalls::read(fd, buff, sizeof(buff))) > 0) {
-        cout::print(buff, count);
-        total += count;
+    if (data != MAP_FAILED) {
+        cout::print((const char*)data, s.st_size);
+        syscalls::munmap(data, s.st_size);
+        total = s.st_size;
+    }
+    // entries that report no size (eg. /proc) are read as a stream
+    else {
+        ssize_t count;
+        while ((count = syscalls::read(fd, buff, sizeof(buff))) > 0) {
+            cout::print(buff, count);
+            total += count;
+        }
     }
 
     syscalls::close(fd);
@@ -83,10 +83,21 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // dest created, just copy contents
-    ssize_t count;
-    while ((count = syscalls::read(src_fd, buff, BUFF_SIZE)) > 0) {
-        syscalls::write(dst_fd, buff, count);
+    // dest created, just copy contents; from the mapped source if it can be mapped
+    struct stat s;
+    void* data = MAP_FAILED;
+    if (syscalls::stat(src_path, &s) == 0 && s.st_size > 0)
+        data = syscalls::mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, src_fd);
+
+    if (data != MAP_FAILED) {
+        syscalls::write(dst_fd, data, s.st_size);
+        syscalls::munmap(data, s.st_size);
+    }
+    else {
+        ssize_t count;
+        while ((count = syscalls::read(src_fd, buff, BUFF_SIZE)) > 0) {
+            syscalls::write(dst_fd, buff, count);
+        }
     }
 
     syscalls::close(src_fd);
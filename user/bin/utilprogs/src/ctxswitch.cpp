@@ -0,0 +1,98 @@
+/**
+ *   @file: ctxswitch.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "_start.h"
+#include "syscalls.h"
+#include "Cout.h"
+#include "Timer.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+using namespace cstd::ustd;
+
+constexpr u32 PAGE_SIZE         {4096};
+constexpr u32 MAX_PAGES         {1024};
+
+static u8 working_set[MAX_PAGES * PAGE_SIZE];
+
+/**
+ * @brief   Read one byte of each of the "num_pages" pages then give the cpu away; repeat "num_rounds" times.
+ *          The faster the pages are read after coming back, the more TLB entries survived the task switches
+ */
+u32 touch_and_yield(u32 num_pages, u32 num_rounds) {
+    volatile u32 sum = 0;
+    for (u32 round = 0; round < num_rounds; round++) {
+        for (u32 page = 0; page < num_pages; page++)
+            sum += working_set[page * PAGE_SIZE];
+
+        syscalls::yield();
+    }
+    return sum;
+}
+
+/**
+ * @brief   Run "touch_and_yield" in this process and, if "with_peer", also in a forked process, so every yield
+ *          switches between the two address spaces; print the task switches per second
+ * @return  true on success
+ */
+bool run_benchmark(u32 num_pages, u32 num_rounds, bool with_peer) {
+    s64 pid = 0;
+    if (with_peer) {
+        pid = syscalls::fork();
+        if (pid == 0) {
+            touch_and_yield(num_pages, num_rounds);
+            syscalls::exit_group(0);
+        }
+
+        if (pid < 0) {
+            cout::format("ctxswitch: cant fork: %\n", pid);
+            return false;
+        }
+    }
+
+    Timer timer;
+    touch_and_yield(num_pages, num_rounds);
+    if (with_peer)
+        syscalls::task_wait(pid);
+
+    const double seconds = timer.get_delta_seconds();
+    const double switches = (double)num_rounds * (with_peer ? 2 : 1);
+    cout::format("% process(es), % pages touched per switch: % switches in % s, % switches/s\n",
+                 with_peer ? 2 : 1, num_pages, (u64)switches, seconds, seconds > 0 ? switches / seconds : 0.0);
+
+    return true;
+}
+
+/**
+ * @brief   Entry point
+ * @return  0 on success, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    u32 num_pages = 64;
+    u32 num_rounds = 10000;
+    if (argc >= 2)
+        num_pages = StringUtils::to_int(argv[1]);
+    if (argc >= 3)
+        num_rounds = StringUtils::to_int(argv[2]);
+
+    if (num_pages == 0 || num_pages > MAX_PAGES) {
+        cout::format("ctxswitch: number of pages must be in 1..%\n", MAX_PAGES);
+        return 1;
+    }
+
+    // populate the pages, so the forked process shares them instead of faulting them in
+    for (u32 page = 0; page < num_pages; page++)
+        working_set[page * PAGE_SIZE] = page;
+
+    if (!run_benchmark(num_pages, num_rounds, false))
+        return 1;
+
+    if (!run_benchmark(num_pages, num_rounds, true))
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ *   @file: mallocbench.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "_start.h"
+#include "syscalls.h"
+#include "Cout.h"
+#include "Timer.h"
+#include "Heap.h"
+#include "StringUtils.h"
+
+using namespace cstd;
+using namespace cstd::ustd;
+
+constexpr u32 ROUNDS            {1000};
+constexpr u32 OBJECTS_PER_ROUND {256};
+constexpr u32 MAX_THREADS       {16};
+
+/**
+ * @brief   Alloc a batch of differently sized objects, touch them, then free them all; repeat
+ */
+s64 malloc_free_worker(unsigned seed) {
+    void* objects[OBJECTS_PER_ROUND];
+    u32 rand = seed;
+
+    for (u32 round = 0; round < ROUNDS; round++) {
+        for (u32 i = 0; i < OBJECTS_PER_ROUND; i++) {
+            rand = rand * 1103515245 + 12345;
+            const size_t size = 16 + (rand >> 16) % 512;
+            objects[i] = Heap::alloc(size);
+            if (!objects[i])
+                return 1;
+
+            *(u8*)objects[i] = i;
+        }
+
+        for (u32 i = 0; i < OBJECTS_PER_ROUND; i++)
+            Heap::free(objects[i]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief   Run "num_threads" workers at once and print malloc+free pairs per second
+ * @return  true on success
+ */
+bool run_benchmark(u32 num_threads) {
+    s64 tids[MAX_THREADS];
+    Timer timer;
+
+    for (u32 i = 0; i < num_threads; i++) {
+        tids[i] = syscalls::task_lightweight_run((unsigned long long)malloc_free_worker, i + 1, "mallocbench_worker");
+        if (tids[i] < 0) {
+            cout::format("mallocbench: could not run thread: %\n", tids[i]);
+            num_threads = i;
+            break;
+        }
+    }
+
+    for (u32 i = 0; i < num_threads; i++)
+        syscalls::task_wait(tids[i]);
+
+    const double seconds = timer.get_delta_seconds();
+    const double pairs = (double)ROUNDS * OBJECTS_PER_ROUND * num_threads;
+    cout::format("% thread(s): % malloc/free pairs in % s, % pairs/s, heap size % KB\n",
+                 num_threads, (u64)pairs, seconds, seconds > 0 ? pairs / seconds : 0.0, Heap::get_heap_size_in_bytes() / 1024);
+
+    return num_threads > 0;
+}
+
+/**
+ * @brief   Entry point
+ * @return  0 on success, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    u32 num_threads = 4;
+    if (argc >= 2)
+        num_threads = StringUtils::to_int(argv[1]);
+
+    if (num_threads == 0 || num_threads > MAX_THREADS) {
+        cout::format("mallocbench: number of threads must be in 1..%\n", (u32)MAX_THREADS);
+        return 1;
+    }
+
+    if (!run_benchmark(1))
+        return 1;
+
+    if (num_threads > 1 && !run_benchmark(num_threads))
+        return 1;
+
+    return 0;
+}
@@ -9,7 +9,7 @@
 #include "syscalls.h"
 #include "Cout.h"
 
-char buff[1024];
+char buff[4096];
 const char KERNEL_PROC_FILE[]   = "/proc/psinfo";
 const char ERROR_CANT_OPEN[]    = "ps: cant open /proc/psinfo\n";
 
@@ -0,0 +1,49 @@
+/**
+ *   @file: renice.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "_start.h"
+#include "syscalls.h"
+#include "Cout.h"
+#include "StringUtils.h"
+#include "ErrorCode.h"
+
+using namespace cstd;
+using namespace cstd::ustd;
+using namespace middlespace;
+
+/**
+ * @brief   Entry point
+ * @return  0 on success, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout::print("renice: please specify nice value -20..19 and task id, eg. renice 10 7\n");
+        return 1;
+    }
+
+    auto nice = StringUtils::to_int(argv[1]);
+    auto task_id = StringUtils::to_int(argv[2]);
+    auto renice_result = (ErrorCode)-syscalls::setpriority(task_id, nice);
+
+    switch (renice_result) {
+    case ErrorCode::EC_OK:
+        cout::format("renice: task % nice set to %\n", task_id, nice);
+        return 0;
+
+    case ErrorCode::EC_SRCH:
+        cout::print("renice: no such task\n");
+        return 1;
+
+    case ErrorCode::EC_INVAL:
+        cout::print("renice: nice value must be in -20..19\n");
+        return 1;
+
+    default:
+        cout::format("renice: could not renice task: %; error code: %\n", task_id, (u32)renice_result);
+        return 1;
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ *   @file: shm.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "_start.h"
+#include "syscalls.h"
+#include "Cout.h"
+
+using namespace cstd;
+using namespace cstd::ustd;
+
+const char SEGMENT_NAME[] {"shm_demo"};
+constexpr size_t SEGMENT_SIZE {1024 * 1024};
+
+/**
+ * @brief   Layout of the shared memory segment
+ */
+struct Exchange {
+    volatile u32    ready;      // set by producer when data is in place
+    u32             checksum;
+    u8              data[SEGMENT_SIZE - 2 * sizeof(u32)];
+};
+
+/**
+ * @brief   Producer process; finds the segment by name and fills it in place
+ */
+int produce() {
+    Exchange* exchange = (Exchange*)syscalls::shm_map(SEGMENT_NAME);
+    if (exchange == MAP_FAILED)
+        return 1;
+
+    u32 checksum = 0;
+    for (size_t i = 0; i < sizeof(exchange->data); i++) {
+        exchange->data[i] = i * 7;
+        checksum += exchange->data[i];
+    }
+    exchange->checksum = checksum;
+    exchange->ready = 1;
+
+    syscalls::munmap(exchange, sizeof(Exchange));
+    return 0;
+}
+
+/**
+ * @brief   Entry point; consumer process that verifies the data put in shared memory by the producer process
+ * @return  0 on success, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    Exchange* exchange = (Exchange*)syscalls::shm_map(SEGMENT_NAME, sizeof(Exchange));
+    if (exchange == MAP_FAILED) {
+        cout::print("shm: cant map shared memory segment\n");
+        return 1;
+    }
+
+    s64 pid = syscalls::fork();
+    if (pid == 0)
+        return produce();
+
+    if (pid < 0) {
+        cout::format("shm: cant fork: %\n", pid);
+        return 1;
+    }
+
+    while (!exchange->ready)
+        syscalls::yield();
+
+    u32 checksum = 0;
+    for (size_t i = 0; i < sizeof(exchange->data); i++)
+        checksum += exchange->data[i];
+
+    cout::format("shm: received % KB, checksum %\n", sizeof(exchange->data) / 1024, checksum == exchange->checksum ? "ok" : "mismatch");
+
+    syscalls::task_wait(pid);
+    syscalls::munmap(exchange, sizeof(Exchange));
+    syscalls::shm_unlink(SEGMENT_NAME);
+    return 0;
+}
@@ -0,0 +1,474 @@
+/**
+ *   @file: Heap.cpp
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#include "syscalls.h"
+#include "ScopeGuard.h"
+#include "Heap.h"
+#include "cstd.h"
+
+namespace cstd {
+namespace ustd {
+
+Mutex       Heap::central_mutex;
+ThreadCache Heap::thread_caches[Heap::THREAD_CACHES_COUNT];
+Span*       Heap::partial[Heap::SIZE_CLASSES_COUNT];
+u64         Heap::spans_bitmap[Heap::MAX_SPANS / Heap::BITS_PER_WORD];
+size_t      Heap::heap_start {0};
+size_t      Heap::spans_available {0};
+size_t      Heap::first_free_hint {0};
+size_t      Heap::released_spans {0};
+
+static_assert(sizeof(Span) <= 64, "Span header must fit in HEADER_SIZE");
+
+/**
+ * @brief   Alloc "size" bytes; small objects come from the thread cache, large objects straight from the spans
+ * @return  nullptr if the kernel refused to give more heap memory
+ */
+void* Heap::alloc(size_t size) {
+    if (size > MAX_SMALL_OBJECT) {
+        ScopeGuard one_thread_at_a_time_here(central_mutex);
+        return alloc_large(size);
+    }
+
+    const u32 class_index = size_to_class(size);
+    ThreadCache* cache = take_thread_cache();
+    if (!cache) {
+        ScopeGuard one_thread_at_a_time_here(central_mutex);
+        return alloc_small(class_index);
+    }
+
+    if (!cache->lists[class_index])
+        refill(*cache, class_index);
+
+    FreeObject* result = cache->lists[class_index];
+    if (result) {
+        cache->lists[class_index] = result->next;
+        cache->counts[class_index]--;
+    }
+
+    cache->is_taken.store(false, std::memory_order_release);
+    return result;
+}
+
+/**
+ * @brief   Release memory block; small objects go to the thread cache, large objects straight back to the spans
+ */
+void Heap::free(void* address) {
+    if (!address)
+        return;
+
+    Span* span = (Span*)((size_t)address & ~(SPAN_SIZE - 1));
+    if (span->magic != SPAN_MAGIC)
+        return; // not allocated by this heap or already released
+
+    if (span->class_index == LARGE_SPAN) {
+        ScopeGuard one_thread_at_a_time_here(central_mutex);
+        free_span(span);
+        trim();
+        return;
+    }
+
+    ThreadCache* cache = take_thread_cache();
+    if (!cache) {
+        ScopeGuard one_thread_at_a_time_here(central_mutex);
+        release_object((FreeObject*)address);
+        trim();
+        return;
+    }
+
+    const u32 class_index = span->class_index;
+    FreeObject* object = (FreeObject*)address;
+    object->next = cache->lists[class_index];
+    cache->lists[class_index] = object;
+    cache->counts[class_index]++;
+
+    // dont let a single thread hoard released objects
+    const u32 batch_size = get_batch_size(class_index);
+    if (cache->counts[class_index] > 2 * batch_size)
+        flush(*cache, class_index, batch_size);
+
+    cache->is_taken.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief   How much memory is currently obtained from the kernel
+ */
+size_t Heap::get_heap_size_in_bytes() {
+    return spans_available * SPAN_SIZE;
+}
+
+/**
+ * @brief   Object size of given size class. Classes are 16 bytes apart up to 128 bytes, then 4 classes per power of two
+ */
+size_t Heap::get_size_class_object_size(u32 class_index) {
+    if (class_index < 8)
+        return (class_index + 1) * 16;
+
+    const u32 power = 7 + (class_index - 8) / 4;
+    const u32 step = (class_index - 8) % 4 + 1;
+    return (1ULL << power) + step * (1ULL << (power - 2));
+}
+
+/**
+ * @brief   Smallest size class that can hold "size" bytes; inverse of get_size_class_object_size
+ */
+u32 Heap::size_to_class(size_t size) {
+    if (size <= 128)
+        return size == 0 ? 0 : (size + 15) / 16 - 1;
+
+    const u32 power = 63 - __builtin_clzll(size - 1);   // 2^power < size <= 2^(power+1)
+    const size_t step = 1ULL << (power - 2);
+    return 8 + (power - 7) * 4 + (size - (1ULL << power) + step - 1) / step - 1;
+}
+
+/**
+ * @brief   Number of objects moved at once between a thread cache and the central heap
+ */
+u32 Heap::get_batch_size(u32 class_index) {
+    const size_t count = 32 * 1024 / get_size_class_object_size(class_index);
+    return count < 2 ? 2 : (count > 32 ? 32 : count);
+}
+
+/**
+ * @brief   Try take the cache of current thread. The cache is picked by hashing the stack address
+ * @return  nullptr if the cache is being used by another thread at the moment
+ */
+ThreadCache* Heap::take_thread_cache() {
+    const size_t stack_region = (size_t)__builtin_frame_address(0) >> 17;  // user stack is 128KB
+    const u32 index = (stack_region * 0x9E3779B97F4A7C15ULL) >> 60;        // golden ratio hashing into 16 caches
+    static_assert(THREAD_CACHES_COUNT == 16, "Hash above yields 4 bits");
+
+    ThreadCache& cache = thread_caches[index];
+    if (cache.is_taken.exchange(true, std::memory_order_acquire))
+        return nullptr;
+
+    return &cache;
+}
+
+/**
+ * @brief   Move a batch of objects of "class_index" from the central heap to the thread cache
+ */
+void Heap::refill(ThreadCache& cache, u32 class_index) {
+    ScopeGuard one_thread_at_a_time_here(central_mutex);
+    cache.counts[class_index] += take_objects(class_index, cache.lists[class_index], get_batch_size(class_index));
+}
+
+/**
+ * @brief   Move "count" objects of "class_index" from the thread cache back to their spans
+ */
+void Heap::flush(ThreadCache& cache, u32 class_index, u32 count) {
+    ScopeGuard one_thread_at_a_time_here(central_mutex);
+    while (count-- > 0 && cache.lists[class_index]) {
+        FreeObject* object = cache.lists[class_index];
+        cache.lists[class_index] = object->next;
+        cache.counts[class_index]--;
+        release_object(object);
+    }
+    trim(&cache);
+}
+
+/**
+ * @brief   Move all the objects from the thread caches back to their spans; skip the caches in use by other threads
+ * @param   own_cache Cache already taken by current thread, or nullptr
+ */
+void Heap::drain_thread_caches(ThreadCache* own_cache) {
+    for (ThreadCache& cache : thread_caches) {
+        if (&cache != own_cache && cache.is_taken.exchange(true, std::memory_order_acquire))
+            continue;
+
+        for (u32 class_index = 0; class_index < SIZE_CLASSES_COUNT; class_index++)
+            while (FreeObject* object = cache.lists[class_index]) {
+                cache.lists[class_index] = object->next;
+                release_object(object);
+            }
+
+        memset(cache.counts, 0, sizeof(cache.counts));
+        if (&cache != own_cache)
+            cache.is_taken.store(false, std::memory_order_release);
+    }
+}
+
+/**
+ * @note    Central heap; all the functions below must be called with "central_mutex" held
+ */
+void* Heap::alloc_small(u32 class_index) {
+    FreeObject* result = nullptr;
+    take_objects(class_index, result, 1);
+    return result;
+}
+
+/**
+ * @brief   Take up to "count" objects of "class_index" from partial spans, make new spans as needed
+ * @return  Number of objects put on the "list"
+ */
+u32 Heap::take_objects(u32 class_index, FreeObject*& list, u32 count) {
+    u32 taken = 0;
+    while (taken < count) {
+        Span* span = partial[class_index];
+        if (!span)
+            span = make_span(class_index, 1);
+
+        if (!span)
+            break; // out of memory
+
+        while (taken < count && span->used_count < span->capacity) {
+            FreeObject* object;
+            if (span->free_list) {
+                object = span->free_list;
+                span->free_list = object->next;
+            } else {
+                object = (FreeObject*)span->next_unused;
+                span->next_unused += get_size_class_object_size(class_index);
+            }
+
+            object->next = list;
+            list = object;
+            span->used_count++;
+            taken++;
+        }
+
+        if (span->used_count == span->capacity)
+            unlink_partial(span);
+    }
+
+    return taken;
+}
+
+/**
+ * @brief   Put the object back on its span free list, give the span away if it becomes empty
+ */
+void Heap::release_object(FreeObject* object) {
+    Span* span = (Span*)((size_t)object & ~(SPAN_SIZE - 1));
+    if (span->used_count == 0)
+        return; // already released
+
+    object->next = span->free_list;
+    span->free_list = object;
+
+    if (span->used_count == span->capacity)
+        link_partial(span);  // was full, now has room
+
+    span->used_count--;
+    if (span->used_count == 0) {
+        unlink_partial(span);
+        free_span(span);
+    }
+}
+
+/**
+ * @brief   Alloc a run of spans big enough for "size" bytes and the span header
+ */
+void* Heap::alloc_large(size_t size) {
+    const size_t spans_count = (size + HEADER_SIZE + SPAN_SIZE - 1) / SPAN_SIZE;
+    Span* span = make_span(LARGE_SPAN, spans_count);
+    if (!span)
+        return nullptr;
+
+    return (u8*)span + HEADER_SIZE;
+}
+
+/**
+ * @brief   Give the span run back to the heap
+ */
+void Heap::free_span(Span* span) {
+    span->magic = 0;
+    release_spans(((size_t)span - heap_start) / SPAN_SIZE, span->spans_count);
+}
+
+/**
+ * @brief   Take "spans_count" spans and setup the header; small object spans go on their size class "partial" list
+ * @return  nullptr if out of memory
+ */
+Span* Heap::make_span(u32 class_index, u32 spans_count) {
+    const ssize_t index = alloc_spans(spans_count);
+    if (index == -1)
+        return nullptr;
+
+    Span* span = (Span*)(heap_start + index * SPAN_SIZE);
+    span->magic = SPAN_MAGIC;
+    span->class_index = class_index;
+    span->spans_count = spans_count;
+    span->used_count = 0;
+    span->capacity = 0;
+    span->prev = nullptr;
+    span->next = nullptr;
+    span->free_list = nullptr;
+    span->next_unused = (size_t)span + HEADER_SIZE;
+
+    if (class_index != LARGE_SPAN) {
+        span->capacity = (SPAN_SIZE - HEADER_SIZE) / get_size_class_object_size(class_index);
+        link_partial(span);
+    }
+
+    return span;
+}
+
+void Heap::link_partial(Span* span) {
+    Span* prev = nullptr;
+    Span* next = partial[span->class_index];
+    while (next && next < span) {
+        prev = next;
+        next = next->next;
+    }
+
+    span->prev = prev;
+    span->next = next;
+    if (prev)
+        prev->next = span;
+    else
+        partial[span->class_index] = span;
+    if (next)
+        next->prev = span;
+}
+
+void Heap::unlink_partial(Span* span) {
+    if (span->prev)
+        span->prev->next = span->next;
+    else if (partial[span->class_index] == span)
+        partial[span->class_index] = span->next;
+
+    if (span->next)
+        span->next->prev = span->prev;
+
+    span->prev = nullptr;
+    span->next = nullptr;
+}
+
+/**
+ * @brief   Find where the heap starts; brk(0) says where the current program break is
+ */
+void Heap::init() {
+    const size_t program_break = syscalls::brk(0);
+    heap_start = (program_break + SPAN_SIZE - 1) & ~(SPAN_SIZE - 1);
+}
+
+/**
+ * @brief   Take "count" consecutive spans, growing the heap if no such run is free
+ * @return  -1 on failure, index of the first span on success
+ */
+ssize_t Heap::alloc_spans(size_t count) {
+    if (heap_start == 0)
+        init();
+
+    ssize_t index = find_free_spans(count);
+    if (index == -1 && grow(count))
+        index = find_free_spans(count);
+
+    if (index == -1)
+        return -1;
+
+    mark_spans(index, count, true);
+    if (count == 1 && (size_t)index == first_free_hint)
+        first_free_hint = index + 1;
+
+    return index;
+}
+
+/**
+ * @brief   Release "count" spans starting at "first_index", trim the heap if its top got free
+ */
+void Heap::release_spans(size_t first_index, size_t count) {
+    mark_spans(first_index, count, false);
+    if (first_index < first_free_hint)
+        first_free_hint = first_index;
+
+    released_spans += count;
+}
+
+/**
+ * @brief   First fit search for "count" consecutive free spans, skipping fully used bitmap words at once
+ * @return  -1 if not found, index of the first span on success
+ */
+ssize_t Heap::find_free_spans(size_t count) {
+    size_t run_start = 0;
+    size_t run_length = 0;
+    size_t i = first_free_hint;
+
+    while (i < spans_available) {
+        if (i % BITS_PER_WORD == 0 && spans_bitmap[i / BITS_PER_WORD] == ~0ULL) {
+            run_length = 0;
+            i += BITS_PER_WORD;
+            continue;
+        }
+
+        if (is_span_used(i)) {
+            run_length = 0;
+        } else {
+            if (run_length == 0)
+                run_start = i;
+
+            if (++run_length == count)
+                return run_start;
+        }
+        i++;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief   Request enough heap memory from the kernel for "count" spans to be free at the top of the heap
+ */
+bool Heap::grow(size_t count) {
+    size_t free_on_top = 0;
+    while (free_on_top < spans_available && !is_span_used(spans_available - free_on_top - 1))
+        free_on_top++;
+
+    const size_t needed = count > free_on_top ? count - free_on_top : 0;
+    const size_t increase = needed > GROW_SPANS ? needed : GROW_SPANS;
+    const size_t new_spans_available = spans_available + increase;
+    if (new_spans_available > MAX_SPANS)
+        return false;
+
+    const size_t new_heap_end = heap_start + new_spans_available * SPAN_SIZE;
+    if (syscalls::brk(new_heap_end) != new_heap_end)
+        return false; // kernel refused to give more memory
+
+    spans_available = new_spans_available;
+    return true;
+}
+
+/**
+ * @brief   Give the free spans at the top of the heap back to the kernel, leaving KEEP_SPANS for upcoming allocations
+ * @note    Runs once TRIM_SPANS got released since last time. Objects kept in thread caches would pin their spans,
+ *          so the caches are drained first
+ * @param   own_cache Cache already taken by current thread, or nullptr
+ */
+void Heap::trim(ThreadCache* own_cache) {
+    if (released_spans < TRIM_SPANS)
+        return;
+
+    drain_thread_caches(own_cache);
+    released_spans = 0;
+
+    size_t top = spans_available;
+    while (top > 0 && !is_span_used(top - 1))
+        top--;
+
+    const size_t new_spans_available = top + KEEP_SPANS;
+    if (new_spans_available + TRIM_SPANS > spans_available)
+        return;
+
+    const size_t new_heap_end = heap_start + new_spans_available * SPAN_SIZE;
+    if (syscalls::brk(new_heap_end) == new_heap_end)
+        spans_available = new_spans_available;
+}
+
+bool Heap::is_span_used(size_t index) {
+    return spans_bitmap[index / BITS_PER_WORD] & (1ULL << (index % BITS_PER_WORD));
+}
+
+void Heap::mark_spans(size_t first_index, size_t count, bool used) {
+    for (size_t i = first_index; i < first_index + count; i++)
+        if (used)
+            spans_bitmap[i / BITS_PER_WORD] |= (1ULL << (i % BITS_PER_WORD));
+        else
+            spans_bitmap[i / BITS_PER_WORD] &= ~(1ULL << (i % BITS_PER_WORD));
+}
+
+} /* namespace ustd */
+} /* namespace cstd */
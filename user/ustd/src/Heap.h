@@ -0,0 +1,122 @@
+/**
+ *   @file: Heap.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef USER_USTD_SRC_HEAP_H_
+#define USER_USTD_SRC_HEAP_H_
+
+#include <atomic>
+#include "types.h"
+#include "Mutex.h"
+
+namespace cstd {
+namespace ustd {
+
+/**
+ * @brief   Released object; its first bytes link it with the next released object of the same size class
+ */
+struct FreeObject {
+    FreeObject* next;
+};
+
+/**
+ * @brief   Span is a SPAN_SIZE aligned run of heap memory. It either holds equally sized small objects,
+ *          or a single large object that spans "spans_count" consecutive spans.
+ * @note    Span header sits at the very beginning of the span, so the span of any object is found by address alignment
+ */
+struct Span {
+    u32         magic;
+    u32         class_index;    // size class of the objects, or LARGE_SPAN
+    u32         spans_count;    // number of consecutive spans taken
+    u32         used_count;     // objects handed out, also those sitting in thread caches
+    u32         capacity;       // objects that fit in the span
+    Span*       prev;           // neighbours on the size class "partial" list
+    Span*       next;
+    FreeObject* free_list;      // objects released back to this span
+    size_t      next_unused;    // first never used object
+};
+
+/**
+ * @brief   Per-thread cache of released objects, so most malloc/free calls dont touch the central heap lock
+ * @note    There is no thread local storage, so a thread picks its cache by its stack address.
+ *          Cache is taken with a try-lock; a thread that finds its cache busy goes straight to the central heap
+ */
+struct ThreadCache {
+    static constexpr u32 SIZE_CLASSES_COUNT {36};
+
+    std::atomic<bool>   is_taken;
+    FreeObject*         lists[SIZE_CLASSES_COUNT];
+    u32                 counts[SIZE_CLASSES_COUNT];
+};
+
+/**
+ * @brief   This class is the user space heap built on top of the memory obtained with "brk" syscall.
+ *          Small objects are served from size class spans through per-thread caches,
+ *          large objects take whole runs of spans. Spans are tracked with a bitmap;
+ *          when enough spans at the top of the heap become free, the heap is trimmed and the memory goes back to the kernel.
+ * @note    All the state is static and zero-initialized, so the heap can be used before/while global constructors run
+ */
+class Heap {
+public:
+    static constexpr size_t SPAN_SIZE           {64 * 1024};
+    static constexpr size_t MAX_SMALL_OBJECT    {16 * 1024};
+    static constexpr u32    SIZE_CLASSES_COUNT  {ThreadCache::SIZE_CLASSES_COUNT};
+    static constexpr u32    THREAD_CACHES_COUNT {16};
+
+    static void* alloc(size_t size);
+    static void free(void* address);
+    static size_t get_heap_size_in_bytes();
+    static size_t get_size_class_object_size(u32 class_index);
+
+private:
+    static constexpr u32    SPAN_MAGIC          {0x5BA45BA4};
+    static constexpr u32    LARGE_SPAN          {0xFFFFFFFF};
+    static constexpr size_t HEADER_SIZE         {64};
+    static constexpr size_t MAX_SPANS           {1024 * 1024 * 1024 / SPAN_SIZE};  // user address space is 1GB
+    static constexpr size_t BITS_PER_WORD       {64};
+    static constexpr size_t GROW_SPANS          {16};   // ask the kernel for at least 1MB at a time
+    static constexpr size_t KEEP_SPANS          {16};   // leave 1MB of free spans on top when trimming...
+    static constexpr size_t TRIM_SPANS          {32};   // ...and trim no less than 2MB, so the kernel can release huge heap pages too
+
+    static u32 size_to_class(size_t size);
+    static u32 get_batch_size(u32 class_index);
+    static ThreadCache* take_thread_cache();
+    static void refill(ThreadCache& cache, u32 class_index);
+    static void flush(ThreadCache& cache, u32 class_index, u32 count);
+    static void drain_thread_caches(ThreadCache* own_cache);
+
+    static void* alloc_small(u32 class_index);
+    static u32 take_objects(u32 class_index, FreeObject*& list, u32 count);
+    static void release_object(FreeObject* object);
+    static void* alloc_large(size_t size);
+    static void free_span(Span* span);
+    static Span* make_span(u32 class_index, u32 spans_count);
+    static void link_partial(Span* span);
+    static void unlink_partial(Span* span);
+
+    static void init();
+    static ssize_t alloc_spans(size_t count);
+    static void release_spans(size_t first_index, size_t count);
+    static ssize_t find_free_spans(size_t count);
+    static bool grow(size_t count);
+    static void trim(ThreadCache* own_cache = nullptr);
+    static bool is_span_used(size_t index);
+    static void mark_spans(size_t first_index, size_t count, bool used);
+
+    static Mutex        central_mutex;
+    static ThreadCache  thread_caches[THREAD_CACHES_COUNT];
+    static Span*        partial[SIZE_CLASSES_COUNT];    // spans with free objects, per size class
+    static u64          spans_bitmap[MAX_SPANS / BITS_PER_WORD];   // 1 = span in use
+    static size_t       heap_start;                     // SPAN_SIZE aligned
+    static size_t       spans_available;                // spans obtained from the kernel
+    static size_t       first_free_hint;                // all spans below are in use
+    static size_t       released_spans;                 // since last trim
+};
+
+} /* namespace ustd */
+} /* namespace cstd */
+
+#endif /* USER_USTD_SRC_HEAP_H_ */
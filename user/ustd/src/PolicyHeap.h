@@ -0,0 +1,123 @@
+/**
+ *   @file: PolicyHeap.h
+ *
+ *   @date: Oct 17, 2026
+ * @author: Mateusz Midor
+ */
+
+#ifndef USER_USTD_SRC_POLICYHEAP_H_
+#define USER_USTD_SRC_POLICYHEAP_H_
+
+#include <new>
+#include "types.h"
+#include "syscalls.h"
+#include "Mutex.h"
+#include "ScopeGuard.h"
+
+namespace cstd {
+namespace ustd {
+
+/**
+ * @brief   This class is the user space heap that runs an AllocationPolicy, eg. TlsfAllocationPolicy,
+ *          on the memory obtained with "brk" syscall. It is the alternative to Heap, see memory.cpp
+ * @note    All the state is static and zero-initialized and the policy is constructed on first allocation,
+ *          so the heap can be used before/while global constructors run
+ */
+template <class Policy>
+class PolicyHeap {
+public:
+    static void* alloc(size_t size);
+    static void free(void* address);
+    static size_t get_heap_size_in_bytes();
+
+private:
+    static constexpr size_t GROW_SIZE {1024 * 1024};    // ask the kernel for at least 1MB at a time
+
+    static bool init();
+    static bool grow(size_t size);
+
+    static Mutex    mutex;
+    static Policy*  policy;
+    static size_t   heap_start;
+    static size_t   heap_end;
+    alignas(Policy) static u8 policy_storage[sizeof(Policy)];
+};
+
+template <class Policy> Mutex   PolicyHeap<Policy>::mutex;
+template <class Policy> Policy* PolicyHeap<Policy>::policy {nullptr};
+template <class Policy> size_t  PolicyHeap<Policy>::heap_start {0};
+template <class Policy> size_t  PolicyHeap<Policy>::heap_end {0};
+template <class Policy> alignas(Policy) u8 PolicyHeap<Policy>::policy_storage[sizeof(Policy)];
+
+/**
+ * @brief   Alloc "size" bytes, growing the heap if the policy has no block big enough
+ * @return  nullptr if the kernel refused to give more heap memory
+ */
+template <class Policy>
+void* PolicyHeap<Policy>::alloc(size_t size) {
+    ScopeGuard one_thread_at_a_time_here(mutex);
+    if (!policy && !init())
+        return nullptr;
+
+    void* result = policy->alloc_bytes(size);
+    if (!result && grow(size))
+        result = policy->alloc_bytes(size);
+
+    return result;
+}
+
+/**
+ * @brief   Release memory block
+ */
+template <class Policy>
+void PolicyHeap<Policy>::free(void* address) {
+    if (!address)
+        return;
+
+    ScopeGuard one_thread_at_a_time_here(mutex);
+    if (policy)
+        policy->free_bytes(address);
+}
+
+/**
+ * @brief   How much memory is currently obtained from the kernel
+ */
+template <class Policy>
+size_t PolicyHeap<Policy>::get_heap_size_in_bytes() {
+    return heap_end - heap_start;
+}
+
+/**
+ * @brief   Find where the heap starts, obtain first GROW_SIZE bytes and construct the policy on them
+ */
+template <class Policy>
+bool PolicyHeap<Policy>::init() {
+    heap_start = syscalls::brk(0);
+    const size_t new_heap_end = heap_start + GROW_SIZE;
+    if (syscalls::brk(new_heap_end) != new_heap_end)
+        return false;
+
+    heap_end = new_heap_end;
+    policy = new (policy_storage) Policy(heap_start, heap_end - 1);
+    return true;
+}
+
+/**
+ * @brief   Obtain enough memory from the kernel for "size" bytes block to fit on top of the heap; policy takes it over
+ */
+template <class Policy>
+bool PolicyHeap<Policy>::grow(size_t size) {
+    const size_t increase = (size / GROW_SIZE + 1) * GROW_SIZE;
+    const size_t new_heap_end = heap_end + increase;
+    if (syscalls::brk(new_heap_end) != new_heap_end)
+        return false; // kernel refused to give more memory
+
+    heap_end = new_heap_end;
+    policy->extend_memory_pool(increase);
+    return true;
+}
+
+} /* namespace ustd */
+} /* namespace cstd */
+
+#endif /* USER_USTD_SRC_POLICYHEAP_H_ */
@@ -13,13 +13,29 @@ namespace cstd {
 namespace ustd {
 
 
+/**
+ * Constructor.
+ * @note    Video memory gets mapped and pixels drawn straight to the screen; if that fails, pixels are drawn to a buffer
+ *          that flush_to_screen copies to the screen
+ */
 VgaDevice::VgaDevice() {
     syscalls::vga_enter_graphics_mode();
     syscalls::vga_get_width_height(&width, &height);
-    vga_buffer.resize(width * height);
+
+    void* video_memory = syscalls::vga_map_video_buffer();
+    is_video_memory_mapped = (video_memory != MAP_FAILED);
+    if (is_video_memory_mapped)
+        video_buffer = (EgaColor64*)video_memory;
+    else {
+        vga_buffer.resize(width * height);
+        video_buffer = vga_buffer.data();
+    }
 }
 
 VgaDevice::~VgaDevice() {
+    if (is_video_memory_mapped)
+        syscalls::munmap(video_buffer, width * height * sizeof(EgaColor64));
+
     syscalls::vga_exit_graphics_mode();
 }
 
@@ -27,7 +43,7 @@ void VgaDevice::set_pixel_at(s16 x, s16 y, EgaColor64 color) {
     if (x < 0 || y < 0 || x >= width || y >= height)
         return;
 
-    vga_buffer[x + y * width] = color;
+    video_buffer[x + y * width] = color;
 }
 
 void VgaDevice::draw_rect(u16 x, u16 y, u16 width, u16 height, EgaColor64 color) {
@@ -59,7 +75,13 @@ void VgaDevice::draw_text(u16 px, u16 py, const char* s, EgaColor64 color) {
     }
 }
 
+/**
+ * @brief   Show the drawn pixels on screen; nothing to do if the pixels are drawn straight to video memory
+ */
 void VgaDevice::flush_to_screen() const {
+    if (is_video_memory_mapped)
+        return;
+
     syscalls::vga_flush_video_buffer((const unsigned char*)vga_buffer.data());
 }
 
@@ -34,7 +34,9 @@ private:
     void draw_char_8x8(u16 px, u16 py, char c, middlespace::EgaColor64 color);
 
     static unsigned char font_8x8[2048];
-    vector<middlespace::EgaColor64> vga_buffer;
+    vector<middlespace::EgaColor64> vga_buffer;     // used only if video memory could not be mapped
+    middlespace::EgaColor64* video_buffer;          // pixels are drawn here
+    bool is_video_memory_mapped;
 
 };
 
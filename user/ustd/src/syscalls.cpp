@@ -71,9 +71,11 @@ syscall_res syscall(middlespace::SysCallNumbers syscall,
         syscall_arg arg2,
         syscall_arg arg3,
         syscall_arg arg4,
-        syscall_arg arg5) {
+        syscall_arg arg5,
+        syscall_arg arg6) {
 
     syscall_res result;
+    register syscall_arg r9 asm("r9") = arg6;   // no constraint letter for r9
 
     do {
         // 1. make system call
@@ -82,7 +84,7 @@ syscall_res syscall(middlespace::SysCallNumbers syscall,
                 "mov %%rcx, %%r8        ;"
                 "syscall                ;"
                 : "=a"(result)
-                : "a"(syscall), "D"(arg1), "S"(arg2), "d"(arg3), "b"(arg4), "c"(arg5)
+                : "a"(syscall), "D"(arg1), "S"(arg2), "d"(arg3), "b"(arg4), "c"(arg5), "r"(r9)
                 : "r11" // r11 is internally used by syscall for RFLAGS, and RCX for RIP
         );
 
@@ -191,6 +193,24 @@ int mknod(const char path[], int mode, int dev) {
 size_t brk(size_t new_brk) {
     return syscall(middlespace::SysCallNumbers::BRK, (syscall_arg)new_brk);
 }
+
+/**
+ * @brief   Map a new memory area into the task address space; file area pages are read from "fd" at "offset" on first access,
+ *          anonymous area (MAP_ANONYMOUS) pages are zeroed
+ * @return  Area address on success, MAP_FAILED on error
+ */
+void* mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    syscall_res result = syscall(middlespace::SysCallNumbers::MMAP, (syscall_arg)addr, (syscall_arg)length, (syscall_arg)prot, (syscall_arg)flags, (syscall_arg)fd, (syscall_arg)offset);
+    return (result < 0) ? MAP_FAILED : (void*)result;
+}
+
+/**
+ * @brief   Unmap memory areas in "addr".."addr + length - 1"
+ * @return  0 on success, negative error code on error
+ */
+int munmap(void* addr, size_t length) {
+    return syscall(middlespace::SysCallNumbers::MUNMAP, (syscall_arg)addr, (syscall_arg)length);
+}
 /**
  * @brief   Get current working directory
  * @param   buff Buffer for storing the cwd
@@ -218,6 +238,10 @@ int clock_gettime(clockid_t clk_id, struct timespec *tp) {
     return syscall(middlespace::SysCallNumbers::CLOCK_GETTIME, (syscall_arg)clk_id, (syscall_arg)tp);
 }
 
+int setpriority(unsigned int task_id, int nice) {
+    return syscall(middlespace::SysCallNumbers::SET_PRIORITY, (syscall_arg)task_id, (syscall_arg)nice);
+}
+
 int enumerate(unsigned int fd, middlespace::VfsEntry* entries, unsigned int max_enties) {
     return syscall(middlespace::SysCallNumbers::FILE_ENUMERATE, (syscall_arg)fd, (syscall_arg)entries, (syscall_arg)max_enties);
 }
@@ -246,6 +270,16 @@ void vga_flush_video_buffer(const unsigned char* video_buffer) {
     syscall(middlespace::SysCallNumbers::VGA_FLUSH_VIDEO_BUFFER, (syscall_arg)video_buffer);
 }
 
+/**
+ * @brief   Map graphics mode video memory into the task address space; pixels written there show on screen right away.
+ *          Unmap it with "munmap" before leaving graphics mode
+ * @return  Mapping address on success, MAP_FAILED on error
+ */
+void* vga_map_video_buffer() {
+    syscall_res result = syscall(middlespace::SysCallNumbers::VGA_MAP_VIDEO_BUFFER);
+    return (result < 0) ? MAP_FAILED : (void*)result;
+}
+
 void vga_get_width_height(unsigned short* width, unsigned short* height) {
     syscall(middlespace::SysCallNumbers::VGA_GET_WIDTH_HEIGHT, (syscall_arg)width, (syscall_arg)height);
 }
@@ -274,6 +308,10 @@ s64 elf_run(const char path[], const char* nullterm_argv[]) {
     return syscall(middlespace::SysCallNumbers::ELF_RUN, (syscall_arg)path, (syscall_arg)nullterm_argv);
 }
 
+s64 fork() {
+    return syscall(middlespace::SysCallNumbers::FORK);
+}
+
 /**
  * @brief   This is a wrapper that runs the given task function and calls syscalls::exit().
  *          This way the task function itself can just return 0, instead of calling exit(0)
@@ -302,6 +340,25 @@ s64 task_wait(unsigned int task_id) {
     return syscall(middlespace::SysCallNumbers::TASK_WAIT, (syscall_arg)task_id);
 }
 
+/**
+ * @brief   Map shared memory segment "name" into the task address space, creating the segment if it doesnt exist yet.
+ *          Other processes that map the same "name" see the same memory. Unmap the segment with "munmap"
+ * @param   size Size of the segment to create, 0 means entire segment when mapping existing one
+ * @return  Mapping address on success, MAP_FAILED on error
+ */
+void* shm_map(const char name[], size_t size) {
+    syscall_res result = syscall(middlespace::SysCallNumbers::SHM_MAP, (syscall_arg)name, (syscall_arg)size);
+    return (result < 0) ? MAP_FAILED : (void*)result;
+}
+
+/**
+ * @brief   Remove shared memory segment "name"; the memory is released when no process has it mapped anymore
+ * @return  0 on success, negative error code on error
+ */
+int shm_unlink(const char name[]) {
+    return syscall(middlespace::SysCallNumbers::SHM_UNLINK, (syscall_arg)name);
+}
+
 }
 }
 }
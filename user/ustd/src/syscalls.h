@@ -61,7 +61,8 @@ syscall_res syscall(middlespace::SysCallNumbers syscall,
         syscall_arg arg2 = 0,
         syscall_arg arg3 = 0,
         syscall_arg arg4 = 0,
-        syscall_arg arg5 = 0);
+        syscall_arg arg5 = 0,
+        syscall_arg arg6 = 0);
 
 ssize_t read(int fd, void* buf, size_t count);
 
@@ -132,6 +133,19 @@ int mknod(const char path[], int mode = S_IFIFO, int dev = 0);
  */
 size_t brk(size_t new_brk);
 
+/**
+ * @brief   Map a new memory area into the task address space; file area pages are read from "fd" at "offset" on first access,
+ *          anonymous area (MAP_ANONYMOUS) pages are zeroed
+ * @return  Area address on success, MAP_FAILED on error
+ */
+void* mmap(void* addr, size_t length, int prot, int flags, int fd = -1, off_t offset = 0);
+
+/**
+ * @brief   Unmap memory areas in "addr".."addr + length - 1"
+ * @return  0 on success, negative error code on error
+ */
+int munmap(void* addr, size_t length);
+
 /**
  * @brief   Get current working directory
  * @param   buff Buffer for storing the cwd
@@ -148,6 +162,12 @@ int chdir(const char path[]);
 
 int clock_gettime(clockid_t clk_id, struct timespec *tp);
 
+/**
+ * @brief   Set nice value -20..19 of task "task_id", or of the calling task if "task_id" is 0
+ * @return  0 on success, negative error code on error
+ */
+int setpriority(unsigned int task_id, int nice);
+
 int enumerate(unsigned int fd, middlespace::VfsEntry* entries, unsigned int max_enties);
 
 void vga_cursor_setvisible(bool visible);
@@ -162,6 +182,13 @@ void vga_flush_char_buffer(const unsigned short* text_buffer);
 
 void vga_flush_video_buffer(const unsigned char* video_buffer);
 
+/**
+ * @brief   Map graphics mode video memory into the task address space; pixels written there show on screen right away.
+ *          Unmap it with "munmap" before leaving graphics mode
+ * @return  Mapping address on success, MAP_FAILED on error
+ */
+void* vga_map_video_buffer();
+
 void vga_get_width_height(unsigned short* width, unsigned short* height);
 
 void vga_enter_graphics_mode();
@@ -176,9 +203,29 @@ void exit_group(u64 code);
 
 s64 elf_run(const char path[], const char* nullterm_argv[]);
 
+/**
+ * @brief   Create a new process that is a copy of the calling one; memory is shared copy-on-write
+ * @return  Child task id in the calling process, 0 in the child process, negative error code on error
+ */
+s64 fork();
+
 s64 task_lightweight_run(unsigned long long entry_point, unsigned long long arg = 0, const char name[] = "lightweight");
 
 s64 task_wait(unsigned int task_id);
+
+/**
+ * @brief   Map shared memory segment "name" into the task address space, creating the segment if it doesnt exist yet.
+ *          Other processes that map the same "name" see the same memory. Unmap the segment with "munmap"
+ * @param   size Size of the segment to create, 0 means entire segment when mapping existing one
+ * @return  Mapping address on success, MAP_FAILED on error
+ */
+void* shm_map(const char name[], size_t size = 0);
+
+/**
+ * @brief   Remove shared memory segment "name"; the memory is released when no process has it mapped anymore
+ * @return  0 on success, negative error code on error
+ */
+int shm_unlink(const char name[]);
 } // namespace syscalls
 } // namespace ustd
 } // namespace cstd